@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ft_vox.hpp"
+#include "define.hpp"
+#include "ChunkLoader.hpp"
+#include "Chunk.hpp"
+
+// Read-only world access for gameplay code (player physics, aim, plant
+// cascades). Every chunk the query touches is pinned until the query is
+// destroyed, so it cannot be evicted while its blocks are being read.
+// Batched reads are sorted by subchunk and take each subchunk lock once.
+// Keep it short-lived: one per frame or per task, never stored.
+class BlockQuery
+{
+private:
+	ChunkLoader										&_chunkLoader;
+	// Pinned chunks, null when not loaded
+	std::unordered_map<ivec2, Chunk *, ivec2_hash>	_chunks;
+
+	Chunk *chunk(const ivec2 &pos);
+public:
+	explicit BlockQuery(ChunkLoader &chunkLoader);
+	~BlockQuery();
+	BlockQuery(const BlockQuery &) = delete;
+	BlockQuery &operator=(const BlockQuery &) = delete;
+
+	// Pin the chunks of [mn, mx] (chunk coords, inclusive) up front
+	void		pin(const ivec2 &mn, const ivec2 &mx);
+
+	BlockType	getBlock(const ivec3 &worldPos);
+	// out[i] receives the block at positions[i]
+	void		getBlocks(const ivec3 *positions, size_t count, BlockType *out);
+	void		getBlocks(const std::vector<ivec3> &positions, std::vector<BlockType> &out);
+	// Copy the box [mn, mn + size) into out (x fastest, then z, then y).
+	// Cells of missing chunks read as AIR.
+	void		readRegion(const ivec3 &mn, const ivec3 &size, BlockType *out);
+	// Highest block of a column that is not air, water or a plant
+	TopBlock	topBlock(int worldX, int worldZ);
+};
@@ -47,6 +47,9 @@ class Camera {
 		void setPos(const vec3&newPos);
 		vec3 getForwardVector() const;
 		vec3 getStrafeVector() const;
+		// Smoothed world-space velocity (blocks/s), sampled once per frame
+		void updateVelocity(float dt);
+		vec3 getVelocity();
 	private:
 		vec3 position;
 		fvec2 angle;
@@ -58,4 +61,8 @@ class Camera {
 		std::mutex _positionMutex;
 		e_direction _facing;
 		float y_pos;
+		vec3 _velocity{0.0f};
+		vec3 _lastWorldPos{0.0f};
+		bool _hasLastPos = false;
+		std::mutex _velocityMutex;
 };
@@ -8,6 +8,7 @@
 #include "Chrono.hpp"
 
 #include "ThreadPool.hpp"
+#include "RegionFile.hpp"
 #include <future>
 
 class SubChunk;
@@ -19,6 +20,7 @@ class Chunk
 	private:
 		ivec2								_position;
 		size_t								_memorySize = 0;
+		size_t								_meshMemorySize = 0;	// last MEM_MESHES report
 		std::atomic_bool					_isFullyLoaded;
 		std::atomic_bool					_facesSent;
 		std::atomic_bool					_hasAllNeighbors;
@@ -48,15 +50,41 @@ class Chunk
 		ThreadPool								&_pool;
 		std::atomic_bool						_isBuilding;
 		std::atomic_bool						_isModified;
+		// Live BlockQuery references; pinned chunks are never evicted
+		std::atomic_int							_pins;
+		// Last mesh of a cached chunk once its streams are released, kept
+		// delta + varint packed with the meshStamp() it was built at
+		std::vector<uint8_t>					_packedMesh;
+		uint64_t								_packedStamp = 0;
+		uint64_t								_builtStamp = 0;
+		// Subchunk meshes match the chunk streams (not after a restore)
+		bool									_subMeshesKept = false;
+		// Skylight of every subchunk, a nibble per cell (x + z*n + y*n*n, one
+		// n^3 block per subchunk from _skyLightBase), rebuilt with the voxels
+		std::mutex								_skyLightMutex;
+		std::vector<uint8_t>					_skyLight;
+		int										_skyLightBase = 0;
+		int										_skyLightLayers = 0;
+		int										_skyLightRes = 1;
+		uint64_t								_skyLightStamp = 0;
+		size_t									_skyLightBytes = 0;	// last MEM_VOXELS report
+		// Bumped when the light on a side (NORTH..EAST) changes, the chunk
+		// across it reseeds its flood fill
+		std::atomic_uint						_skyBorderGen[4];
 		
 	public:
 		Chunk(ivec2 pos, PerlinMap *perlinMap, CaveGenerator &caveGen, ChunkLoader &chunkMgr, ThreadPool &pool, int resolution = 1);
 		~Chunk();
+		// Link to the 4 neighbors and remesh them (and us once surrounded)
 		void getNeighbors();
+		// Link only, nothing is meshed
+		void linkNeighbors();
 		SubChunk *getSubChunk(int y);
 		SubChunk *getOrCreateSubChunk(int y, bool generate = true);
 		void updateResolution(int newResolution);
-		void sendFacesToDisplay();
+		// Rebuild meshes; onlySubY limits the rebuild to those subchunks (the
+		// others reuse their last mesh), falling back to all when none is kept
+		void sendFacesToDisplay(const std::unordered_set<int> *onlySubY = nullptr);
 		bool isReady();
 		std::atomic_int	&getResolution();
 		ivec2 getPosition();
@@ -72,7 +100,28 @@ class Chunk
 		Chunk *getWestChunk ();
 	
 		void clearFaces();
+		// Drop CPU mesh streams (chunk + subchunks), keeping a packed copy of
+		// the chunk streams for restorePackedMesh
+		void releaseMeshData();
+		// Bring back the mesh packed by releaseMeshData instead of remeshing;
+		// false when there is none or voxels/neighbors changed since
+		bool restorePackedMesh();
+		// Cold tier over every subchunk (see SubChunk::freezeBlocks); returns bytes saved
+		size_t freezeBlocks();
+		void thawBlocks();
+		// Skylight (0..SKYLIGHT_MAX) of the cell holding chunk-local block
+		// (x, y, z), y counted from subchunk 0; open sky above the subchunks
+		// and before the first mesh
+		uint8_t getSkyLight(int x, int y, int z);
+		// Light of the cells on `side`, sampled on a res grid from subchunk
+		// baseY, `height` cells up (u + y*n, u along x or z); false before
+		// the first mesh
+		bool getSkyLightBorder(Direction side, int res, int baseY, int height, std::vector<uint8_t> &out);
 		void loadBlocks();
+		// Build the subchunks from pregenerated voxels (full resolution only)
+		void loadStored(const StoredChunk &stored);
+		// Copy every subchunk's voxels; false unless at full resolution
+		bool exportBlocks(StoredChunk &out);
 		void unloadNeighbor(Direction dir);
 		void unloadNeighbors();
 		TopBlock getTopBlock(int localX, int localZ);
@@ -100,8 +149,23 @@ class Chunk
 		bool isBuilding() const;
 		void setAsModified();
 		bool getModified() const;
+		void pin();
+		void unpin();
+		bool isPinned() const;
 		// Enumerate existing subchunk Y indices (thread-safe snapshot)
 		void getSubIndices(std::vector<int>& out);
 	private:	
 		void updateHasAllNeighbors();
+		// Subchunk block versions and resolution, hashed
+		uint64_t voxelStamp();
+		// voxelStamp with the neighbor links and their border light
+		uint64_t meshStamp();
+		// Linked neighbors and the generation of the border they face us with
+		uint64_t borderLightStamp();
+		// Sun columns then a flood fill seeded from the neighbors' borders;
+		// adds the subchunks whose faces may see a changed level to relit and
+		// marks the neighbors across a changed border dirty
+		void updateSkyLight(const std::vector<SubChunk *> &subs, std::unordered_set<int> &relit);
+		uint8_t skyLightAtLocked(int x, int y, int z) const;
+		size_t streamBytes() const;
 };
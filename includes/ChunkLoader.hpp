@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include <vector>
 #include <limits>
+#include <functional>
 
 #include "ft_vox.hpp"
 #include "NoiseGenerator.hpp"
@@ -21,19 +22,66 @@
 #include "ChunkLoader.hpp"
 #include "ChunkRenderer.hpp"
 #include "Raycaster.hpp"
+#include "MemoryGovernor.hpp"
+#include "RegionFile.hpp"
 
 class Chunk;
 
+// Plant list of one subchunk, handed from the loader to the renderer.
+// cells use SubChunk::packPlant(); empty means the subchunk has none left.
+struct FlowerSubUpdate {
+	glm::ivec2				cpos;
+	int						subY;
+	std::vector<uint32_t>	cells;
+};
+
+// Block edits collected by the caller, then applied by ChunkLoader::commitEdits:
+// sorted per subchunk, written under one lock per subchunk, one remesh per chunk.
+// Later edits to the same voxel win. set() refuses heights outside
+// [0, MAX_Y) (pending edits only store 12 bits of y) and returns false.
+struct EditBatch {
+	static constexpr int MAX_Y = 1 << 12;
+
+	struct Edit {
+		glm::ivec3	worldPos;
+		BlockType	value;
+	};
+	std::vector<Edit>	edits;
+	size_t				rejected = 0;		// set() calls refused
+	bool				byPlayer = true;	// counts as a player modification
+
+	bool set(const glm::ivec3 &worldPos, BlockType value) {
+		if (worldPos.y < 0 || worldPos.y >= MAX_Y) { ++rejected; return false; }
+		edits.push_back({worldPos, value});
+		return true;
+	}
+	void clear() { edits.clear(); rejected = 0; }
+	bool empty() const { return edits.empty(); }
+	size_t size() const { return edits.size(); }
+};
+
+// Region edit: returns true and sets `out` to write a block at `world`
+typedef std::function<bool(const glm::ivec3 &world, char current, char &out)> EditCellOp;
+// Subchunks to remesh, per chunk
+typedef std::unordered_map<glm::ivec2, std::unordered_set<int>, ivec2_hash> RemeshSet;
+
 class ChunkLoader
 {
 private:
-	// Modification queue for blocks breaking
-	struct PendingBlock {
-		glm::ivec3 worldPos;
-		BlockType  value;
-		bool       byPlayer; // true if edit comes from player action
+	// Edits for chunks that are missing or still building, replayed by
+	// applyPendingFor. One packed word per edit (see packPending).
+	std::unordered_map<glm::ivec2, std::vector<uint32_t>, ivec2_hash> _pendingEdits;
+	// Region edits parked per chunk (missing, building or not at full
+	// resolution): one box and op each, replayed once the chunk is loaded at
+	// resolution 1. `after` counts the cell edits queued before the region.
+	struct PendingRegion {
+		glm::ivec3						mn;
+		glm::ivec3						mx;
+		std::shared_ptr<const EditCellOp>	op;
+		bool							byPlayer;
+		size_t							after;
 	};
-	std::unordered_map<glm::ivec2, std::vector<PendingBlock>, ivec2_hash> _pendingEdits;
+	std::unordered_map<glm::ivec2, std::vector<PendingRegion>, ivec2_hash> _pendingRegions;
 
 	// LRU list of cached chunks (oldest at front)
 	std::list<ivec2> _chunkList;
@@ -54,14 +102,16 @@ private:
 	std::unordered_map<ivec2, Chunk *, ivec2_hash>	_chunks;
 	std::unordered_map<ivec2, Chunk *, ivec2_hash>	_displayedChunks;
 
-	// Tracking memory usage of chunks (atomic for cross-thread updates)
-	std::atomic_size_t _chunksMemoryUsage;
-	int    _countBudget;
+	// Byte accounting shared with every allocation site (owned by ChunkManager)
+	MemoryGovernor &_memGov;
 
 	// Live counters (atomic) updated by worker/render threads
 	std::atomic_int _chunksCount{0};
 	std::atomic_int _displayedCount{0};
 	std::atomic_int _modifiedCount{0};
+	std::atomic_int _prefetchedCount{0};
+	std::atomic_int _prefetchCancelled{0};
+	std::atomic_int _refinePending{0};
 
 	// Reference to camera for accurate chunk loading
 	Camera &_camera;
@@ -69,6 +119,8 @@ private:
 	// World relative data (atomics to avoid data races)
 	std::atomic_int		_renderDistance;
 	std::atomic_int		_currentRender;
+	// Display radius (chunks) allowed by the GPU budget, INT_MAX when unbounded
+	std::atomic_int		_gpuRadiusCap{std::numeric_limits<int>::max()};
 	int				_maxRender;
 	std::atomic_int	_threshold;
 
@@ -85,10 +137,18 @@ private:
 	// Terrain generation heavy lifters
 	NoiseGenerator	_perlinGenerator;
 	CaveGenerator	_caveGen;
+	// Pregenerated chunks, used instead of generating at full resolution
+	RegionStore		_regions;
 
 	// Chunks edit tracking
 	std::unordered_set<ivec2, ivec2_hash> _dirtyChunks;
 
+	// Cold tier: chunks that left the display, waiting for compressColdChunks
+	std::vector<ivec2>	_coldQueue;
+	std::mutex			_coldMutex;
+	bool				_coldScheduled = false;
+	std::future<void>	_coldJob;
+
 	// Frustum loading data
 	Frustum	_cachedFrustum;
 	bool	_hasCachedFrustum = false;
@@ -97,16 +157,13 @@ private:
 	std::queue<DisplayData *>	&_solidStagedDataQueue;
 	std::queue<DisplayData *>	&_transparentStagedDataQueue;
 
-	// Flowers discovered in world data (by subchunk), staged for the renderer
-	// Map: chunk -> subY -> list of (cell, type)
-	std::unordered_map<glm::ivec2, std::unordered_map<int, std::vector<std::pair<glm::ivec3, BlockType>>>, ivec2_hash> _discoveredFlowers;
-	// Guard for discovered flower structures
+	// Plant lists per subchunk, staged for the renderer in replace order.
+	// An empty cell list drops the subchunk's instances.
+	std::vector<FlowerSubUpdate> _flowerUpdates;
+	// Subchunks whose plants the renderer currently holds, per chunk
+	std::unordered_map<glm::ivec2, std::unordered_set<int>, ivec2_hash> _flowerSubs;
+	// Guard for flower staging structures
 	std::mutex _flowersMutex;
-	// Track which sublayers have been scanned to avoid re-scanning/duplicating
-	std::unordered_set<std::string> _flowersScannedKeys;
-	static std::string _flowerKey(const glm::ivec2& cpos, int subY) {
-		return std::to_string(cpos.x) + ":" + std::to_string(cpos.y) + ":" + std::to_string(subY);
-	}
 	// Snapshot of currently displayed subchunks per chunk (from last build)
 	std::unordered_map<glm::ivec2, std::unordered_set<int>, ivec2_hash> _lastDisplayedSubY;
 	// Debug snapshot values exposed to UI (stable addresses, written on main thread)
@@ -116,6 +173,11 @@ private:
 	int _dbg_chunksCount{0};
 	int _dbg_displayedCount{0};
 	int _dbg_modifiedCount{0};
+	int _dbg_prefetchedCount{0};
+	int _dbg_prefetchCancelled{0};
+	int _dbg_refinePending{0};
+	// Frames with a visible chunk missing (main thread only)
+	int _dbg_holeFrames{0};
 
 	// Methods
 private:
@@ -127,16 +189,31 @@ private:
 
 	// Runtime chunk loading/unloading
 	Chunk *loadChunk(int x, int z, int render, const ivec2 &chunkPos, int resolution);
+	// headless: always from the noise, not linked to neighbors (nothing gets meshed)
+	// link false: not linked to neighbors, the caller links and meshes
+	Chunk *createChunk(ivec2 pos, int resolution, bool headless = false, bool link = true);
+	// fn(i) for each position, generation-order independent (see the definition)
+	static void runInWaves(const std::vector<ivec2> &positions, size_t threads, const std::function<void(size_t)> &fn);
+	// Velocity-predicted prefetch beyond the visible ring
+	void prefetchAlongPath(ivec2 chunkPos, int maxRadius);
+	bool prefetchTrajectoryChanged(const ivec2 &chunkPos, const glm::vec2 &plannedDir);
 	bool hasMoved(const ivec2 &oldPos);
+	// Coarse-to-fine pass over chunks loaded below their LOD target
+	bool refineChunks(const ivec2 &chunkPos, std::vector<glm::ivec2> &pending);
 	void buildFacesToDisplay(DisplayData *fillData, DisplayData *transparentFillData);
 	void updateFillData();
 
 	// Chunks edit tracking
 	void	flushDirtyChunks();
 
+	// Cold tier: queue chunks for compressColdChunks (one pool task at a time)
+	void scheduleColdTier(const std::vector<ivec2> &positions);
+	void compressColdChunks();
+
 	// LRU + cache budget helpers
 	void touchLRU(const ivec2& pos);
-	void enforceCountBudget();
+	void enforceMemoryBudget();
+	int enforceGpuBudget(int maxRadius);
 	bool evictChunkAt(const ivec2& pos);
 public:
 	ChunkLoader(
@@ -147,13 +224,23 @@ public:
 		std::atomic_bool *isRunning,
 		std::mutex &sharedDrawDataMutex,
 		std::queue<DisplayData *>	&solidStagedDataQueue,
-		std::queue<DisplayData *>	&transparentStagedDataQueue
+		std::queue<DisplayData *>	&transparentStagedDataQueue,
+		MemoryGovernor &memGov
 	);
 	~ChunkLoader();
 
 	// Init methods
 	void initSpawn();
 
+	// Headless generation (ft_vox_pregen): a full-resolution chunk built
+	// from the noise, never from the region files, and never meshed
+	Chunk	*generateChunk(const ivec2 &pos);
+	// generateChunk over many chunks on `threads` threads, in waves
+	// (runInWaves): the result does not depend on thread timing
+	void	generateChunks(const std::vector<ivec2> &positions, size_t threads);
+	// Drop a cached chunk; false when it is pinned, modified or missing
+	bool	releaseChunk(const ivec2 &pos);
+
 	// Runtime chunk loading/unloading/updating
 	void	loadChunks(ivec2 camPosition);
 	void	unloadChunks(ivec2 newCamChunk);
@@ -162,11 +249,15 @@ public:
 	void	rebuildDisplayDataNow();
 	// Snapshot atomics into UI-visible plain fields (call on main thread)
 	void	snapshotDebugCounters();
+	// Bump the visible-holes frame counter if the view shows a missing chunk (main thread)
+	void	sampleVisibleHoles();
 
 	// Shared data getters
 	Chunk*			getChunk(const ivec2 &position);
 	SubChunk*		getSubChunk(ivec3 &position);
 	BlockType		getBlock(ivec2 chunkPos, ivec3 worldPos);
+	// Lookup + pin in one step so eviction cannot race the caller (see BlockQuery)
+	Chunk*			pinChunk(const ivec2 &position);
 	TopBlock		findTopBlockY(ivec2 chunkPos, ivec2 worldPos);
 	TopBlock		findBlockUnderPlayer(ivec2 chunkPos, ivec3 worldPos);
 	bool			getIsRunning();
@@ -178,27 +269,50 @@ public:
 	bool	setBlockOrQueue(ivec2 chunkPos, ivec3 worldPos, BlockType value, bool byPlayer = true);
 	void	markChunkDirty(const ivec2& pos);
 	bool	setBlock(ivec2 chunkPos, ivec3 worldPos, BlockType value, bool byPlayer);
+	// Apply a whole batch (queues the parts whose chunk is not ready). Returns edits written now.
+	size_t	commitEdits(const EditBatch &batch);
+	// Remesh the listed subchunks, one pass per chunk (on `pool` when given; not from pool threads)
+	void	remeshSubChunks(const RemeshSet &remesh, ThreadPool *pool = nullptr);
+	void	markChunkModified(Chunk *chunk);
+	// Region edits go straight to a chunk only when it is ready, at full
+	// resolution and has no older region parked for it
+	bool	acceptsRegionEdits(Chunk *chunk, const ivec2 &cpos);
+	// Park a region edit (world box, clipped to the chunk) until acceptsRegionEdits
+	void	queueRegion(const ivec2 &cpos, const glm::ivec3 &mn, const glm::ivec3 &mx,
+						const std::shared_ptr<const EditCellOp> &op, bool byPlayer);
+	// Run op over [lmin, lmax] (subchunk-local) of one subchunk; only
+	// allocates a missing subchunk if op writes a non-air block. Cells changed.
+	size_t	editSubChunkRegion(Chunk *chunk, int subY, const glm::ivec3 &lmin, const glm::ivec3 &lmax,
+							   const EditCellOp &op, bool writes);
+	// Touched subchunk plus the ones across the touched borders
+	static void	addRegionRemesh(RemeshSet &remesh, const ivec2 &cpos, int subY,
+								const glm::ivec3 &lmin, const glm::ivec3 &lmax);
 	void	setViewProj(Frustum &f);
 
-	// Flowers: scan a subchunk once and stage its flower cells for the renderer
-	void scanAndRecordFlowersFor(const glm::ivec2& cpos, int subY, class SubChunk* sc, int resolution);
-	// Flowers: fetch and clear all staged flower cells
-	void fetchAndClearDiscoveredFlowers(std::vector<std::tuple<glm::ivec2,int,glm::ivec3,BlockType>>& out);
+	// Flowers: replace the staged plant list of a subchunk (cells from SubChunk::getPlants)
+	void stageFlowersFor(const glm::ivec2& cpos, int subY, std::vector<uint32_t> &&cells);
+	// Flowers: fetch and clear all staged subchunk updates
+	void fetchFlowerUpdates(std::vector<FlowerSubUpdate>& out);
 
 	// Visible subchunks snapshot for external culling (e.g., flower instances)
 	void getDisplayedSubchunksSnapshot(std::unordered_map<glm::ivec2, std::unordered_set<int>, ivec2_hash>& out);
 
 	// Debug shared data getters and prints
 	size_t	*getMemorySizePtr();
+	MemoryGovernor &getMemoryGovernor();
 	int		*getRenderDistancePtr();
 	int		*getCurrentRenderPtr();
 	int		*getCachedChunksCountPtr();
 	int		*getDisplayedChunksCountPtr();
 	int		*getModifiedChunksCountPtr();
+	int		*getPrefetchedChunksCountPtr();
+	int		*getPrefetchCancelledCountPtr();
+	int		*getRefinePendingPtr();
+	int		*getHoleFramesPtr();
 	void	printSizes() const;
 
 	private:
 	// Flowers helpers for lifetime across display cycles
-	void clearFlowerScanMarksFor(const glm::ivec2& cpos);
-	void rescanFlowersForChunk(const glm::ivec2& cpos);
+	void dropFlowersForChunk(const glm::ivec2& cpos);
+	void restageFlowersForChunk(const glm::ivec2& cpos);
 };
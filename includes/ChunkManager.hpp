@@ -10,8 +10,11 @@
 #include "ThreadPool.hpp"
 #include "Frustum.hpp"
 #include "ChunkLoader.hpp"
+#include "BlockQuery.hpp"
 #include "ChunkRenderer.hpp"
 #include "Raycaster.hpp"
+#include "MemoryGovernor.hpp"
+#include "WorldEdit.hpp"
 
 #include <unordered_set>
 #include <queue>
@@ -51,6 +54,9 @@ private:
 	std::queue<DisplayData *>	_solidStagedDataQueue;
 	std::queue<DisplayData *>	_transparentStagedDataQueue;
 
+	// Byte budgets shared by loader, renderer and engine (outlives both)
+	MemoryGovernor _memGov;
+
 	// Frustum view based chunk loading
 	ChunkLoader _chunkLoader;
 
@@ -59,6 +65,9 @@ private:
 
 	// Raycasting on world data
 	Raycaster _raycaster;
+
+	// Bulk edits (fill, ellipsoid, replace, copy/paste)
+	WorldEdit _worldEdit;
 public:
 	ChunkManager(
 		int seed,
@@ -77,14 +86,21 @@ public:
 
 	// Shared data getters
 	size_t		*getMemorySizePtr();
+	MemoryGovernor	&getMemoryGovernor();
 	int			*getRenderDistancePtr();
 	int			*getCurrentRenderPtr();
 	int			*getCachedChunksCountPtr();
 	int			*getDisplayedChunksCountPtr();
 	int			*getModifiedChunksCountPtr();
+	int			*getPrefetchedChunksCountPtr();
+	int			*getPrefetchCancelledCountPtr();
+	int			*getRefinePendingPtr();
+	int			*getHoleFramesPtr();
 	void		getDisplayedChunksSnapshot(std::vector<ivec2>& out);
 	bool		hasRenderableChunks();
 	BlockType	getBlock(ivec2 chunkPos, ivec3 worldPos);
+	// Short-lived pinned reader for gameplay code (see BlockQuery)
+	BlockQuery	makeQuery();
 
 	// View projection setter for renderer
 	void	setViewProj(const glm::mat4& view, const glm::mat4& proj);
@@ -99,6 +115,8 @@ public:
 
 	// Snapshot debug counters from loader (main thread only)
 	void    snapshotDebugCounters();
+	// Count this frame if a visible chunk is still missing (main thread only)
+	void    sampleVisibleHoles();
 
 	// Chunks loading and unloading methods
 	void loadChunks(ivec2 camPos);
@@ -109,8 +127,9 @@ public:
 
 	// Mesh rendering methods
 	int renderSolidBlocks();
-	int renderTransparentBlocks();
+	int renderTransparentBlocks(TransparentView view = TRANSP_VIEW_MAIN);
 	int renderTransparentBlocksNoCullForShadow();
+	int renderSolidBlocksForCascade(int cascade);
 
 	// Collisions helper
 	TopBlock findBlockUnderPlayer(ivec2 chunkPos, ivec3 worldPos);
@@ -139,8 +158,16 @@ public:
 				float maxDistance,
 				BlockType block,
 				glm::ivec3& outPlaced);
+	void raycastBatch(const std::vector<RayQuery> &rays, std::vector<RayHit> &out);
+
+	// Bulk world edits (main thread; see WorldEdit)
+	size_t	fillBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockType value);
+	size_t	fillEllipsoid(const glm::vec3 &center, const glm::vec3 &radii, BlockType value);
+	size_t	replaceInBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockType from, BlockType to);
+	bool	copyBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockRegion &out);
+	size_t	paste(const BlockRegion &region, const glm::ivec3 &origin, bool skipAir = true);
 
 	// Flowers
-	void fetchAndClearDiscoveredFlowers(std::vector<std::tuple<glm::ivec2,int,glm::ivec3,BlockType>>& out);
+	void fetchFlowerUpdates(std::vector<FlowerSubUpdate>& out);
 	void getDisplayedSubchunksSnapshot(std::unordered_map<glm::ivec2, std::unordered_set<int>, ivec2_hash>& out);
 };
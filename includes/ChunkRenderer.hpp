@@ -21,6 +21,14 @@
 #include "ChunkLoader.hpp"
 #include "ChunkRenderer.hpp"
 #include "Raycaster.hpp"
+#include "MemoryGovernor.hpp"
+
+// Views the transparent pass is drawn from; each keeps its own sorted order
+enum TransparentView {
+	TRANSP_VIEW_MAIN,
+	TRANSP_VIEW_MIRROR,
+	TRANSP_VIEW_COUNT
+};
 
 class ChunkRenderer
 {
@@ -124,6 +132,10 @@ private:
 	GLsizeiptr                                  _capSolidMeta   = 0;
 	GLsizeiptr                                  _capTranspMeta  = 0;
 
+	// GPU bytes last reported to the governor (sum of the capacities above)
+	MemoryGovernor							&_memGov;
+	size_t									_gpuMemoryReported = 0;
+
 	// Common mutexes between ChunkLoader and ChunkRenderer
 	std::mutex								&_solidDrawDataMutex;
 	std::mutex								&_transparentDrawDataMutex;
@@ -139,6 +151,50 @@ private:
 	// Boolean to avoid double buffer init
 	bool	_hasBufferInitialized;
 
+	// Transparent pass: CPU frustum cull + back-to-front sort of subchunk draws.
+	// GPU compaction reorders draws (atomic append), so blending order is built here.
+	Frustum									_frustum;
+	glm::vec3								_viewCamPos{0.0f};
+	std::vector<DrawArraysIndirectCommand>	_transpCmdsCPU;
+	std::vector<glm::vec4>					_transpPosCPU;
+	std::vector<uint32_t>					_transpMetaCPU;
+	// Per view: the main and mirror passes alternate every frame and would
+	// otherwise resort and reupload over each other
+	struct TranspSort {
+		std::vector<uint32_t>	order;		// draw indices, far to near
+		std::vector<uint32_t>	keys;		// per draw, quantised (inverted) depth
+		glm::vec3				camPos{0.0f};
+		bool					valid = false;
+		// Last compacted upload, reused while order and visibility are unchanged
+		std::vector<uint32_t>	visible;
+		bool					uploaded = false;
+		// Draw buffers of the views past the main one (which draws from
+		// _transparentIndirectBuffer, _transpPosSSBO and _transpMetaSSBO)
+		GLuint					cmds = 0;
+		GLuint					pos = 0;
+		GLuint					meta = 0;
+		GLsizeiptr				capCmds = 0;
+		GLsizeiptr				capPos = 0;
+		GLsizeiptr				capMeta = 0;
+	};
+	TranspSort								_transpSort[TRANSP_VIEW_COUNT];
+	std::vector<uint32_t>					_transpSortTmp;
+	std::vector<uint32_t>					_transpVisibleScratch;
+	std::vector<DrawArraysIndirectCommand>	_transpVisCmds;
+	std::vector<glm::vec4>					_transpVisPos;
+	std::vector<uint32_t>					_transpVisMeta;
+
+	// Shadow cascades cull into their own compacted lists (frustum only), so
+	// no cascade overwrites the camera pass or another cascade in flight
+	struct CascadeLists {
+		GLuint		cmds = 0;
+		GLuint		posRes = 0;
+		GLuint		meta = 0;
+		GLuint		params = 0;
+		GLsizeiptr	capDraws = 0;
+	};
+	CascadeLists							_cascadeLists[SHADOW_CASCADES];
+
 	// Optional GPU sync after each solid draw (used for shadow cascades)
 	bool    _syncAfterDraw = false;
 	// Fence to ensure previous frame finished before CPU uploads to shared buffers
@@ -148,16 +204,20 @@ public:
 		std::mutex &solidDrawDataMutex,
 		std::mutex &transparentDrawDataMutex,
 		std::queue<DisplayData *>	&solidStagedDataQueue,
-		std::queue<DisplayData *>	&transparentStagedDataQueue
+		std::queue<DisplayData *>	&transparentStagedDataQueue,
+		MemoryGovernor &memGov
 	);
 	~ChunkRenderer();
 
 	// Rendering methods
 	int renderSolidBlocks();
-	int renderTransparentBlocks();
+	int renderTransparentBlocks(TransparentView view = TRANSP_VIEW_MAIN);
 	// Shadow pass helper: draw transparent terrain (leaves) without GPU culling
 	// Uses template indirect commands and source SSBO (no compute compaction)
 	int renderTransparentBlocksNoCullForShadow();
+	// Shadow pass: cull the solid draws against the current (light) frustum
+	// into the cascade's own lists and draw them
+	int renderSolidBlocksForCascade(int cascade);
 
 	// OpenGL setup for rendering
 	void initGLBuffer();
@@ -166,7 +226,7 @@ public:
 	void shutdownGL();
 
 	// Shared data setters
-	void setViewProj(glm::vec4 planes[6]);
+	void setViewProj(glm::vec4 planes[6], const glm::vec3 &camPos);
 	void setOcclusionSource(GLuint depthTex, int width, int height,
 							const glm::mat4& view, const glm::mat4& proj,
 							const glm::vec3& camPos);
@@ -181,6 +241,12 @@ private:
 	void initGpuCulling();
 	void runGpuCulling(bool transparent);
 
+	// Transparent ordering helpers
+	void sortTransparentDraws(TranspSort &sort);
+	GLsizei cullAndUploadTransparent(TransparentView view);
+	// Indirect commands, positions (binding 3) and meta (binding 7) `view` draws from
+	void transparentDrawBuffers(TransparentView view, GLuint &cmds, GLuint &pos, GLuint &meta);
+
     // Warmup frames after data upload that draw using the
 	// template indirect buffer + SOURCE positions to avoid any
 	// subtle compaction/driver edge cases on tiny batches.
@@ -190,4 +256,8 @@ private:
 	// Helper to send vertices to GPU before rendering stage
 	// Both solid and transparent
 	void pushVerticesToOpenGL(bool isTransparent);
+
+	// Memory governor reporting
+	void reportGpuMemory();
+	void releaseDisplayData(DisplayData *data);
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ft_vox.hpp"
+#include "define.hpp"
+#include "NoiseGenerator.hpp"
+#include "ThreadPool.hpp"
+
+// Heightfield clipmap drawn past the voxel render distance.
+// Each level is a fixed N x N grid of (colour, height) samples taken straight
+// from NoiseGenerator::getHeight/getBiome, never voxelised. Cells are stored
+// toroidally (slot = world grid coord mod N), so recentering only recomputes
+// the rows/columns that scrolled into the window.
+// Each level is centered on its finer child (not the camera) with its origin
+// snapped to the parent's cell grid, so a child's border lies on parent
+// vertices. The child morphs its border band onto the parent surface and
+// hangs a skirt below the border to cover cracks while levels update.
+class FarTerrain {
+	public:
+		FarTerrain(size_t seed, ThreadPool &pool);
+		~FarTerrain();
+
+		void initGL();
+		void shutdownGL();
+
+		// Upload finished levels and schedule rebuilds for levels whose window moved
+		void update(const glm::vec3 &camWorld);
+		// innerRadius: half-extent (blocks) around the camera left to the voxel pass
+		void render(const glm::mat4 &viewRot, const glm::mat4 &projection,
+					const glm::vec3 &camWorld, const glm::vec3 &sunDir,
+					int timeValue, float innerRadius);
+	private:
+		struct Level {
+			int							step = 1;			// world blocks per cell
+			std::unique_ptr<NoiseGenerator> noise;			// noise() mutates state: one per level
+			std::vector<glm::vec4>		cells;				// rgb = colour, a = height
+			glm::ivec2					origin{0};			// grid coord of the window min corner (CPU)
+			glm::ivec2					target{0};			// origin of the last scheduled rebuild
+			bool						valid = false;
+			glm::ivec2					gpuOrigin{0};		// window currently in the texture
+			bool						gpuValid = false;
+			std::future<void>			job;
+			GLuint						texture = 0;
+		};
+
+		void		buildLevel(Level &lvl, glm::ivec2 newOrigin);
+		glm::vec4	sampleCell(NoiseGenerator &noise, int wx, int wz);
+		glm::ivec2	desiredOrigin(const Level &lvl, glm::ivec2 centerWorld) const;
+		void		uploadLevel(Level &lvl);
+
+		ThreadPool				&_pool;
+		std::vector<Level>		_levels;
+		GLuint					_program = 0;
+		GLuint					_vao = 0;
+};
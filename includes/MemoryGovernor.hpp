@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ft_vox.hpp"
+#include "define.hpp"
+#include <atomic>
+
+// Byte categories tracked by the governor
+enum MemoryCategory {
+	MEM_VOXELS,		// SubChunk block arrays
+	MEM_MESHES,		// CPU mesh streams (chunk/subchunk vectors, staged DisplayData)
+	MEM_NOISE,		// cached PerlinMaps
+	MEM_GPU,		// terrain GL buffers
+	MEM_FLOWERS,	// flower instance buffer
+	MEM_CATEGORY_COUNT
+};
+
+// GL-resident categories: only shrinking the displayed set frees them
+inline bool isGpuCategory(MemoryCategory cat) { return cat == MEM_GPU || cat == MEM_FLOWERS; }
+
+// Central byte accounting for the world subsystems.
+// Allocation sites report deltas (lock-free), ChunkLoader asks which category
+// is over its budget and evicts what frees that category. The hard cap and
+// mostOverBudget only cover CPU categories: evicting cached chunks frees no
+// GL memory, the GPU budget is enforced by shrinking the display radius.
+// A release larger than the tracked usage is an accounting bug: it is
+// logged (first one per category) and counted, the counter clamps at 0.
+class MemoryGovernor {
+	public:
+		MemoryGovernor();
+
+		void	add(MemoryCategory cat, size_t bytes);
+		void	sub(MemoryCategory cat, size_t bytes);
+		void	adjust(MemoryCategory cat, size_t oldBytes, size_t newBytes);
+
+		size_t	usage(MemoryCategory cat) const;
+		size_t	budget(MemoryCategory cat) const;
+		size_t	total() const;
+		size_t	cpuTotal() const;
+		bool	overBudget(MemoryCategory cat) const;
+		bool	overHardCap() const;
+		bool	overGpuBudget() const;
+		// CPU category with the largest usage/budget ratio above 1, MEM_CATEGORY_COUNT if none
+		MemoryCategory	mostOverBudget() const;
+		// Releases that went below zero, per category
+		size_t	underflows(MemoryCategory cat) const;
+
+		static size_t	bytesOf(const DisplayData *data);
+		// MEM_MESHES charge of staged display data: taken when the loader
+		// stages it, shrunk when the renderer drops the uploaded streams,
+		// returned when the renderer replaces it (deletes data)
+		void	chargeDisplayData(DisplayData *data);
+		// Frees the vertex, indirect and meta streams, keeps ssboData
+		void	trimDisplayData(DisplayData *data);
+		void	releaseDisplayData(DisplayData *data);
+
+		// Debug mirrors (stable addresses, written on main thread)
+		void	snapshot();
+		size_t	*getUsagePtr(MemoryCategory cat);
+		size_t	*getTotalPtr();
+	private:
+		std::atomic_size_t	_usage[MEM_CATEGORY_COUNT];
+		std::atomic_size_t	_underflows[MEM_CATEGORY_COUNT];
+		size_t				_budget[MEM_CATEGORY_COUNT];
+		size_t				_hardCap;
+		size_t				_dbgUsage[MEM_CATEGORY_COUNT];
+		size_t				_dbgTotal = 0;
+};
@@ -4,6 +4,7 @@
 #include <random>
 #include <algorithm>
 #include <cmath>
+#include "NoiseBackend.hpp"
 
 class Noise3DGenerator {
 	public:
@@ -16,7 +17,5 @@ class Noise3DGenerator {
 
 	private:
 		std::vector<int> p;
-		static float fade(float t);
-		static float lerp(float t, float a, float b);
-		static float grad(int hash, float x, float y, float z);
+		std::unique_ptr<NoiseBackend> _backend;
 };
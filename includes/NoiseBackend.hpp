@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include "define.hpp"
+
+enum NoiseBackendType {
+	NOISE_PERLIN,		// classic gradient noise (the original terrain)
+	NOISE_OPENSIMPLEX2,	// simplex / BCC lattice, fewer axis artifacts
+	NOISE_VALUE			// integer-hash value noise, cheapest
+};
+
+// Single-octave lattice noise behind NoiseGenerator (2D) and
+// Noise3DGenerator (3D), output roughly in [-1, 1]. Both float and double
+// paths are provided; the owner keeps its own fractal/octave logic.
+// The backend is chosen once at startup (select) before any generator is built.
+class NoiseBackend
+{
+	public:
+		virtual ~NoiseBackend() {}
+		virtual double	noise(double x, double y) const = 0;
+		virtual float	noise(float x, float y) const = 0;
+		virtual double	noise(double x, double y, double z) const = 0;
+		virtual float	noise(float x, float y, float z) const = 0;
+
+		// permutation: 0..255 shuffled by the owner, duplicated to 512 entries.
+		// Perlin uses it as is so the original worlds are unchanged.
+		static std::unique_ptr<NoiseBackend> create(NoiseBackendType type, uint32_t seed, const std::vector<int> &permutation);
+		static std::unique_ptr<NoiseBackend> create(uint32_t seed, const std::vector<int> &permutation);
+
+		// Startup selection, NOISE_BACKEND by default
+		static void				select(NoiseBackendType type);
+		static NoiseBackendType	selected();
+		// "perlin", "opensimplex2" / "simplex", "value"; false if unknown
+		static bool				parse(const std::string &name, NoiseBackendType &out);
+		static const char		*name(NoiseBackendType type);
+		// Apply FT_VOX_NOISE if set (warns and keeps the default when unknown)
+		static void				selectFromEnvironment();
+};
@@ -3,8 +3,11 @@
 #include "ft_vox.hpp"
 #include "define.hpp"
 #include "SplineInterpolator.hpp"
+#include "NoiseBackend.hpp"
 #include <unordered_map>
 
+class MemoryGovernor;
+
 // Update nb_biomes when adding a new one for debug box
 #define NB_BIOMES 7
 enum Biome {
@@ -25,7 +28,21 @@ struct NoiseData {
 	size_t nb_octaves = 5;
 };
 
+// Height-independent inputs of getBiome at one column
+struct BiomeClimate {
+	double temp;
+	double humidity;
+	double latitude;	// temperature bias from the latitudinal bands
+	double continental;
+	double belt;		// humidity bias from the rain belts
+};
+
 struct SplineData {
+	// Height for each noise value (from -1.0 to 1.0) of the terrain curves
+	static const std::vector<Point> continentalPoints;
+	static const std::vector<Point> erosionPoints;
+	static const std::vector<Point> peaksPoints;
+
 	SplineInterpolator continentalSpline;
 	SplineInterpolator erosionSpline;
 	SplineInterpolator peaksValleysSpline;
@@ -33,30 +50,46 @@ struct SplineData {
 
 class NoiseGenerator {
 	public:
+		// Two blocks per map. Heights and biomes share one allocated once:
+		// SubChunks keep pointers to them and read them without locks, so
+		// they never move. The decoration maps (trees, grass, flowers) share
+		// a second block, only needed while SubChunk::loadBiome runs and
+		// dropped afterwards (see acquireDecoration / releaseDecoration).
+		// Base: float heights | uint8 biome
+		// Decoration: uint16 tree | uint8 grass, flowerMask, flowerR, flowerY, flowerB
 		struct PerlinMap {
-			double *heightMap = nullptr;
-			double *treeMap = nullptr;
-			double *grassMap = nullptr;           // probability for short grass
-			double *flowerMask = nullptr;        // overall flower density mask
-			double *flowerR = nullptr;           // cluster weights per color
-			double *flowerY = nullptr;
-			double *flowerB = nullptr;
-			Biome *biomeMap = nullptr;
+			float *heightMap = nullptr;
+			uint16_t *treeMap = nullptr;         // tree probability, unorm16
+			uint8_t *biomeMap = nullptr;         // Biome
+			uint8_t *grassMap = nullptr;         // probability for short grass, unorm8
+			uint8_t *flowerMask = nullptr;       // overall flower density mask, unorm8
+			uint8_t *flowerR = nullptr;          // cluster weights per color, unorm8
+			uint8_t *flowerY = nullptr;
+			uint8_t *flowerB = nullptr;
+			std::unique_ptr<uint8_t[]> block;
+			std::unique_ptr<uint8_t[]> decoration;
+			size_t	blockBytes = 0;              // both blocks
+			int		decorationUsers = 0;         // guarded by NoiseGenerator::_perlinMutex
+			int		decorationResolution = 0;    // 0 when the decoration maps are dropped
 			ivec2	position;
 			double	heighest = std::numeric_limits<double>::min();
 			double	lowest = std::numeric_limits<double>::max();
 			double	resolution = 1;
 			int		size = CHUNK_SIZE;
-			~PerlinMap() {
-				if (heightMap) { delete [] heightMap; heightMap = nullptr; }
-				if (biomeMap)  { delete [] biomeMap;  biomeMap  = nullptr; }
-				if (treeMap)   { delete [] treeMap;   treeMap   = nullptr; }
-				if (grassMap)  { delete [] grassMap;  grassMap  = nullptr; }
-				if (flowerMask){ delete [] flowerMask;flowerMask= nullptr; }
-				if (flowerR)   { delete [] flowerR;   flowerR   = nullptr; }
-				if (flowerY)   { delete [] flowerY;   flowerY   = nullptr; }
-				if (flowerB)   { delete [] flowerB;   flowerB   = nullptr; }
-			};
+
+			// Allocate the height/biome block (once, zeroed)
+			void allocateBase();
+			// Allocate or drop the decoration block; heights/biomes stay put
+			void setDecoration(bool withDecoration);
+
+			static uint8_t toUnorm8(double v) {
+				return (uint8_t)std::lround(std::clamp(v, 0.0, 1.0) * 255.0);
+			}
+			static uint16_t toUnorm16(double v) {
+				return (uint16_t)std::lround(std::clamp(v, 0.0, 1.0) * 65535.0);
+			}
+			static double fromUnorm8(uint8_t v) { return v * (1.0 / 255.0); }
+			static double fromUnorm16(uint16_t v) { return v * (1.0 / 65535.0); }
 		};
 	public:
 		NoiseGenerator(size_t seed);
@@ -70,8 +103,15 @@ class NoiseGenerator {
 		const size_t &getSeed() const;
 		void setNoiseData(const NoiseData &data);
 		void removePerlinMap(int x, int z);
+		// Optional: report PerlinMap cache bytes (MEM_NOISE)
+		void setMemoryGovernor(MemoryGovernor *memGov);
+		// Pin the decoration maps while subchunks decorate; the last release drops them
+		void acquireDecoration(PerlinMap *map);
+		void releaseDecoration(PerlinMap *map);
 		ivec2 getBorderWarping(double x, double z);
 		double getHeight(ivec2 pos);
+		// heights[i] = getHeight(pos[i])
+		void getHeights(const ivec2 *pos, double *heights, size_t count);
 		double getContinentalNoise(ivec2 pos);
 
 		// Biomes
@@ -80,10 +120,32 @@ class NoiseGenerator {
 		double getHumidityNoise(ivec2 pos);
 		Biome getBiome(ivec2 pos, double height);
 	private:
+		// Climate sampled every BIOME_LATTICE columns over one map (step 0:
+		// the map is too coarse for it to help, every column is exact)
+		struct BiomeLattice {
+			int							step = 0;
+			int							count = 0;	// corners per side
+			ivec2						origin;		// world column of corner (0, 0)
+			std::vector<BiomeClimate>	corners;
+		};
+		// Per-column inputs of getHeight ahead of the spline lookups
+		struct HeightNoise {
+			double continental;
+			double erosion;
+			double peaks;
+			double flatGate;
+		};
+		HeightNoise sampleHeightNoise(ivec2 pos);
+		static double blendHeight(const HeightNoise &n, double surfaceHeight, double erosionHeight, double peaksHeight);
+		BiomeClimate getBiomeClimate(ivec2 pos);
+		static Biome classifyBiome(const BiomeClimate &climate, double height);
+		// Temperature and humidity classifyBiome compares, after the biases
+		static void biasedClimate(const BiomeClimate &climate, double height, double &temp, double &humidity);
+		static Biome classifyClimate(double temp, double humidity);
+		static double climateMargin(double temp, double humidity);
+		void buildBiomeLattice(BiomeLattice &lattice, const PerlinMap *map, int resolution);
+		Biome getLatticeBiome(const BiomeLattice &lattice, ivec2 pos, double height);
 		double singleNoise(double x, double y) const;
-		double fade(double t) const;
-		double lerp(double a, double b, double t) const;
-		double grad(int hash, double x, double y) const;
 		double getErosionNoise(ivec2 pos);
 		double getOceanNoise(ivec2 pos);
 		double getPeaksValleysNoise(ivec2 pos);
@@ -95,12 +157,15 @@ class NoiseGenerator {
 		double getFlowerBaseNoise(ivec2 pos);
 		double getFlowerClusterNoise(ivec2 pos, int channel);
 		void   buildPlantMaps(PerlinMap* map, int resolution);
+		static size_t perlinMapBytes(const PerlinMap *map);
 
 		size_t _seed;
 		NoiseData _data;
 		std::vector<int> _permutation;
+		std::unique_ptr<NoiseBackend> _backend;
 		std::unordered_map<ivec2, PerlinMap*, ivec2_hash>	_perlinMaps;
 		std::mutex				_perlinMutex;
+		MemoryGovernor			*_memGov = nullptr;
 		SplineData spline;
 };
 
@@ -45,6 +45,18 @@ private:
 
 	// Game info
 	TopBlock _camTopBlock;
+
+	// Blocks the player can reach this tick, read in one pass
+	// (x fastest, then z, then y). Cells outside read as AIR.
+	struct VoxelSnapshot {
+		ivec3					origin{0};
+		ivec3					size{0};
+		std::vector<BlockType>	cells;
+
+		bool contains(const ivec3 &mn, const ivec3 &mx) const;
+		BlockType at(int x, int y, int z) const;
+	};
+	VoxelSnapshot _snapshot;
 public:
 	Player(Camera &cam, ChunkManager &chunkMgr);
 	~Player();
@@ -55,7 +67,6 @@ public:
 	void setGravity(bool &gravity);
 	void updateDeltaTime(float &newDelta);
 	void keyAction(int key, int scancode, int action, int mods);
-	bool tryMoveStepwise(const glm::vec3 &moveVec, float stepSize);
 	bool isSprinting() const;
 	bool isUnderWater() const;
 	void updateMovement();
@@ -72,8 +83,12 @@ public:
 	void toggleSprint();
 	void toggleGravity();
 private:
-	// Movement check
-	bool canMove(const glm::vec3& offset, float extra);
+	// Collision against the voxel snapshot
+	vec3 worldDelta(const vec3 &offset);
+	void snapshotAround(const vec3 &eyePos, const vec3 &reach, bool force);
+	bool isSolidAt(int x, int y, int z) const;
+	TopBlock groundUnder(const vec3 &eyePos) const;
+	float sweepAxis(const vec3 &eyePos, int axis, float delta) const;
 
 	// Udate player states
 	void updateFalling(vec3 &worldPos, int &blockHeight);
@@ -9,6 +9,22 @@
 #include "Chrono.hpp"
 #include "ThreadPool.hpp"
 #include "Frustum.hpp"
+#include "BlockQuery.hpp"
+
+// One ray of a batch query, dir does not need to be normalized
+struct RayQuery {
+	glm::vec3	origin;
+	glm::vec3	dir;
+	float		maxDistance;
+};
+
+struct RayHit {
+	bool		hit = false;
+	BlockType	block = AIR;
+	glm::ivec3	voxel{0};
+	glm::ivec3	prev{0};		// last empty voxel crossed before the hit
+	float		distance = 0.0f;
+};
 
 class Raycaster
 {
@@ -18,10 +34,35 @@ private:
 
 	// Camera shared data
 	Camera		&_camera;
+
+	// Chunks resolved during one query or batch: each pays the map lookup
+	// and LRU touch once, the last subchunk is kept for the common case.
+	// Chunks are pinned (as BlockQuery does) until the cache goes away
+	struct ChunkCache {
+		std::unordered_map<ivec2, Chunk *, ivec2_hash>	chunks;
+		glm::ivec3										lastKey{0};
+		SubChunk										*last = nullptr;
+		bool											hasLast = false;
+
+		ChunkCache() = default;
+		ChunkCache(const ChunkCache &) = delete;
+		ChunkCache &operator=(const ChunkCache &) = delete;
+		~ChunkCache();
+	};
+	SubChunk *lookupSubChunk(ChunkCache &cache, const glm::ivec3 &key);
+
+	// Voxel DDA that reads block data straight from the subchunk it is in
+	// (one lock per subchunk crossed) and jumps over subchunks holding only
+	// air and water. Stops on the first block that is neither.
+	RayHit march(const RayQuery &ray, ChunkCache &cache);
 public:
 	Raycaster(ChunkLoader &chunkLoader, Camera &_camera);
 	~Raycaster();
 
+	// Many rays at once (aim, highlight, line of sight). Rays are run grouped
+	// by starting subchunk and share one chunk cache. out[i] answers rays[i].
+	void raycastBatch(const std::vector<RayQuery> &rays, std::vector<RayHit> &out);
+
 	bool raycastHit(const glm::vec3& originWorld,
 		const glm::vec3& dirWorld,
 		float maxDistance,
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ft_vox.hpp"
+#include "define.hpp"
+#include <unordered_map>
+
+// Voxels of one chunk at full resolution: (subchunk Y, CHUNK_SIZE^3 blocks)
+struct StoredChunk {
+	ivec2												position;
+	std::vector<std::pair<int, std::vector<uint8_t>>>	subChunks;
+};
+
+// Pregenerated world on disk, written by ft_vox_pregen.
+// One file per REGION_SIZE x REGION_SIZE chunks (<dir>/r.<x>.<z>.vox):
+// header, a slot table, then each chunk's subchunks run-length encoded.
+// Files from another seed or noise backend are ignored. Region tables are
+// read once and kept, chunk payloads are read on demand. Thread-safe.
+class RegionStore
+{
+	private:
+		struct Index {
+			bool					valid = false;
+			std::vector<uint32_t>	offsets;	// per slot, 0 when absent
+			std::vector<uint32_t>	sizes;
+		};
+		std::string										_dir;
+		uint64_t										_seed;
+		std::mutex										_mutex;
+		std::unordered_map<ivec2, Index, ivec2_hash>	_indexes;
+
+		// Caller holds _mutex
+		const Index &index(const ivec2 &region);
+	public:
+		RegionStore(const std::string &dir, uint64_t seed);
+
+		static ivec2	regionOf(const ivec2 &chunkPos);
+		std::string		pathFor(const ivec2 &region) const;
+
+		bool		has(const ivec2 &chunkPos);
+		bool		load(const ivec2 &chunkPos, StoredChunk &out);
+		// Replace a region file with `chunks` (the ones outside it are skipped).
+		// Returns the region digest: FNV-1a over the slots in order, so two
+		// builds generating the same world write the same value.
+		uint64_t	write(const ivec2 &region, const std::vector<StoredChunk> &chunks);
+
+		// Run-length codec for voxel arrays (varint run, then the value)
+		static void	encode(const uint8_t *data, size_t size, std::vector<uint8_t> &out);
+		static bool	decode(const uint8_t *data, size_t size, uint8_t *out, size_t outSize);
+		// Value at `index` of an encoded array, without decoding the rest
+		static bool	decodeAt(const uint8_t *data, size_t size, size_t index, uint8_t &out);
+};
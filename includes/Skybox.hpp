@@ -5,7 +5,15 @@
 #include <array>
 #include <string>
 
+class ThreadPool;
+
 class Skybox {
+public:
+	// Six RGBA faces in GL order (+X -X +Y -Y +Z -Z), size 0 when empty
+	struct CubeFaces {
+		int size = 0;
+		std::vector<unsigned char> faces[6];
+	};
 private:
 	GLuint textureID;
 	GLuint VAO, VBO;
@@ -62,8 +70,11 @@ public:
 	// Explicit GL teardown (safe to call multiple times)
 	void shutdownGL();
 	// Build cubemap from a single equirectangular PNG (e.g., 2:1 panorama)
-	// faceSize controls resolution per face; if 0, it is inferred from source size
-	bool loadFromEquirectPNG(const char* filename, int faceSize = 0);
+	// faceSize controls resolution per face; if 0, it is inferred from source size.
+	// The conversion is split in row bands across pool (when given), and the
+	// faces are cached in SKYBOX_CACHE_DIR keyed by the source file hash.
+	bool loadFromEquirectPNG(const char* filename, int faceSize = 0, ThreadPool *pool = nullptr);
+	static bool decodeEquirectPNG(const char* filename, int faceSize, CubeFaces &out, ThreadPool *pool = nullptr);
 	// Build cubemap by slicing a single PNG that contains all 6 faces
 	// Supported layouts (auto-detected):
 	// - Horizontal cross (4x3 grid, T-layout)
@@ -72,6 +83,10 @@ public:
 	// - Vertical strip   (1x6)
 	// - 3x2 grid         (3x2)
 	bool loadFromSinglePNG(const char* filename, bool fixSeams=false);
+	// loadFromSinglePNG in two steps: decode needs no GL context (worker
+	// thread), uploadFaces must run on the GL thread
+	static bool decodeSinglePNG(const char* filename, bool fixSeams, CubeFaces &out);
+	bool uploadFaces(const CubeFaces &faces);
 	// Load a cubemap from 6 PNG files in this order:
 	// +X (right), -X (left), +Y (top), -Y (bottom), +Z (front), -Z (back)
 	bool loadFromPNG(const std::array<std::string, 6>& faces, bool fixSeams=false);
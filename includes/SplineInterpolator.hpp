@@ -1,5 +1,6 @@
 #pragma once
 #include "ft_vox.hpp"
+#include "define.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_access.hpp>
 
@@ -7,15 +8,28 @@ struct Point {
 	double x, y;
 };
 
+// Natural cubic spline, baked at setup into SPLINE_LUT_SIZE uniform steps
+// over [first x, last x] and read back with linear interpolation.
+// Out of range inputs give 0.
 class SplineInterpolator
 {
 	std::vector<Point> points;
 	std::vector<double> a, b, c, d, h;
+	// Lookup table: SPLINE_LUT_SIZE + 1 samples
+	std::vector<double> table;
+	double tableMin = 0.0;
+	double tableMax = 0.0;
+	double tableScale = 0.0;
 	public:
 		SplineInterpolator(const std::vector<Point>& pts);
 		SplineInterpolator();
 		double interpolate(double x) const;
+		// out[i] = interpolate(xs[i])
+		void interpolate(const double *xs, double *out, size_t count) const;
+		// Exact cubic, used to bake the table
+		double evaluate(double x) const;
 		void setPoints(const std::vector<Point>& pts);
 	private:
 		void setupData();
+		void bakeTable();
 };
@@ -10,10 +10,18 @@
 #include "ChunkManager.hpp"
 #include "Raycaster.hpp"
 #include "Player.hpp"
+#include "FarTerrain.hpp"
 #include <cstddef>
 #include <vector>
 #include <string>
 
+// Image decoded on a worker, uploaded later by the GL thread
+struct DecodedImage {
+	int							width = 0;
+	int							height = 0;
+	std::vector<unsigned char>	pixels;
+};
+
 class StoneEngine {
 	public:
 
@@ -49,16 +57,24 @@ class StoneEngine {
 		GLuint sunVAO;
 		GLuint sunVBO;
 
-		// Shadow mapping (single shadow map)
+		// Cascaded shadow maps, one layer of shadowMap per cascade
 		GLuint shadowShaderProgram = 0;	// depth-only terrain pass
 		GLuint shadowFBO = 0;
-		GLuint shadowMap = 0;
-		int shadowMapSize = 8192 * 2;
-		glm::mat4 lightSpaceMatrix{1.0f};
-		glm::vec3 _shadowCenter{0.0f, 0.0f, 0.0f};
-		float _shadowTexelWorld = 0.0f;
-		float _shadowNear = 1.0f;
-		float _shadowFar  = 500.0f;
+		GLuint shadowMap = 0;			// GL_TEXTURE_2D_ARRAY
+		int shadowMapSize = SHADOW_CASCADE_SIZE;
+		struct ShadowCascade {
+			glm::mat4	lightSpace{1.0f};
+			glm::vec3	center{0.0f};
+			glm::vec3	sunDir{0.0f};	// sun the layer was drawn with
+			float		radius = 0.0f;	// XZ half extent trusted in the terrain shader
+			float		texelWorld = 0.0f;
+			float		nearPlane = 1.0f;
+			float		farPlane = 500.0f;
+			bool		valid = false;
+		};
+		ShadowCascade _cascades[SHADOW_CASCADES];
+		int _shadowFrame = 0;
+		int _shadowCursor = 0;	// next outer cascade in the round robin
 
 		// Skybox
 		GLuint skyboxProgram = 0;
@@ -75,20 +91,25 @@ class StoneEngine {
 		GLuint flowerProgram = 0;
 		GLuint flowerVAO = 0;
 		GLuint flowerVBO = 0;    // base X-quad mesh
-		GLuint flowerInstanceVBO = 0;  // per-instance data
+		GLuint flowerInstanceVBO = 0;  // per-instance data, one slot range per subchunk
+		GLuint flowerIndirectBuffer = 0; // one draw per visible subchunk slot
 		GLuint flowerTexture = 0;      // 2D array of flower sprites
-		GLsizei flowerInstanceCount = 0;
 		int flowerLayerCount = 0;
 		int flowerShortGrassLayer = -1; // texture array layer for short_grass, if present
 		int _layerPoppy = -1;
 		int _layerDandelion = -1;
 		int _layerCyan = -1;
 		int _layerDeadBush = -1;
-		struct FlowerInstance { glm::vec3 pos; float rot; float scale; float heightScale; int typeId; };
-		// Plants stored per chunk/subchunk for visibility lifetime
-		std::unordered_map<glm::ivec2, std::unordered_map<int, std::vector<FlowerInstance>>, ivec2_hash> _flowersBySub;
-		// Rebuilt each frame for visible chunks
-		std::vector<FlowerInstance> _visibleFlowers;
+		// Instance range owned by one subchunk in flowerInstanceVBO (in instances)
+		struct FlowerSlot { GLuint first; GLuint count; GLuint capacity; };
+		std::unordered_map<glm::ivec2, std::unordered_map<int, FlowerSlot>, ivec2_hash> _flowerSlots;
+		// Released ranges (first, size), sorted by first and coalesced
+		std::vector<std::pair<GLuint, GLuint>> _flowerFreeRanges;
+		GLuint _flowerInstanceCap = 0; // instances allocated in flowerInstanceVBO
+		GLuint _flowerInstanceTop = 0; // end of the highest used range
+		std::vector<FlowerSubUpdate> _flowerUpdates;
+		std::vector<unsigned char> _flowerScratch;
+		std::vector<DrawArraysIndirectCommand> _flowerCmds;
 
 		std::map<ShaderType, PostProcessShader> postProcessShaders;
 		
@@ -110,6 +131,23 @@ class StoneEngine {
 		bool _loadingInit = false;
 		std::string _loadingText = "Loading...";
 		std::chrono::steady_clock::time_point _splashDeadline;
+
+		// Startup graph: work that needs no GL context starts first and
+		// overlaps window/context creation and shader compilation
+		std::future<std::unique_ptr<TextureArrayData>>			_blockTexturesJob;
+		std::future<DecodedImage>								_waterNormalJob;
+		std::future<Skybox::CubeFaces>							_skyboxJob;
+		std::future<std::vector<DecodedImage>>					_flowerJob;
+		std::vector<std::string>								_flowerFiles;
+		std::thread												_spawnThread;
+		// Startup timeline (ms from launch), printed with the first world frame
+		std::chrono::steady_clock::time_point					_startupBegin;
+		std::chrono::steady_clock::time_point					_startupLastMark;
+		std::vector<std::pair<const char *, double>>			_startupSteps;
+		double													_startupWaitMs = 0.0;
+		std::atomic<double>										_spawnReadyMs{-1.0};
+		double													_firstFrameMs = -1.0;
+		bool													_startupReported = false;
 		mat4 projectionMatrix;
 		mat4 viewMatrix;
 		TextureManager _textureManager;
@@ -156,6 +194,7 @@ class StoneEngine {
 	
 		// World gen
 		NoiseGenerator noise_gen;
+		FarTerrain _farTerrain;
 
 		// Game time
 		std::chrono::steady_clock::time_point start;
@@ -235,6 +274,9 @@ class StoneEngine {
 
 		// Init methods
 		void	initData();
+		void	startStartupJobs();
+		void	markStartup(const char *step);
+		void	reportStartup();
 		void	initGLEW();
 		int		initGLFW();
 		void	initTextures();
@@ -256,10 +298,14 @@ class StoneEngine {
 		void	renderLoadingScreen();
 		void	updateHelpStatusText();
 
-		// Debug/test helper to add an instance at runtime
-		void	addFlower(glm::vec3 pos, int typeId=0, float rotJitter=0.0f, float scale=1.0f, float heightScale=1.0f);
-		void	removeFlowerAtCell(const glm::ivec3& cell);
-		void	rebuildVisibleFlowersVBO();
+		// Flower instance slots
+		void	bindFlowerInstanceAttribs();
+		void	growFlowerInstanceBuffer(GLuint minCapacity);
+		GLuint	allocFlowerRange(GLuint count);
+		void	freeFlowerRange(GLuint first, GLuint count);
+		int		flowerLayerFor(char type) const;
+		void	applyFlowerUpdates();
+		GLsizei	buildFlowerDraws(const glm::mat4 &viewFull);
 
 		// Runtime methods
 		void calculateFps();
@@ -269,11 +315,13 @@ class StoneEngine {
 		void finalizeFrame();
 		void renderTransparentObjects();
 		void renderSolidObjects();
+		void renderFarTerrain();
 		void renderFlowers();
 		void resolveMsaaToFbo(FBODatas &destinationFBO, bool resolveDepth);
 		void prepareRenderPipeline();
 		void displaySun(FBODatas &targetFBO);
 		void renderShadowMap();
+		void renderShadowCascade(int index, const glm::vec3 &center, float halfExtent, const glm::vec3 &sunDir);
 		void loadFirstChunks();
 		void loadNextChunks(ivec2 newCamChunk);
 		void activateRenderShader();
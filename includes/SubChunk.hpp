@@ -7,6 +7,7 @@
 #include "Chrono.hpp"
 #include "ChunkLoader.hpp"
 #include <cstdint>
+#include <functional>
 
 class Chunk;
 class CaveGenerator;
@@ -21,6 +22,7 @@ class SubChunk
 			ivec2	size;
 			TextureType	texture;
 			Direction	direction;
+			uint8_t		light;	// skylight of the cell the face looks into
 		} Face;
 	private:
 		ivec3						_position;
@@ -28,14 +30,16 @@ class SubChunk
 		size_t						_memorySize = 0;
 		int							_chunkSize;
 		std::unique_ptr<uint8_t[]>	_blocks;
-		double						**_heightMap;
-		Biome						**_biomeMap;
-		double						**_treeMap;
-		double						**_grassMap;
-		double						**_flowerMask;
-		double						**_flowerR;
-		double						**_flowerY;
-		double						**_flowerB;
+		// Cold tier: column RLE of the voxels while _blocks is null
+		std::vector<uint8_t>		_frozenBlocks;
+		float						**_heightMap;
+		uint8_t						**_biomeMap;
+		uint16_t					**_treeMap;
+		uint8_t						**_grassMap;
+		uint8_t						**_flowerMask;
+		uint8_t						**_flowerR;
+		uint8_t						**_flowerY;
+		uint8_t						**_flowerB;
 		ChunkLoader					&_chunkLoader;
 		Chunk						&_chunk;
 
@@ -47,6 +51,20 @@ class SubChunk
 		std::vector<Face>			_faces[6];
 
 		std::mutex					_dataMutex;
+		// Cells that stop a ray (anything but air and water), under _dataMutex
+		int							_occupiedCount = 0;
+		// Bumped on every block write, under _dataMutex
+		uint32_t					_blocksVersion = 0;
+
+		// Lateral border layer as visibility bitplanes for LOD neighbours:
+		// per viewer class, an OR pyramid (level k: one bit per 2^k x 2^k cells,
+		// rows of n >> k bits). Built on first use after a write.
+		struct BorderPlanes {
+			bool					built = false;
+			uint32_t				version = 0;
+			std::vector<uint32_t>	rows;
+		};
+		BorderPlanes				_borders[4];	// NORTH, SOUTH, WEST, EAST sides
 		
 		std::vector<int>			_vertexData;
 
@@ -57,6 +75,9 @@ class SubChunk
 		int _dirCounts[6] = {0,0,0,0,0,0};
 		int _transpDirCounts[6] = {0,0,0,0,0,0};
 
+		// Plant cells found by the last sendFacesToDisplay(), packed with packPlant()
+		std::vector<uint32_t>		_plants;
+
 		bool						_needUpdate;
 		bool						_needTransparentUpdate;
 
@@ -67,8 +88,12 @@ class SubChunk
 		void markLoaded(bool loaded = true);
 		void addTextureVertex(Face face, std::vector<int> *_vertexData);
 		void addFace(ivec3 position, Direction dir, TextureType texture, bool isTransparent);
+		// Skylight of the cell in front of the face, across chunk borders
+		uint8_t faceSkyLight(const ivec3 &position, Direction dir);
 		void loadHeight(int prevResolution);
 		void loadBiome(int prevResolution);
+		// Take CHUNK_SIZE^3 pregenerated blocks instead of generating (resolution 1)
+		void loadStored(const uint8_t *blocks);
 		void loadOcean(int x, int z, size_t ground, size_t adjustedOceanHeight);
 		void loadPlaine(int x, int z, size_t ground);
 		void loadPlainsRare(int x, int z, size_t ground);
@@ -83,19 +108,72 @@ class SubChunk
 		ivec3 getPosition(void);
 		char getBlock(ivec3 position);
 		bool isNeighborTransparent(ivec3 position, Direction dir, char viewerBlock, int viewerResolution);
+		// Face test against this subchunk's `side` layer for a viewer cell of another
+		// resolution at border coords (u, v): u is x on NORTH/SOUTH, z on WEST/EAST, v is y
+		bool borderShowsFace(Direction side, int u, int v, int viewerResolution, char viewerBlock);
 		void setBlock(int x, int y, int z, char block);
 		// Direct local write (coords in [0..CHUNK_SIZE)) used by ChunkLoader
 		void setBlockLocal(int x, int y, int z, char block);
+		// Apply many packCell() writes under a single lock, in order
+		void setBlocksLocal(const uint32_t *cells, size_t count);
+		// Visit every cell whose local voxel coords lie in [lmin, lmax] under
+		// one lock; fn(local, current) returns the block to keep. Returns cells
+		// changed. Full resolution only: a coarse subchunk does not store every
+		// cell, it refuses the edit (returns 0), callers defer it instead.
+		size_t editRegion(const ivec3 &lmin, const ivec3 &lmax, const std::function<char(const ivec3 &, char)> &fn);
+		// Read-only view of the raw voxel array under the data lock:
+		// fn(blocks, chunkSize, resolution, occupiedCount), blocks may be null.
+		// A frozen array is decoded into a scratch copy and stays frozen.
+		template <class F>
+		auto withBlocks(F &&fn) -> decltype(fn((const uint8_t *)nullptr, 0, 0, 0)) {
+			std::lock_guard<std::mutex> lk(_dataMutex);
+			std::vector<uint8_t> scratch;
+			return fn(readableLocked(scratch), _chunkSize, _resolution, _occupiedCount);
+		}
 		void sendFacesToDisplay();
 		ivec2 getBorderWarping(double x, double z,  NoiseGenerator &noise_gen) const;
 		size_t getMemorySize();
+		// Cold tier: pack the voxels and free the array (0 when not worth it).
+		// Reads decode from the packed copy, writes and meshing inflate it
+		// again. Returns the bytes saved.
+		size_t freezeBlocks();
+		void thawBlocks();
+		bool isFrozen();
+		// Capacity of the mesh streams kept after sendFacesToDisplay
+		size_t getMeshMemorySize();
+		void releaseMeshData();
 		void clearFaces();
 		std::vector<int> &getVertices();
 		std::vector<int> &getTransparentVertices();
 		const int* getDirCounts() const { return _dirCounts; }
 		const int* getTranspDirCounts() const { return _transpDirCounts; }
+		std::vector<uint32_t> getPlants();
+		// Changes with every block write (and rebuild of the voxel array)
+		uint32_t getBlocksVersion();
+		// Local cell packing: x | y << 5 | z << 10 | block << 15
+		static uint32_t packCell(int x, int y, int z, char block) {
+			return (uint32_t)x | ((uint32_t)y << 5) | ((uint32_t)z << 10) | ((uint32_t)(uint8_t)block << 15);
+		}
+		// Plant cells use the same layout
+		static uint32_t packPlant(int x, int y, int z, char type) { return packCell(x, y, z, type); }
 		void updateResolution(int resolution, PerlinMap *perlinMap);
 	private:
+		static bool isOccupied(uint8_t b) { return b != AIR && b != WATER; }
+		// Caller holds _dataMutex for the three below.
+		// Decode the cold copy into `out` (false, logged, when it is corrupt)
+		bool inflateLocked(uint8_t *out);
+		// Inflate a frozen array for a write; on a corrupt cold copy _blocks
+		// stays null and the copy is kept, so the write fails
+		void thawLocked();
+		// The voxels for a read: _blocks, or the cold copy decoded into
+		// `scratch`; null when there is neither or the copy is corrupt
+		const uint8_t *readableLocked(std::vector<uint8_t> &scratch);
+		// Keep _occupiedCount in sync with a cell write (caller holds _dataMutex)
+		void trackWrite(uint8_t prev, uint8_t next) {
+			_occupiedCount += (int)isOccupied(next) - (int)isOccupied(prev);
+			++_blocksVersion;
+		}
+		void buildBorderPlanes(Direction side, const uint8_t *blocks);
 		void addBlock(BlockType block, ivec3 position, TextureType down, TextureType up, TextureType north, TextureType south, TextureType east, TextureType west, bool transparent);
 		void addUpFace(BlockType block, ivec3 position, TextureType texture, bool isTransparent);
 		void addDownFace(BlockType block, ivec3 position, TextureType texture, bool isTransparent);
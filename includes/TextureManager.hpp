@@ -25,8 +25,35 @@ enum TextureType {
 };
 
 # define N_TEXTURES 14
+// One layer per TextureType; instances carry the layer on 4 bits
+static_assert(T_CACTUS_TOP + 1 == N_TEXTURES, "N_TEXTURES must match TextureType");
+static_assert(N_TEXTURES <= 16, "the texture array is capped at 16 layers");
 # define TEXTURE_SIZE 16
 
+// Finished RGBA mip chain of the block texture array: level 0 first, each
+// level holding all layers back to back (the glTexSubImage3D layout).
+// Either decoded this run or a read-only mapping of the cache file.
+class TextureArrayData {
+	private:
+		std::vector<unsigned char>	_owned;
+		void						*_mapped = nullptr;
+		size_t						_mappedSize = 0;
+		const unsigned char			*_pixels = nullptr;
+		int							_levels = 0;
+	public:
+		TextureArrayData(std::vector<unsigned char> &&pixels, int levels);
+		TextureArrayData(void *mapped, size_t mappedSize, size_t pixelOffset, int levels);
+		~TextureArrayData();
+		TextureArrayData(const TextureArrayData &) = delete;
+		TextureArrayData &operator=(const TextureArrayData &) = delete;
+
+		bool					isMapped() const;
+		int						levels() const;
+		static int				levelSize(int level);
+		static size_t			levelBytes(int level);
+		const unsigned char		*level(int level) const;
+};
+
 class TextureManager {
 	private:
 		GLuint _textureArrayID = 0;
@@ -36,5 +63,11 @@ class TextureManager {
 		// Explicit GL teardown (safe to call multiple times)
 		void shutdownGL();
 		void loadTexturesArray(std::vector<std::pair<TextureType, std::string>> data);
+		// Split of loadTexturesArray: loading needs no GL context, upload does.
+		// Loading maps TEXTURE_CACHE_DIR's array cache when every source file
+		// still hashes the same, otherwise decodes and rewrites the cache.
+		static std::unique_ptr<TextureArrayData> loadTextureArrayData(const std::vector<std::pair<TextureType, std::string>> &data);
+		static std::vector<std::vector<unsigned char>> decodeTextures(const std::vector<std::pair<TextureType, std::string>> &data);
+		void uploadTextureArray(const TextureArrayData &array);
 		GLuint getTextureArray() const;
 };
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ft_vox.hpp"
+#include "define.hpp"
+#include "ThreadPool.hpp"
+#include "ChunkLoader.hpp"
+
+#include <functional>
+
+// Dense block region for copy/paste: x fastest, then z, then y
+struct BlockRegion {
+	glm::ivec3				size{0};
+	std::vector<BlockType>	blocks;
+
+	size_t index(const glm::ivec3 &p) const {
+		return (size_t)p.x + (size_t)p.z * (size_t)size.x + (size_t)p.y * (size_t)size.x * (size_t)size.z;
+	}
+};
+
+// Large world edits (box fill, ellipsoid, replace, copy/paste).
+// The region is split per subchunk, each part runs on the pool and edits the
+// block array under a single lock, then the touched chunks are remeshed once,
+// in parallel. Chunks that are missing, building or only loaded at a coarse
+// LOD get the edit parked as one box per chunk (ChunkLoader::queueRegion),
+// applied once the chunk is loaded at full resolution. Copies cannot wait:
+// copyBox fails if any part of the box is not loaded at full resolution.
+// Call from the main thread: it waits on pool jobs.
+class WorldEdit
+{
+private:
+	ChunkLoader	&_chunkLoader;
+	ThreadPool	&_pool;
+
+	// Returns true and sets `out` to write a block at `world`
+	typedef EditCellOp CellOp;
+
+	// complete (optional): false when a read-only op skipped chunks not loaded at full resolution
+	size_t apply(glm::ivec3 mn, glm::ivec3 mx, const CellOp &op, bool writes, bool byPlayer, bool *complete = nullptr);
+public:
+	WorldEdit(ChunkLoader &chunkLoader, ThreadPool &pool);
+	~WorldEdit();
+
+	// Corners are inclusive and may come in any order. Return cells changed.
+	size_t fillBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockType value, bool byPlayer = true);
+	size_t fillEllipsoid(const glm::vec3 &center, const glm::vec3 &radii, BlockType value, bool byPlayer = true);
+	size_t replaceInBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockType from, BlockType to, bool byPlayer = true);
+	// False (and `out` left empty) when part of the box is not loaded at full resolution
+	bool	copyBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockRegion &out);
+	// origin receives region cell (0,0,0); skipAir keeps the world where the region is empty
+	size_t paste(const BlockRegion &region, const glm::ivec3 &origin, bool skipAir = true, bool byPlayer = true);
+};
@@ -32,6 +32,10 @@
 #ifndef LOADING_SPLASH_MS
 # define LOADING_SPLASH_MS 10
 #endif
+// Chunks around spawn generated in parallel before streaming starts
+#ifndef SPAWN_RING_RADIUS
+# define SPAWN_RING_RADIUS 1
+#endif
 # define RENDER_DISTANCE 15
 # define NB_CHUNKS RENDER_DISTANCE * RENDER_DISTANCE
 # define CHUNK_SIZE 32
@@ -39,15 +43,141 @@
 # define SUBCHUNK_MARGIN_DOWN (0)
 # define LOD_THRESHOLD 16
 
+// Pregenerated regions (ft_vox_pregen): chunks per file side and directory
+#ifndef REGION_SIZE
+# define REGION_SIZE 16
+#endif
+#ifndef REGION_DIR
+# define REGION_DIR "regions"
+#endif
+
+// Terrain height splines: lookup table steps over the control point range
+#ifndef SPLINE_LUT_SIZE
+# define SPLINE_LUT_SIZE 1024
+#endif
+
+// Transparent draw ordering: depth quantisation (steps per block) and the
+// camera travel (blocks) after which the order is rebuilt from scratch
+#ifndef TRANSP_SORT_DEPTH_SCALE
+# define TRANSP_SORT_DEPTH_SCALE 4.0f
+#endif
+#ifndef TRANSP_SORT_RESORT_DIST
+# define TRANSP_SORT_RESORT_DIST 4.0f
+#endif
+
+// Flower instance buffer: initial capacity and slot rounding (instances)
+#ifndef FLOWER_INSTANCE_INITIAL
+# define FLOWER_INSTANCE_INITIAL 4096
+#endif
+#ifndef FLOWER_SLOT_GRANULARITY
+# define FLOWER_SLOT_GRANULARITY 8
+#endif
+
+// Camera velocity estimate: smoothing time constant (s) and the speed
+// (blocks/s) above which a position jump is treated as a teleport
+#ifndef CAMERA_VELOCITY_SMOOTHING
+# define CAMERA_VELOCITY_SMOOTHING 0.25f
+#endif
+#ifndef CAMERA_TELEPORT_SPEED
+# define CAMERA_TELEPORT_SPEED 500.0f
+#endif
+
+// Predictive chunk prefetch along the camera's velocity, beyond the visible ring
+#ifndef PREFETCH_LOOKAHEAD_SEC
+# define PREFETCH_LOOKAHEAD_SEC 3.0f
+#endif
+#ifndef PREFETCH_MIN_SPEED
+# define PREFETCH_MIN_SPEED 8.0f		// blocks/s, slower movement keeps up on its own
+#endif
+#ifndef PREFETCH_BAND
+# define PREFETCH_BAND 1				// chunks on each side of the predicted path
+#endif
+#ifndef PREFETCH_MAX_CHUNKS
+# define PREFETCH_MAX_CHUNKS 48
+#endif
+#ifndef PREFETCH_CANCEL_COS
+# define PREFETCH_CANCEL_COS 0.85f		// heading change (cos) that cancels a band
+#endif
+
+// Progressive loading: chunks not cached yet first appear at the coarse
+// resolution, then are refined to their LOD target (visible and nearest first)
+// with at most REFINE_BUDGET_MS of loader work per REFINE_FRAME_MS
+#ifndef PROGRESSIVE_COARSE_RES
+# define PROGRESSIVE_COARSE_RES 8
+#endif
+#ifndef PROGRESSIVE_FULL_RADIUS
+# define PROGRESSIVE_FULL_RADIUS 1		// rings around the player loaded at full detail directly
+#endif
+#ifndef REFINE_BUDGET_MS
+# define REFINE_BUDGET_MS 6
+#endif
+#ifndef REFINE_FRAME_MS
+# define REFINE_FRAME_MS 16
+#endif
+
 // Base rotation multiplier for mouse look
 # define ROTATION_SPEED 2.0f
 # define CACHE_SIZE NB_CHUNKS * 2
 
-// Number of chunks allowed in addition to the visible grid
-// (RenderDistance*RenderDistance). Eviction will try to keep the
-// farthest non-modified, non-displayed chunks pruned beyond this slack.
-#ifndef EXTRA_CACHE_CHUNKS
-# define EXTRA_CACHE_CHUNKS 100
+// Memory governor budgets (MB) per category. Cached chunks are evicted
+// (farthest first) or stripped of their CPU meshes when the category they
+// hold is over budget, or when the CPU categories exceed the hard cap.
+// GPU and flower budgets pull the display radius in instead.
+#ifndef MEMORY_HARD_CAP_MB
+# define MEMORY_HARD_CAP_MB 1792
+#endif
+#ifndef MEMORY_BUDGET_VOXELS_MB
+# define MEMORY_BUDGET_VOXELS_MB 1024
+#endif
+#ifndef MEMORY_BUDGET_MESHES_MB
+# define MEMORY_BUDGET_MESHES_MB 768
+#endif
+#ifndef MEMORY_BUDGET_NOISE_MB
+# define MEMORY_BUDGET_NOISE_MB 256
+#endif
+#ifndef MEMORY_BUDGET_GPU_MB
+# define MEMORY_BUDGET_GPU_MB 768
+#endif
+#ifndef MEMORY_BUDGET_FLOWERS_MB
+# define MEMORY_BUDGET_FLOWERS_MB 64
+#endif
+#ifndef GPU_BUDGET_MIN_RADIUS
+# define GPU_BUDGET_MIN_RADIUS 4		// display radius (chunks) never pulled below this
+#endif
+#ifndef GPU_BUDGET_REGROW_PERCENT
+# define GPU_BUDGET_REGROW_PERCENT 80	// widen again once GPU usage is under this share
+#endif
+// Chunks leaving the display keep their last mesh packed (a few bytes per
+// instance) and unpack it when shown again; 0 keeps the raw streams until
+// the mesh budget strips them, and redisplay remeshes
+#ifndef PACK_CACHED_MESHES
+# define PACK_CACHED_MESHES 1
+#endif
+// Chunks leaving the display get their voxels column-RLE packed on a pool
+// thread (cold tier), inflated on first access or when displayed again
+#ifndef COLD_VOXEL_TIER
+# define COLD_VOXEL_TIER 1
+#endif
+
+// Voxel skylight levels (0..15, one nibble per cell, baked as 3 bits per face)
+# define SKYLIGHT_MAX 15
+// Shadow maps cover this many chunks around the camera, skylight lights the rest
+#ifndef SHADOW_NEAR_RADIUS
+# define SHADOW_NEAR_RADIUS 8
+#endif
+// Cascades (1..4) of SHADOW_CASCADE_SIZE^2, each half the extent of the next;
+// the outer ones are redrawn round robin, one every SHADOW_CASCADE_INTERVAL frames
+#ifndef SHADOW_CASCADES
+# define SHADOW_CASCADES 3
+#endif
+#ifndef SHADOW_CASCADE_SIZE
+# define SHADOW_CASCADE_SIZE 2048
+#endif
+#ifndef SHADOW_CASCADE_INTERVAL
+# define SHADOW_CASCADE_INTERVAL 4
+#endif
+#ifndef SHADOW_SUN_EPS_DEG
+# define SHADOW_SUN_EPS_DEG 0.25f	// sun rotation that makes a cascade stale
 #endif
 
 # define MOVEMENT_SPEED 0.5f
@@ -62,6 +192,12 @@
 # define PLAYER_HEIGHT 1.8f
 # define EYE_HEIGHT 1.62f
 # define EPS 0.02f
+// Player collision box half extent on X/Z
+# define PLAYER_HALF_WIDTH 0.3f
+// Blocks read below the feet each tick to find the ground
+#ifndef PLAYER_SNAPSHOT_DEPTH
+# define PLAYER_SNAPSHOT_DEPTH 8
+#endif
 
 # define KHR_DEBUG false
 # define CAVES true
@@ -71,6 +207,23 @@
 # define OCEAN_HEIGHT 111
 # define MOUNT_HEIGHT 260
 
+// Default noise backend (NoiseBackendType: 0 perlin, 1 opensimplex2, 2 value),
+// overridden at startup by FT_VOX_NOISE
+#ifndef NOISE_BACKEND
+# define NOISE_BACKEND 0
+#endif
+
+// Biome climate lattice step (columns), should divide CHUNK_SIZE
+#ifndef BIOME_LATTICE
+# define BIOME_LATTICE 8
+#endif
+// Closest a lattice corner may be to a biome threshold (biased temperature
+// or humidity) for its cell to skip the exact climate. Empirical: no column
+// differed from getBiome at 0.05 over 26M columns and 4 seeds
+#ifndef BIOME_LATTICE_MARGIN
+# define BIOME_LATTICE_MARGIN 0.08
+#endif
+
 # define SCHOOL_SAMPLES 1
 
 // Camera frustum planes
@@ -81,10 +234,55 @@
 # define FAR_PLANE 9600.0f
 #endif
 
+// Far heightfield clipmap (beyond the voxel render distance)
+#ifndef FAR_TERRAIN
+# define FAR_TERRAIN true
+#endif
+#ifndef FAR_TERRAIN_LEVELS
+# define FAR_TERRAIN_LEVELS 5
+#endif
+#ifndef FAR_TERRAIN_GRID
+# define FAR_TERRAIN_GRID 128			// cells per side, per level
+#endif
+#ifndef FAR_TERRAIN_STEP
+# define FAR_TERRAIN_STEP 8			// level 0 cell size in blocks, doubles per level
+#endif
+#ifndef FAR_TERRAIN_RECENTER_CELLS
+# define FAR_TERRAIN_RECENTER_CELLS 4	// rebuild a level once its center drifts this far
+#endif
+#ifndef FAR_TERRAIN_SINK
+# define FAR_TERRAIN_SINK 2.0f
+#endif
+#ifndef FAR_TERRAIN_MORPH_CELLS
+# define FAR_TERRAIN_MORPH_CELLS 16		// border band where a level morphs onto its parent
+#endif
+#ifndef FAR_TERRAIN_SKIRT
+# define FAR_TERRAIN_SKIRT 4.0f			// skirt depth below each level's border, in cells
+#endif
+
 // Single-file cubemap PNG (cross/strip/grid). If present, used first.
 #ifndef SKYBOX_SINGLE_PNG
 # define SKYBOX_SINGLE_PNG "textures/cloud1.png"
 #endif
+// Equirectangular panorama, used when the single-file PNG is absent
+#ifndef SKYBOX_EQUIRECT_PNG
+# define SKYBOX_EQUIRECT_PNG "textures/sky_equirect.png"
+#endif
+// Converted equirect cubemaps, keyed by source file hash
+#ifndef SKYBOX_CACHE_DIR
+# define SKYBOX_CACHE_DIR "cache"
+#endif
+// Block texture array with its mip chain, keyed by source file hashes
+#ifndef TEXTURE_CACHE_DIR
+# define TEXTURE_CACHE_DIR "cache"
+#endif
+// Linked GL program binaries, keyed by shader sources and driver strings
+#ifndef SHADER_CACHE_DIR
+# define SHADER_CACHE_DIR "cache"
+#endif
+#ifndef SHADER_BINARY_CACHE
+# define SHADER_BINARY_CACHE 1	// 0 always compiles from source
+#endif
 
 # define AIR 0
 # define STONE 'S'
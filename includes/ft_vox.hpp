@@ -64,6 +64,8 @@ struct DisplayData {
 	// bit 0..2: face direction (0..5)
 	// other bits reserved
 	std::vector<uint32_t>                   drawMeta;
+	// MEM_MESHES bytes currently charged for this copy (MemoryGovernor)
+	size_t                                  memCharged = 0;
 };
 
 const float rectangleVertices[] =
@@ -85,6 +87,15 @@ GLuint compileShader(const char* filePath, GLenum shaderType);
 GLuint createShaderProgram(const char* vertexShaderPath, const char* fragmentShaderPath);
 bool faceDisplayCondition(char blockToDisplay, char neighborBlock, Direction dir);
 GLuint compileComputeShader(const char* src);
+// Program binary cache counters since launch, printed with the startup report
+struct ShaderCacheStats {
+	int		hits = 0;
+	int		misses = 0;
+	double	loadMs = 0.0;		// glProgramBinary on hits
+	double	compileMs = 0.0;	// compile + link on misses
+	double	savedMs = 0.0;		// recorded compile time of the hits, minus loadMs
+};
+const ShaderCacheStats &shaderCacheStats();
 // static glm::mat4 makeObliqueProjection(const glm::mat4& proj,
 // 	const glm::mat4& view,
 // 	const glm::vec4& planeWorld);
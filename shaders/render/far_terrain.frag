@@ -0,0 +1,45 @@
+#version 430 core
+
+uniform vec3 cameraPos;
+uniform vec3 sunDir;
+uniform int  timeValue;
+uniform float innerRadius; // half-extent owned by the voxel pass
+uniform vec4 holeRect;     // finer clipmap level (minX, minZ, maxX, maxZ)
+
+in vec3 FragPos;
+in vec3 Color;
+in vec3 Normal;
+
+out vec4 FragColor;
+
+float calculateAmbientLight(float time) {
+	const float pi = 3.14159265359;
+	const float dayStart = 42000.0;
+	const float dayLen   = 86400.0 - dayStart;
+	float dayPhase = clamp((time - dayStart) / dayLen, 0.0, 1.0);
+	float solar = sin(dayPhase * pi);
+	return mix(0.10, 0.35, solar);
+}
+
+void main() {
+	// Leave the near square to real voxels
+	vec2 d = abs(FragPos.xz - cameraPos.xz);
+	if (max(d.x, d.y) < innerRadius)
+		discard;
+	// Leave the finer level's window to that level
+	if (FragPos.x >= holeRect.x && FragPos.x <= holeRect.z &&
+		FragPos.z >= holeRect.y && FragPos.z <= holeRect.w)
+		discard;
+
+	const float pi = 3.14159265359;
+	const float dayStart = 42000.0;
+	const float dayLen   = 86400.0 - dayStart;
+	float dayPhase = clamp((timeValue - dayStart) / dayLen, 0.0, 1.0);
+	float sunAmt = smoothstep(0.0, 0.15, sin(dayPhase * pi));
+
+	float ambient = calculateAmbientLight(timeValue);
+	float diffuse = max(dot(normalize(Normal), normalize(sunDir)), 0.0);
+	float totalLight = clamp(ambient * 0.6 + diffuse * 0.9 * 0.2 * sunAmt + 0.1, 0.0, 1.0);
+
+	FragColor = vec4(Color * totalLight * vec3(1.0, 0.95, 0.95), 1.0);
+}
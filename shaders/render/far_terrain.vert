@@ -0,0 +1,97 @@
+#version 430 core
+
+uniform mat4 view;        // rotation-only view
+uniform mat4 projection;
+uniform vec3 cameraPos;   // world-space camera position
+uniform sampler2D cells;  // toroidal N x N grid: rgb = colour, a = height
+uniform ivec2 origin;     // grid coord of the window min corner (even)
+uniform int gridSize;
+uniform float cellStep;   // world blocks per cell
+uniform float sinkDepth;  // push the heightfield under the voxel surface at the seam
+uniform float morphCells; // border band morphed onto the parent level (0 = none)
+uniform float skirtCells; // skirt depth below the window border, in cells
+
+out vec3 FragPos;
+out vec3 Color;
+out vec3 Normal;
+
+const ivec2 CORNERS[6] = ivec2[6](
+	ivec2(0, 0), ivec2(0, 1), ivec2(1, 1),
+	ivec2(0, 0), ivec2(1, 1), ivec2(1, 0)
+);
+
+vec4 fetchCell(ivec2 local)
+{
+	local = clamp(local, ivec2(0), ivec2(gridSize - 1));
+	ivec2 g = origin + local;
+	ivec2 slot = ivec2(((g.x % gridSize) + gridSize) % gridSize,
+					   ((g.y % gridSize) + gridSize) % gridSize);
+	return texelFetch(cells, slot, 0);
+}
+
+// Height of the parent level's surface at this vertex: parent vertices sit on
+// even cells, odd ones lie on a parent edge (or its (0,0)-(1,1) diagonal)
+float parentHeight(ivec2 local, float h)
+{
+	bvec2 odd = bvec2((local.x & 1) != 0, (local.y & 1) != 0);
+	if (odd.x && odd.y)
+		return 0.5 * (fetchCell(local - ivec2(1)).a + fetchCell(local + ivec2(1)).a);
+	if (odd.x)
+		return 0.5 * (fetchCell(local - ivec2(1, 0)).a + fetchCell(local + ivec2(1, 0)).a);
+	if (odd.y)
+		return 0.5 * (fetchCell(local - ivec2(0, 1)).a + fetchCell(local + ivec2(0, 1)).a);
+	return h;
+}
+
+void main()
+{
+	// Even quad count: both window edges land on parent vertices
+	int quads = gridSize - 2;
+	int quad = gl_VertexID / 6;
+	ivec2 corner = CORNERS[gl_VertexID % 6];
+	ivec2 local;
+	bool skirtBottom = false;
+	if (quad < quads * quads)
+		local = ivec2(quad % quads, quad / quads) + corner;
+	else
+	{
+		// Skirt: one vertical quad per border segment, hanging below the edge
+		int s = quad - quads * quads;
+		int side = s / quads;
+		int i = (s % quads) + corner.x;
+		if (side == 0)		local = ivec2(i, 0);
+		else if (side == 1)	local = ivec2(i, quads);
+		else if (side == 2)	local = ivec2(0, i);
+		else				local = ivec2(quads, i);
+		skirtBottom = corner.y == 1;
+	}
+
+	vec4 c = fetchCell(local);
+	float hL = fetchCell(local - ivec2(1, 0)).a;
+	float hR = fetchCell(local + ivec2(1, 0)).a;
+	float hD = fetchCell(local - ivec2(0, 1)).a;
+	float hU = fetchCell(local + ivec2(0, 1)).a;
+
+	// Blend toward the parent surface across the border band; at the border
+	// itself the vertex matches the parent edge exactly (no T-junction crack)
+	float height = c.a;
+	if (morphCells > 0.0)
+	{
+		int border = min(min(local.x, local.y), min(quads - local.x, quads - local.y));
+		float morph = clamp(1.0 - float(border) / morphCells, 0.0, 1.0);
+		height = mix(height, parentHeight(local, height), morph);
+	}
+	if (skirtBottom)
+		height -= skirtCells * cellStep;
+
+	vec3 worldPosition = vec3(float(origin.x + local.x) * cellStep,
+							  height - sinkDepth,
+							  float(origin.y + local.y) * cellStep);
+
+	// Camera-relative rendering to avoid precision cracks at large coords
+	vec3 relPos = worldPosition - cameraPos;
+	gl_Position = projection * view * vec4(relPos, 1.0);
+	FragPos = worldPosition;
+	Color = c.rgb;
+	Normal = normalize(vec3(hL - hR, 2.0 * cellStep, hD - hU));
+}
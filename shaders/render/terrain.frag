@@ -5,19 +5,24 @@ uniform int  timeValue;
 uniform mat4 view;
 uniform vec3 cameraPos;
 uniform sampler2DArray textureArray;
-uniform sampler2DShadow shadowMap;
-uniform mat4 lightSpaceMatrix;
+uniform sampler2DArrayShadow shadowMap;	// one layer per cascade
 uniform vec3 sunDir;
-uniform float shadowTexelWorld;
-uniform float shadowNear;
-uniform float shadowFar;
 uniform float shadowBiasSlope;
 uniform float shadowBiasConstant;
+// Cascades, nearest first. Footprint: center (xyz) and trusted XZ half
+// extent (w, 0 until drawn); skylight beyond the last one
+const int MAX_CASCADES = 4;
+uniform int   cascadeCount;
+uniform mat4  cascadeMatrix[MAX_CASCADES];
+uniform float cascadeTexelWorld[MAX_CASCADES];
+uniform float cascadeDepthRange[MAX_CASCADES];
+uniform vec4  cascadeFootprint[MAX_CASCADES];
 
 in vec2 TexCoord;
 flat in int TextureID;
 in vec3 Normal;
 in vec3 FragPos;
+in float SkyLight;
 
 out vec4 FragColor;
 
@@ -44,9 +49,15 @@ float calculateSpecularLight(float time, vec3 lightDir) {
 	return specularStrength * spec;
 }
 
-float computeShadow(vec3 fragPos, vec3 normal, vec3 lightDir)
+float cascadeDistance(int c)
 {
-	vec4 fragPosLightSpace = lightSpaceMatrix * vec4(fragPos, 1.0);
+	vec2 d = abs(FragPos.xz - cascadeFootprint[c].xz);
+	return max(d.x, d.y);
+}
+
+float computeShadow(vec3 fragPos, vec3 normal, vec3 lightDir, int cascade)
+{
+	vec4 fragPosLightSpace = cascadeMatrix[cascade] * vec4(fragPos, 1.0);
 	vec3 proj = fragPosLightSpace.xyz / fragPosLightSpace.w;
 	proj = proj * 0.5 + 0.5;
 
@@ -60,15 +71,15 @@ float computeShadow(vec3 fragPos, vec3 normal, vec3 lightDir)
 		return 0.0;
 
 	float biasWorld = shadowBiasConstant + shadowBiasSlope * (1.0 - ndotl);
-	biasWorld = max(biasWorld * shadowTexelWorld, 0.0005);
-	float biasDepth = biasWorld / max(shadowFar - shadowNear, 1e-4);
+	biasWorld = max(biasWorld * cascadeTexelWorld[cascade], 0.0005);
+	float biasDepth = biasWorld / max(cascadeDepthRange[cascade], 1e-4);
 
-	vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0));
+	vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
 	float samples = 0.0;
 	for (int x = -1; x <= 1; ++x)
 	for (int y = -1; y <= 1; ++y) {
 		vec2 offset = vec2(float(x), float(y)) * texelSize;
-		samples += 1.0 - texture(shadowMap, vec3(proj.xy + offset, proj.z - biasDepth));
+		samples += 1.0 - texture(shadowMap, vec4(proj.xy + offset, float(cascade), proj.z - biasDepth));
 	}
 	return samples / 9.0;
 }
@@ -89,12 +100,27 @@ void main() {
 	float sunAmt = smoothstep(0.0, 0.15, sin(dayPhase * pi));
 	float diffuseFactor = 0.2 * sunAmt;
 
-	float shadow = computeShadow(FragPos, norm, lightDir);
-	float shadowFactor = 1.0 - shadow;
-
-	float totalLight = clamp(ambient * 0.6 +
+	// Near: the first cascade that holds the fragment. Far: only faces open
+	// to the sky get the sun. The last chunk of the outer cascade fades into
+	// the skylight term.
+	int cascade = 0;
+	while (cascade < cascadeCount - 1 && cascadeDistance(cascade) >= cascadeFootprint[cascade].w)
+		++cascade;
+	float farBlend = 0.0;
+	if (cascade == cascadeCount - 1) {
+		float outerRadius = cascadeFootprint[cascade].w;
+		farBlend = smoothstep(outerRadius - 32.0, outerRadius, cascadeDistance(cascade));
+	}
+	float skySun = smoothstep(0.7, 1.0, SkyLight);
+	float shadowFactor = skySun;
+	if (farBlend < 1.0)
+		shadowFactor = mix(1.0 - computeShadow(FragPos, norm, lightDir, cascade), skySun, farBlend);
+	// Caves and overhangs lose the sky ambient too
+	float skyAmbient = mix(0.15, 1.0, SkyLight);
+
+	float totalLight = clamp((ambient * 0.6 + 0.1) * skyAmbient +
 						   diffuse * 0.9 * diffuseFactor * shadowFactor +
-						   specular * 0.5 * shadowFactor + 0.1, 0.0, 1.0);
+						   specular * 0.5 * shadowFactor, 0.0, 1.0);
 
 	vec3 result = totalLight * lightColor * texColor.rgb;
 	FragColor = vec4(result, texColor.a);
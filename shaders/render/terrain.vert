@@ -22,6 +22,7 @@ out vec2 TexCoord;
 flat out int TextureID;
 out vec3 Normal;
 out vec3 FragPos;
+out float SkyLight;
 
 const float LOG_INSET = 0.10; // shrink logs/leaves a bit so they look rounded
 // DEBUG: set to 1 to draw 1x1 markers at each subchunk origin (ignores instances)
@@ -42,7 +43,8 @@ void main() {
 	int direction = int(drawMeta[gl_DrawID] & 0x7u);
 	int lengthX   = (instanceData >> 15) & 0x1F;
 	int lengthY   = (instanceData >> 20) & 0x1F;
-	int textureID = (instanceData >> 25) & 0x7F;
+	int textureID = (instanceData >> 25) & 0xF;
+	int skyLight  = (instanceData >> 29) & 0x7;
 
 	lengthX++; lengthY++; // greedy lengths are stored (len-1)
 
@@ -129,4 +131,5 @@ void main() {
 	TextureID = textureID;
 	Normal = mat3(transpose(inverse(model))) * normal;
 	FragPos = worldPosition;
+	SkyLight = float(skyLight) / 7.0;
 }
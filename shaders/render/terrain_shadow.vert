@@ -30,7 +30,7 @@ void main() {
 	int direction = int(drawMeta[gl_DrawID] & 0x7u);
 	int lengthX   = (instanceData >> 15) & 0x1F;
 	int lengthY   = (instanceData >> 20) & 0x1F;
-	int textureID = (instanceData >> 25) & 0x7F;
+	int textureID = (instanceData >> 25) & 0xF;
 	lengthX++; lengthY++;
 
 	vec3 instancePos = vec3(x, y, z);
@@ -31,7 +31,7 @@ void main()
 	int direction = int(drawMeta[gl_DrawID] & 0x7u);
 	int lengthX   = (instanceData >> 15) & 0x1F;
 	int lengthY   = (instanceData >> 20) & 0x1F;
-	int textureID = (instanceData >> 25) & 0x7F;
+	int textureID = (instanceData >> 25) & 0xF;
 
 	// Keep only WATER in this pass
 	if (textureID != 6) {
@@ -0,0 +1,149 @@
+#include "BlockQuery.hpp"
+
+static inline int floor_div(int a, int b) {
+	int q = a / b, r = a % b;
+	return (r && ((r < 0) != (b < 0))) ? (q - 1) : q;
+}
+
+BlockQuery::BlockQuery(ChunkLoader &chunkLoader)
+: _chunkLoader(chunkLoader)
+{
+}
+
+BlockQuery::~BlockQuery()
+{
+	for (auto &kv : _chunks)
+		if (kv.second) kv.second->unpin();
+}
+
+Chunk *BlockQuery::chunk(const ivec2 &pos)
+{
+	auto it = _chunks.find(pos);
+	if (it == _chunks.end())
+		it = _chunks.emplace(pos, _chunkLoader.pinChunk(pos)).first;
+	return it->second;
+}
+
+void BlockQuery::pin(const ivec2 &mn, const ivec2 &mx)
+{
+	for (int z = mn.y; z <= mx.y; ++z)
+		for (int x = mn.x; x <= mx.x; ++x)
+			chunk(ivec2(x, z));
+}
+
+BlockType BlockQuery::getBlock(const ivec3 &worldPos)
+{
+	BlockType b = AIR;
+	getBlocks(&worldPos, 1, &b);
+	return b;
+}
+
+void BlockQuery::getBlocks(const ivec3 *positions, size_t count, BlockType *out)
+{
+	struct Item {
+		ivec3	key;	// subchunk
+		size_t	index;
+	};
+	std::vector<Item> items;
+	items.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const ivec3 &p = positions[i];
+		out[i] = AIR;
+		if (p.y < 0)
+			continue;
+		items.push_back({ivec3(floor_div(p.x, CHUNK_SIZE), floor_div(p.y, CHUNK_SIZE), floor_div(p.z, CHUNK_SIZE)), i});
+	}
+	std::sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+		if (a.key.x != b.key.x) return a.key.x < b.key.x;
+		if (a.key.z != b.key.z) return a.key.z < b.key.z;
+		if (a.key.y != b.key.y) return a.key.y < b.key.y;
+		return a.index < b.index;
+	});
+
+	// One lock per run of requests landing in the same subchunk
+	size_t first = 0;
+	while (first < items.size())
+	{
+		const ivec3 key = items[first].key;
+		size_t last = first + 1;
+		while (last < items.size() && items[last].key == key)
+			++last;
+
+		Chunk *c = chunk(ivec2(key.x, key.z));
+		SubChunk *sc = c ? c->getSubChunk(key.y) : nullptr;
+		if (sc)
+		{
+			const ivec3 base = key * CHUNK_SIZE;
+			sc->withBlocks([&](const uint8_t *blocks, int chunkSize, int resolution, int) {
+				if (!blocks || chunkSize <= 0)
+					return;
+				const size_t plane = static_cast<size_t>(chunkSize) * static_cast<size_t>(chunkSize);
+				for (size_t i = first; i < last; ++i)
+				{
+					const ivec3 l = (positions[items[i].index] - base) / resolution;
+					out[items[i].index] = (BlockType)blocks[static_cast<size_t>(l.x)
+						+ static_cast<size_t>(l.z) * static_cast<size_t>(chunkSize)
+						+ static_cast<size_t>(l.y) * plane];
+				}
+			});
+		}
+		first = last;
+	}
+}
+
+void BlockQuery::getBlocks(const std::vector<ivec3> &positions, std::vector<BlockType> &out)
+{
+	out.resize(positions.size());
+	getBlocks(positions.data(), positions.size(), out.data());
+}
+
+void BlockQuery::readRegion(const ivec3 &mn, const ivec3 &size, BlockType *out)
+{
+	if (size.x <= 0 || size.y <= 0 || size.z <= 0)
+		return;
+	std::fill_n(out, (size_t)size.x * (size_t)size.y * (size_t)size.z, (BlockType)AIR);
+	const ivec3 mx = mn + size - 1;
+	const size_t rowZ = (size_t)size.x;
+	const size_t rowY = (size_t)size.x * (size_t)size.z;
+
+	for (int cz = floor_div(mn.z, CHUNK_SIZE); cz <= floor_div(mx.z, CHUNK_SIZE); ++cz)
+	for (int cx = floor_div(mn.x, CHUNK_SIZE); cx <= floor_div(mx.x, CHUNK_SIZE); ++cx)
+	{
+		Chunk *c = chunk(ivec2(cx, cz));
+		if (!c)
+			continue;
+		for (int sy = std::max(0, floor_div(mn.y, CHUNK_SIZE)); sy <= floor_div(mx.y, CHUNK_SIZE); ++sy)
+		{
+			SubChunk *sc = c->getSubChunk(sy);
+			if (!sc)
+				continue;
+			const ivec3 base(cx * CHUNK_SIZE, sy * CHUNK_SIZE, cz * CHUNK_SIZE);
+			const ivec3 lmin = glm::max(mn - base, ivec3(0));
+			const ivec3 lmax = glm::min(mx - base, ivec3(CHUNK_SIZE - 1));
+			sc->withBlocks([&](const uint8_t *blocks, int chunkSize, int resolution, int) {
+				if (!blocks || chunkSize <= 0)
+					return;
+				const size_t plane = (size_t)chunkSize * (size_t)chunkSize;
+				for (int y = lmin.y; y <= lmax.y; ++y)
+				for (int z = lmin.z; z <= lmax.z; ++z)
+				{
+					const uint8_t *src = blocks + (size_t)(z / resolution) * (size_t)chunkSize + (size_t)(y / resolution) * plane;
+					BlockType *dst = out + (size_t)(base.y + y - mn.y) * rowY + (size_t)(base.z + z - mn.z) * rowZ + (size_t)(base.x + lmin.x - mn.x);
+					for (int x = lmin.x; x <= lmax.x; ++x)
+						dst[x - lmin.x] = (BlockType)src[x / resolution];
+				}
+			});
+		}
+	}
+}
+
+TopBlock BlockQuery::topBlock(int worldX, int worldZ)
+{
+	Chunk *c = chunk(ivec2(floor_div(worldX, CHUNK_SIZE), floor_div(worldZ, CHUNK_SIZE)));
+	if (!c)
+		return TopBlock();
+	const int localX = worldX - floor_div(worldX, CHUNK_SIZE) * CHUNK_SIZE;
+	const int localZ = worldZ - floor_div(worldZ, CHUNK_SIZE) * CHUNK_SIZE;
+	return c->getTopBlock(localX, localZ);
+}
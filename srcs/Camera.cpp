@@ -1,4 +1,5 @@
 #include "Camera.hpp"
+#include "define.hpp"
 
 Camera::Camera() : position{-3674, 113, 8618}, angle(270, 0) {
 	_facing = e_direction(int(angle.x) / 45);
@@ -147,6 +148,35 @@ vec3 Camera::getStrafeVector() const
 	);
 }
 
+void Camera::updateVelocity(float dt)
+{
+	vec3 worldPos = getWorldPosition();
+	std::lock_guard<std::mutex> lock(_velocityMutex);
+	if (!_hasLastPos || dt <= 0.0f)
+	{
+		_lastWorldPos = worldPos;
+		_hasLastPos = true;
+		return;
+	}
+	vec3 instant = (worldPos - _lastWorldPos) / dt;
+	_lastWorldPos = worldPos;
+	// Teleports (respawn, setPos) are not motion: restart the estimate
+	if (length(instant) > CAMERA_TELEPORT_SPEED)
+	{
+		_velocity = vec3(0.0f);
+		return;
+	}
+	// Exponential smoothing over ~CAMERA_VELOCITY_SMOOTHING seconds
+	float k = 1.0f - std::exp(-dt / CAMERA_VELOCITY_SMOOTHING);
+	_velocity += (instant - _velocity) * k;
+}
+
+vec3 Camera::getVelocity()
+{
+	std::lock_guard<std::mutex> lock(_velocityMutex);
+	return _velocity;
+}
+
 /*
 	Moving the camera around (first person view)
 */
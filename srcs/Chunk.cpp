@@ -1,4 +1,98 @@
 #include "Chunk.hpp"
+#include <cstring>
+
+namespace
+{
+	void putVarint(std::vector<uint8_t> &out, uint32_t v)
+	{
+		for (; v >= 0x80; v >>= 7)
+			out.push_back((uint8_t)(v & 0x7f) | 0x80);
+		out.push_back((uint8_t)v);
+	}
+
+	bool getVarint(const uint8_t *&p, const uint8_t *end, uint32_t &v)
+	{
+		v = 0;
+		for (int shift = 0; shift <= 28; shift += 7)
+		{
+			if (p >= end)
+				return false;
+			const uint8_t byte = *p++;
+			v |= (uint32_t)(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	// A stream as 32-bit words, each zigzag-delta coded against the same
+	// word of the previous element: consecutive instances of a subchunk
+	// share most bits, so they mostly take one or two bytes
+	template <typename T>
+	void packStream(const std::vector<T> &stream, std::vector<uint8_t> &out)
+	{
+		static_assert(sizeof(T) % 4 == 0, "packStream works on 32-bit words");
+		const size_t stride = sizeof(T) / 4;
+		const size_t words = stream.size() * stride;
+		const unsigned char *bytes = reinterpret_cast<const unsigned char *>(stream.data());
+		putVarint(out, (uint32_t)stream.size());
+		for (size_t i = 0; i < words; ++i)
+		{
+			uint32_t cur, prev = 0;
+			std::memcpy(&cur, bytes + 4 * i, 4);
+			if (i >= stride)
+				std::memcpy(&prev, bytes + 4 * (i - stride), 4);
+			const uint32_t delta = cur - prev;
+			putVarint(out, (delta << 1) ^ (uint32_t)((int32_t)delta >> 31));
+		}
+	}
+
+	template <typename T>
+	bool unpackStream(const uint8_t *&p, const uint8_t *end, std::vector<T> &stream)
+	{
+		const size_t stride = sizeof(T) / 4;
+		uint32_t count;
+		if (!getVarint(p, end, count) || count > (size_t)(end - p))
+			return false;
+		stream.resize(count);
+		unsigned char *bytes = reinterpret_cast<unsigned char *>(stream.data());
+		for (size_t i = 0; i < (size_t)count * stride; ++i)
+		{
+			uint32_t zz, prev = 0;
+			if (!getVarint(p, end, zz))
+				return false;
+			if (i >= stride)
+				std::memcpy(&prev, bytes + 4 * (i - stride), 4);
+			const uint32_t cur = prev + ((zz >> 1) ^ (0u - (zz & 1u)));
+			std::memcpy(bytes + 4 * i, &cur, 4);
+		}
+		return true;
+	}
+
+	// Skylight classes: the sun only falls through clear cells, the flood
+	// fill crosses all but solid ones
+	enum { SKY_CLEAR, SKY_WATER, SKY_LEAF, SKY_SOLID };
+
+	uint8_t skyClass(uint8_t block)
+	{
+		switch (block)
+		{
+			case AIR:
+			case FLOWER_POPPY:
+			case FLOWER_DANDELION:
+			case FLOWER_CYAN:
+			case FLOWER_SHORT_GRASS:
+			case FLOWER_DEAD_BUSH:
+				return SKY_CLEAR;
+			case WATER:
+				return SKY_WATER;
+			case LEAF:
+				return SKY_LEAF;
+			default:
+				return SKY_SOLID;
+		}
+	}
+}
 
 Chunk::Chunk(ivec2 pos, PerlinMap *perlinMap, CaveGenerator &caveGen, ChunkLoader &chunkLoader, ThreadPool &pool, int resolution)
 :
@@ -12,9 +106,11 @@ _caveGen(caveGen),
 _resolution(resolution),
 _pool(pool),
 _isBuilding(false),
-_isModified(false)
+_isModified(false),
+_pins(0)
 {
 	_north = _south = _east = _west = nullptr;
+	for (auto &gen : _skyBorderGen) gen = 0;
 }
 
 void Chunk::loadBlocks() {
@@ -30,6 +126,10 @@ void Chunk::loadBlocks() {
 	std::vector<std::future<std::pair<int, SubChunk*>>> futures;
 	futures.reserve(maxYIdx - minYIdx + 1);
 
+	// Decoration maps only live while the subchunks run loadBiome
+	NoiseGenerator &noise = _chunkLoader.getNoiseGenerator();
+	noise.acquireDecoration(_perlinMap);
+
 	for (int idx = minYIdx; _chunkLoader.getIsRunning() && idx <= maxYIdx; ++idx) {
 		futures.emplace_back(_pool.enqueue([this, idx]() -> std::pair<int, SubChunk*>
 		{
@@ -70,6 +170,7 @@ void Chunk::loadBlocks() {
 		}
 		localMem += generated->getMemorySize();
 	}
+	noise.releaseDecoration(_perlinMap);
 
 	_memorySize += localMem;
 	_isInit = true;
@@ -78,8 +179,131 @@ void Chunk::loadBlocks() {
 	_isBuilding = false;
 }
 
+void Chunk::loadStored(const StoredChunk &stored) {
+	_isBuilding = true;
+
+	size_t localMem = 0;
+	for (const auto &entry : stored.subChunks) {
+		auto *loaded = new SubChunk(
+			{ _position.x, entry.first, _position.y },
+			_perlinMap, _caveGen, *this, _chunkLoader, _resolution.load()
+		);
+		loaded->loadStored(entry.second.data());
+
+		SubChunk *existing = nullptr;
+		{
+			std::lock_guard<std::mutex> lk(_subChunksMutex);
+			auto it = _subChunks.find(entry.first);
+			if (it == _subChunks.end()) {
+				_subChunks.emplace(entry.first, loaded);
+			} else {
+				existing = it->second;
+				it->second = loaded;
+			}
+		}
+		if (existing) {
+			// Neighbor writes that landed before us: keep their non-air blocks
+			for (int y = 0; y < CHUNK_SIZE; ++y)
+			for (int z = 0; z < CHUNK_SIZE; ++z)
+			for (int x = 0; x < CHUNK_SIZE; ++x) {
+				char b = existing->getBlock({x, y, z});
+				if (b != AIR) loaded->setBlock(x, y, z, b);
+			}
+			delete existing;
+		}
+		localMem += loaded->getMemorySize();
+	}
+
+	_memorySize += localMem;
+	_isInit = true;
+	_memorySize += sizeof(*this);
+	_isBuilding = false;
+}
+
+bool Chunk::exportBlocks(StoredChunk &out) {
+	if (_resolution.load() != 1)
+		return false;
+	std::vector<int> indices;
+	getSubIndices(indices);
+	std::sort(indices.begin(), indices.end());
+
+	const size_t voxels = static_cast<size_t>(CHUNK_SIZE) * CHUNK_SIZE * CHUNK_SIZE;
+	out.position = _position;
+	out.subChunks.clear();
+	for (int idx : indices) {
+		SubChunk *sub = getSubChunk(idx);
+		if (!sub)
+			continue;
+		std::vector<uint8_t> blocks(voxels, AIR);
+		sub->withBlocks([&](const uint8_t *data, int chunkSize, int, int) {
+			if (data && chunkSize == CHUNK_SIZE)
+				std::copy(data, data + voxels, blocks.begin());
+		});
+		out.subChunks.emplace_back(idx, std::move(blocks));
+	}
+	return true;
+}
+
 size_t Chunk::getMemorySize() { return _memorySize; }
 
+size_t Chunk::freezeBlocks() {
+	if (_isInit == false || _isBuilding)
+		return 0;
+	std::vector<SubChunk*> subs;
+	{
+		std::lock_guard<std::mutex> lk(_subChunksMutex);
+		subs.reserve(_subChunks.size());
+		for (auto &kv : _subChunks)
+			subs.push_back(kv.second);
+	}
+	size_t saved = 0;
+	for (SubChunk *sc : subs)
+		if (sc) saved += sc->freezeBlocks();
+	// Skylight is rebuilt from the voxels by the next mesh
+	std::lock_guard<std::mutex> lk(_skyLightMutex);
+	saved += _skyLightBytes;
+	std::vector<uint8_t>().swap(_skyLight);
+	_skyLightStamp = 0;
+	_chunkLoader.getMemoryGovernor().sub(MEM_VOXELS, _skyLightBytes);
+	_skyLightBytes = 0;
+	return saved;
+}
+
+void Chunk::thawBlocks() {
+	std::vector<SubChunk*> subs;
+	{
+		std::lock_guard<std::mutex> lk(_subChunksMutex);
+		subs.reserve(_subChunks.size());
+		for (auto &kv : _subChunks)
+			subs.push_back(kv.second);
+	}
+	for (SubChunk *sc : subs)
+		if (sc) sc->thawBlocks();
+}
+
+// Highest ground block of column (x, z) in [0, startY], -1 if none. Water and
+// decorative plants do not count. One lock for the whole column.
+static inline int groundInColumn(SubChunk *sub, int localX, int startY, int localZ, uint8_t &outBlock)
+{
+	return sub->withBlocks([&](const uint8_t *blocks, int chunkSize, int resolution, int occupied) {
+		if (!blocks || chunkSize <= 0 || occupied == 0)
+			return -1;
+		const size_t plane = static_cast<size_t>(chunkSize) * static_cast<size_t>(chunkSize);
+		const size_t column = static_cast<size_t>(localX / resolution)
+			+ static_cast<size_t>(localZ / resolution) * static_cast<size_t>(chunkSize);
+		for (int y = startY; y >= 0; --y) {
+			const uint8_t block = blocks[column + static_cast<size_t>(y / resolution) * plane];
+			if (block != AIR && block != WATER &&
+				block != FLOWER_POPPY && block != FLOWER_DANDELION &&
+				block != FLOWER_CYAN && block != FLOWER_SHORT_GRASS && block != FLOWER_DEAD_BUSH) {
+				outBlock = block;
+				return y;
+			}
+		}
+		return -1;
+	});
+}
+
 TopBlock Chunk::getTopBlock(int localX, int localZ) {
 	std::lock_guard<std::mutex> lock(_subChunksMutex);
 	int maxIdx = INT_MIN;
@@ -90,16 +314,11 @@ TopBlock Chunk::getTopBlock(int localX, int localZ) {
 		auto it = _subChunks.find(subY);
 		if (it == _subChunks.end() || !it->second) continue;
 
-		SubChunk* sub = it->second;
-	for (int y = CHUNK_SIZE - 1; y >= 0; --y) {
-		uint8_t block = sub->getBlock({localX, y, localZ});
-		// Treat decorative plants as non-solid for ground queries
-		if (block != AIR && block != WATER &&
-			block != FLOWER_POPPY && block != FLOWER_DANDELION &&
-			block != FLOWER_CYAN && block != FLOWER_SHORT_GRASS && block != FLOWER_DEAD_BUSH)
+		uint8_t block = AIR;
+		const int y = groundInColumn(it->second, localX, CHUNK_SIZE - 1, localZ, block);
+		if (y >= 0)
 			return {subY * CHUNK_SIZE + y, (char)block, {0.0, 0.0}};
 	}
-	}
 	return {0, 0, {0.0, 0.0}};
 }
 
@@ -129,18 +348,11 @@ TopBlock Chunk::getFirstSolidBelow(int localX, int startLocalY, int localZ, int
 		auto it = _subChunks.find(subY);
 		if (it == _subChunks.end() || !it->second) continue;
 
-		SubChunk* sub = it->second;
 		const int yStart = (subY == startSubY) ? startLocalY : (CHUNK_SIZE - 1);
-
-		for (int y = yStart; y >= 0; --y) {
-			const uint8_t block = sub->getBlock({localX, y, localZ});
-			// Ignore decorative plants for collision/ground detection
-			if (block != AIR && block != WATER &&
-				block != FLOWER_POPPY && block != FLOWER_DANDELION &&
-				block != FLOWER_CYAN && block != FLOWER_SHORT_GRASS && block != FLOWER_DEAD_BUSH) {
-				return { subY * CHUNK_SIZE + y, static_cast<char>(block), {0.0, 0.0} };
-			}
-		}
+		uint8_t block = AIR;
+		const int y = groundInColumn(it->second, localX, yStart, localZ, block);
+		if (y >= 0)
+			return { subY * CHUNK_SIZE + y, static_cast<char>(block), {0.0, 0.0} };
 	}
 	return {0, 0, {0.0, 0.0}};
 }
@@ -148,9 +360,11 @@ TopBlock Chunk::getFirstSolidBelow(int localX, int startLocalY, int localZ, int
 Chunk::~Chunk() {
 	for (auto &subchunk : _subChunks) delete subchunk.second;
 	_subChunks.clear();
+	_chunkLoader.getMemoryGovernor().sub(MEM_MESHES, _meshMemorySize);
+	_chunkLoader.getMemoryGovernor().sub(MEM_VOXELS, _skyLightBytes);
 }
 
-void Chunk::getNeighbors()
+void Chunk::linkNeighbors()
 {
 	ivec2 northPos{_position.x, _position.y - 1};
 	ivec2 southPos{_position.x, _position.y + 1};
@@ -165,22 +379,22 @@ void Chunk::getNeighbors()
 	// all neighbors already existed before this chunk was created.
 	_hasAllNeighbors = _north && _south && _east && _west;
 
-	if (_north) {
-		_north->setSouthChunk(this);
-		_north->sendFacesToDisplay();
-	}
-	if (_south) {
-		_south->setNorthChunk(this);
-		_south->sendFacesToDisplay();
-	}
-	if (_east) {
-		_east->setWestChunk(this);
-		_east->sendFacesToDisplay();
-	}
-	if (_west) {
-		_west->setEastChunk(this);
-		_west->sendFacesToDisplay();
-	}
+	if (_north) _north->setSouthChunk(this);
+	if (_south) _south->setNorthChunk(this);
+	if (_east) _east->setWestChunk(this);
+	if (_west) _west->setEastChunk(this);
+}
+
+void Chunk::getNeighbors()
+{
+	linkNeighbors();
+
+	// Neighbors remesh their shared border. One without a mesh (packed or
+	// never built) is meshed when displayed, the new link stales its copy.
+	if (_north && _north->isReady()) _north->sendFacesToDisplay();
+	if (_south && _south->isReady()) _south->sendFacesToDisplay();
+	if (_east && _east->isReady()) _east->sendFacesToDisplay();
+	if (_west && _west->isReady()) _west->sendFacesToDisplay();
 
 	// If fully surrounded, generate faces immediately.
 	if (_hasAllNeighbors)
@@ -193,6 +407,246 @@ void Chunk::updateHasAllNeighbors() {
 		_east  && _west;
 }
 
+uint64_t Chunk::voxelStamp() {
+	auto mix = [](uint64_t h, uint64_t v) { return (h ^ v) * 0x100000001b3ULL; };
+	uint64_t stamp = mix(0xcbf29ce484222325ULL, (uint64_t)_resolution.load());
+	// Summed so the subchunk map order does not matter
+	std::lock_guard<std::mutex> lk(_subChunksMutex);
+	for (auto &kv : _subChunks)
+		if (kv.second)
+			stamp += mix(mix(0xcbf29ce484222325ULL, (uint64_t)(uint32_t)kv.first), kv.second->getBlocksVersion());
+	return stamp;
+}
+
+uint64_t Chunk::meshStamp() {
+	const uint64_t links = (_north ? 1 : 0) | (_south ? 2 : 0) | (_east ? 4 : 0) | (_west ? 8 : 0);
+	return ((voxelStamp() ^ links) * 0x100000001b3ULL) + borderLightStamp();
+}
+
+uint64_t Chunk::borderLightStamp() {
+	auto mix = [](uint64_t h, uint64_t v) { return (h ^ v) * 0x100000001b3ULL; };
+	// Indexed by our side; each neighbor reports the opposite one
+	Chunk *const nbs[4] = {_north, _south, _west, _east};
+	const Direction faces[4] = {SOUTH, NORTH, EAST, WEST};
+	uint64_t stamp = 0;
+	for (int d = 0; d < 4; ++d)
+		if (nbs[d])
+			stamp += mix(mix(0xcbf29ce484222325ULL, (uint64_t)(d + 1)), nbs[d]->_skyBorderGen[faces[d]].load());
+	return stamp;
+}
+
+void Chunk::updateSkyLight(const std::vector<SubChunk *> &subs, std::unordered_set<int> &relit) {
+	// Neighbor generations first: a border changing during the fill stales it
+	const uint64_t stamp = voxelStamp() + borderLightStamp();
+	{
+		std::lock_guard<std::mutex> lk(_skyLightMutex);
+		if (stamp == _skyLightStamp && !_skyLight.empty())
+			return;
+	}
+	int minY = 0, maxY = -1;
+	for (SubChunk *sc : subs) {
+		if (!sc) continue;
+		const int y = sc->getPosition().y;
+		if (maxY < minY) minY = maxY = y;
+		minY = std::min(minY, y);
+		maxY = std::max(maxY, y);
+	}
+	if (maxY < minY)
+		return;
+
+	const int res = _resolution.load();
+	const int n = CHUNK_SIZE / res;
+	const size_t plane = (size_t)n * n;
+	const size_t cube = plane * n;
+	const int layers = maxY - minY + 1;
+	const int height = layers * n;
+	const size_t total = cube * layers;
+
+	// Missing subchunks are air
+	std::vector<uint8_t> cls(total, SKY_CLEAR);
+	for (SubChunk *sc : subs) {
+		if (!sc) continue;
+		uint8_t *dst = cls.data() + (size_t)(sc->getPosition().y - minY) * cube;
+		const bool ok = sc->withBlocks([&](const uint8_t *blocks, int chunkSize, int resolution, int) {
+			if (resolution != res || chunkSize != n)
+				return false;
+			if (blocks)
+				for (size_t i = 0; i < cube; ++i)
+					dst[i] = skyClass(blocks[i]);
+			return true;
+		});
+		// Mid resolution change: the next build retries
+		if (!ok)
+			return;
+	}
+
+	// Sun straight down each column until the first non-clear cell
+	std::vector<uint8_t> light(total, 0);
+	for (size_t c = 0; c < plane; ++c)
+		for (int y = height - 1; y >= 0; --y) {
+			const size_t i = c + (size_t)y * plane;
+			if (cls[i] != SKY_CLEAR)
+				break;
+			light[i] = SKYLIGHT_MAX;
+		}
+
+	// A step costs one level per block, leaves twice that
+	auto stepCost = [&](size_t j) { return res * (cls[j] == SKY_LEAF ? 2 : 1); };
+	// Light coming in from the neighbors' borders, sampled on our grid
+	Chunk *const nbs[4] = {_north, _south, _west, _east};
+	const Direction faces[4] = {SOUTH, NORTH, EAST, WEST};
+	auto borderCell = [&](int side, int u, int y) {
+		const int last = n - 1;
+		const int x = side == WEST ? 0 : side == EAST ? last : u;
+		const int z = side == NORTH ? 0 : side == SOUTH ? last : u;
+		return (size_t)x + (size_t)z * n + (size_t)y * plane;
+	};
+	std::vector<uint8_t> border;
+	for (int d = 0; d < 4; ++d) {
+		if (!nbs[d] || !nbs[d]->getSkyLightBorder(faces[d], res, minY, height, border))
+			continue;
+		for (int y = 0; y < height; ++y)
+			for (int u = 0; u < n; ++u) {
+				const size_t i = borderCell(d, u, y);
+				if (cls[i] == SKY_SOLID)
+					continue;
+				const int level = (int)border[u + (size_t)y * n] - stepCost(i);
+				if (level > (int)light[i])
+					light[i] = (uint8_t)level;
+			}
+	}
+
+	// Flood fill from lit cells next to darker open ones
+	const int dx[6] = {0, 0, -1, 1, 0, 0};
+	const int dy[6] = {0, 0, 0, 0, -1, 1};
+	const int dz[6] = {-1, 1, 0, 0, 0, 0};
+	auto neighbor = [&](size_t i, int d, size_t &j) {
+		const int x = (int)(i % n) + dx[d];
+		const int z = (int)((i / n) % n) + dz[d];
+		const int y = (int)(i / plane) + dy[d];
+		if (x < 0 || z < 0 || y < 0 || x >= n || z >= n || y >= height)
+			return false;
+		j = (size_t)x + (size_t)z * n + (size_t)y * plane;
+		return cls[j] != SKY_SOLID;
+	};
+	std::vector<uint32_t> queue;
+	for (size_t i = 0; i < total; ++i) {
+		if (light[i] == 0)
+			continue;
+		size_t j;
+		for (int d = 0; d < 6; ++d)
+			if (neighbor(i, d, j) && light[j] < light[i]) {
+				queue.push_back((uint32_t)i);
+				break;
+			}
+	}
+	for (size_t head = 0; head < queue.size(); ++head) {
+		const size_t i = queue[head];
+		size_t j;
+		for (int d = 0; d < 6; ++d) {
+			if (!neighbor(i, d, j))
+				continue;
+			const int level = (int)light[i] - stepCost(j);
+			if (level > (int)light[j]) {
+				light[j] = (uint8_t)level;
+				queue.push_back((uint32_t)j);
+			}
+		}
+	}
+
+	const size_t layerBytes = (cube + 1) / 2;
+	std::vector<uint8_t> packed(layerBytes * layers, 0);
+	for (int l = 0; l < layers; ++l)
+		for (size_t i = 0; i < cube; ++i)
+			packed[l * layerBytes + (i >> 1)] |= (uint8_t)(light[l * cube + i] << ((i & 1) * 4));
+
+	bool borderChanged[4] = {false, false, false, false};
+	{
+		std::lock_guard<std::mutex> lk(_skyLightMutex);
+		const bool sameShape = !_skyLight.empty() && _skyLightRes == res
+			&& _skyLightBase == minY && _skyLightLayers == layers;
+		for (int l = 0; l < layers; ++l) {
+			if (sameShape && std::memcmp(&packed[l * layerBytes], &_skyLight[l * layerBytes], layerBytes) == 0)
+				continue;
+			// Faces on the next layers look into this one
+			relit.insert(minY + l - 1);
+			relit.insert(minY + l);
+			relit.insert(minY + l + 1);
+			for (int d = 0; d < 4; ++d)
+				for (int y = l * n; !borderChanged[d] && y < (l + 1) * n; ++y)
+					for (int u = 0; u < n; ++u) {
+						const size_t k = borderCell(d, u, y) - (size_t)l * cube;
+						const size_t byte = l * layerBytes + (k >> 1);
+						if (!sameShape || ((packed[byte] ^ _skyLight[byte]) >> ((k & 1) * 4)) & 0xF) {
+							borderChanged[d] = true;
+							break;
+						}
+					}
+		}
+		_skyLight.swap(packed);
+		_skyLightBase = minY;
+		_skyLightLayers = layers;
+		_skyLightRes = res;
+		_skyLightStamp = stamp;
+		_chunkLoader.getMemoryGovernor().adjust(MEM_VOXELS, _skyLightBytes, _skyLight.capacity());
+		_skyLightBytes = _skyLight.capacity();
+	}
+
+	// Outside our lock: the neighbors take theirs when they refill
+	for (int d = 0; d < 4; ++d) {
+		if (!borderChanged[d])
+			continue;
+		++_skyBorderGen[d];
+		// One without a mesh reads the border when it is meshed
+		if (nbs[d] && nbs[d]->isReady())
+			_chunkLoader.markChunkDirty(nbs[d]->getPosition());
+	}
+}
+
+uint8_t Chunk::skyLightAtLocked(int x, int y, int z) const {
+	const int n = CHUNK_SIZE / _skyLightRes;
+	const int rel = y - _skyLightBase * CHUNK_SIZE;
+	if (rel < 0)
+		return 0;
+	const int layer = rel / CHUNK_SIZE;
+	if (layer >= _skyLightLayers)
+		return SKYLIGHT_MAX;
+	const size_t cube = (size_t)n * n * n;
+	const size_t i = (size_t)(x / _skyLightRes) + (size_t)(z / _skyLightRes) * n
+		+ (size_t)((rel % CHUNK_SIZE) / _skyLightRes) * n * n;
+	return (_skyLight[layer * ((cube + 1) / 2) + (i >> 1)] >> ((i & 1) * 4)) & 0xF;
+}
+
+bool Chunk::getSkyLightBorder(Direction side, int res, int baseY, int height, std::vector<uint8_t> &out) {
+	const int n = CHUNK_SIZE / res;
+	const int last = CHUNK_SIZE - 1;
+	std::lock_guard<std::mutex> lk(_skyLightMutex);
+	if (_skyLight.empty())
+		return false;
+	out.resize((size_t)n * height);
+	for (int y = 0; y < height; ++y)
+		for (int u = 0; u < n; ++u) {
+			const int x = side == WEST ? 0 : side == EAST ? last : u * res;
+			const int z = side == NORTH ? 0 : side == SOUTH ? last : u * res;
+			out[u + (size_t)y * n] = skyLightAtLocked(x, baseY * CHUNK_SIZE + y * res, z);
+		}
+	return true;
+}
+
+uint8_t Chunk::getSkyLight(int x, int y, int z) {
+	std::lock_guard<std::mutex> lk(_skyLightMutex);
+	if (_skyLight.empty())
+		return SKYLIGHT_MAX;
+	return skyLightAtLocked(x, y, z);
+}
+
+size_t Chunk::streamBytes() const {
+	return (_vertexData.capacity() + _transparentVertexData.capacity()) * sizeof(int)
+		+ (_indirectBufferData.capacity() + _transparentIndirectBufferData.capacity()) * sizeof(DrawArraysIndirectCommand)
+		+ (_ssboSolid.capacity() + _ssboTransp.capacity()) * sizeof(vec4)
+		+ (_metaSolid.capacity() + _metaTransp.capacity()) * sizeof(uint32_t);
+}
+
 void Chunk::unloadNeighbors() {
 	if (_north) _north->unloadNeighbor(SOUTH);
 	if (_south) _south->unloadNeighbor(NORTH);
@@ -239,8 +693,11 @@ SubChunk* Chunk::getOrCreateSubChunk(int subY, bool generate) {
 	);
 
 	if (generate) {
+		NoiseGenerator &noise = _chunkLoader.getNoiseGenerator();
+		noise.acquireDecoration(_perlinMap);
 		sc->loadHeight(_resolution);
 		sc->loadBiome (_resolution);
+		noise.releaseDecoration(_perlinMap);
 	} else {
 		sc->markLoaded(true);
 	}
@@ -266,7 +723,84 @@ void Chunk::clearFaces() {
 	_metaTransp.clear();
 }
 
-void Chunk::sendFacesToDisplay()
+void Chunk::releaseMeshData() {
+	std::vector<SubChunk*> subs;
+	{
+		std::lock_guard<std::mutex> lk(_subChunksMutex);
+		subs.reserve(_subChunks.size());
+		for (auto &kv : _subChunks)
+			subs.push_back(kv.second);
+	}
+	std::lock_guard<std::mutex> lkSend(_sendFacesMutex);
+	// Keep the built mesh packed; a second release keeps the first copy
+	if (PACK_CACHED_MESHES && _facesSent) {
+		std::vector<uint8_t> packed;
+		packStream(_vertexData, packed);
+		packStream(_transparentVertexData, packed);
+		packStream(_indirectBufferData, packed);
+		packStream(_transparentIndirectBufferData, packed);
+		packStream(_ssboSolid, packed);
+		packStream(_ssboTransp, packed);
+		packStream(_metaSolid, packed);
+		packStream(_metaTransp, packed);
+		packed.shrink_to_fit();
+		_packedMesh.swap(packed);
+		_packedStamp = _builtStamp;
+	}
+	std::vector<int>().swap(_vertexData);
+	std::vector<int>().swap(_transparentVertexData);
+	std::vector<DrawArraysIndirectCommand>().swap(_indirectBufferData);
+	std::vector<DrawArraysIndirectCommand>().swap(_transparentIndirectBufferData);
+	std::vector<vec4>().swap(_ssboSolid);
+	std::vector<vec4>().swap(_ssboTransp);
+	std::vector<uint32_t>().swap(_metaSolid);
+	std::vector<uint32_t>().swap(_metaTransp);
+	for (SubChunk* sc : subs)
+		if (sc) sc->releaseMeshData();
+	_chunkLoader.getMemoryGovernor().adjust(MEM_MESHES, _meshMemorySize, _packedMesh.capacity());
+	_meshMemorySize = _packedMesh.capacity();
+	// Unpacked or remeshed by loadChunk when it becomes displayed again
+	_facesSent = false;
+	_subMeshesKept = false;
+}
+
+bool Chunk::restorePackedMesh() {
+	if (_isInit == false)
+		return false;
+	const uint64_t stamp = meshStamp();
+
+	std::lock_guard<std::mutex> lkSend(_sendFacesMutex);
+	if (_facesSent || _packedMesh.empty())
+		return false;
+	bool ok = _packedStamp == stamp;
+	if (ok) {
+		const uint8_t *p = _packedMesh.data();
+		const uint8_t *end = p + _packedMesh.size();
+		ok = unpackStream(p, end, _vertexData)
+			&& unpackStream(p, end, _transparentVertexData)
+			&& unpackStream(p, end, _indirectBufferData)
+			&& unpackStream(p, end, _transparentIndirectBufferData)
+			&& unpackStream(p, end, _ssboSolid)
+			&& unpackStream(p, end, _ssboTransp)
+			&& unpackStream(p, end, _metaSolid)
+			&& unpackStream(p, end, _metaTransp)
+			&& p == end;
+	}
+	// Stale or unreadable: drop it, the caller remeshes
+	std::vector<uint8_t>().swap(_packedMesh);
+	if (!ok)
+		clearFaces();
+	const size_t meshBytes = ok ? streamBytes() : 0;
+	_chunkLoader.getMemoryGovernor().adjust(MEM_MESHES, _meshMemorySize, meshBytes);
+	_meshMemorySize = meshBytes;
+	if (ok) {
+		_builtStamp = stamp;
+		_facesSent = true;
+	}
+	return ok;
+}
+
+void Chunk::sendFacesToDisplay(const std::unordered_set<int> *onlySubY)
 {
 	// Build faces even if not fully surrounded yet. Missing neighbors are treated
 	// as transparent at borders; when neighbors arrive, both chunks will be
@@ -281,8 +815,19 @@ void Chunk::sendFacesToDisplay()
 		for (auto &kv : _subChunks)
 			subs.push_back(kv.second);
 	}
+	// Taken before reading voxels: a write during the build makes it stale
+	const uint64_t stamp = meshStamp();
 
 	std::lock_guard<std::mutex> lkSend(_sendFacesMutex);
+	// Partial rebuild only while the other subchunks still hold their meshes
+	const bool partial = onlySubY && _facesSent && _subMeshesKept;
+	// Edits can relight subchunks they did not touch
+	std::unordered_set<int> relit;
+	updateSkyLight(subs, relit);
+	auto needsRebuild = [&](SubChunk *sc) {
+		const int y = sc->getPosition().y;
+		return !partial || onlySubY->count(y) != 0 || relit.count(y) != 0;
+	};
 	clearFaces();
 
 	// First pass: build subchunk meshes and compute total sizes to reserve
@@ -291,7 +836,8 @@ void Chunk::sendFacesToDisplay()
 	size_t badDirSum  = 0;
 	for (SubChunk* sc : subs) {
 		if (!sc) continue;
-		sc->sendFacesToDisplay();
+		if (needsRebuild(sc))
+			sc->sendFacesToDisplay();
 		totalSolid += sc->getVertices().size();
 		totalTrans += sc->getTransparentVertices().size();
 		// Debug: verify per-direction counts sum to total
@@ -362,10 +908,22 @@ void Chunk::sendFacesToDisplay()
 			running += (uint32_t)count;
 		}
 
-		// Discover and record any flower cells in this subchunk for the renderer
-		if (_resolution == 1)
-			_chunkLoader.scanAndRecordFlowersFor(_position, pos.y, sc, _resolution.load());
+		// Hand this subchunk's plant list (from the meshing walk) to the renderer
+		if (needsRebuild(sc))
+			_chunkLoader.stageFlowersFor(_position, pos.y, sc->getPlants());
 	}
+
+	// A packed copy is older than this mesh
+	std::vector<uint8_t>().swap(_packedMesh);
+
+	// Report retained mesh bytes (chunk streams + per-subchunk intermediates)
+	size_t meshBytes = streamBytes();
+	for (SubChunk* sc : subs)
+		if (sc) meshBytes += sc->getMeshMemorySize();
+	_chunkLoader.getMemoryGovernor().adjust(MEM_MESHES, _meshMemorySize, meshBytes);
+	_meshMemorySize = meshBytes;
+	_builtStamp = stamp;
+	_subMeshesKept = true;
 	_facesSent = true;
 	(void)badDirSum;
 }
@@ -420,7 +978,8 @@ void Chunk::updateResolution(int newResolution) {
 		return;
 
 	// Refresh the perlin data at the requested LOD before rebuilding subchunks.
-	PerlinMap *updatedMap = _chunkLoader.getNoiseGenerator().getPerlinMap(_position, newResolution);
+	NoiseGenerator &noise = _chunkLoader.getNoiseGenerator();
+	PerlinMap *updatedMap = noise.getPerlinMap(_position, newResolution);
 	if (updatedMap)	
 		_perlinMap = updatedMap;
 
@@ -432,7 +991,9 @@ void Chunk::updateResolution(int newResolution) {
 		subs.reserve(_subChunks.size());
 		for (auto& kv : _subChunks) subs.push_back(kv.second);
 	}
+	noise.acquireDecoration(_perlinMap);
 	for (auto* sc : subs) sc->updateResolution(newResolution, _perlinMap);
+	noise.releaseDecoration(_perlinMap);
 
 	_facesSent = false;
 	sendFacesToDisplay();
@@ -493,6 +1054,11 @@ bool Chunk::isBuilding() const { return _isBuilding.load(); }
 void Chunk::setAsModified() { _isModified = true; };
 bool Chunk::getModified() const { return _isModified.load(); }
 
+// Pins are taken under ChunkLoader::_chunksMutex (see ChunkLoader::pinChunk)
+void Chunk::pin() { ++_pins; }
+void Chunk::unpin() { --_pins; }
+bool Chunk::isPinned() const { return _pins.load() > 0; }
+
 void Chunk::getSubIndices(std::vector<int>& out)
 {
 	out.clear();
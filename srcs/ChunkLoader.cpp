@@ -9,6 +9,43 @@ static inline int floor_div(int a, int b) {
 	return (r && ((r < 0) != (b < 0))) ? (q - 1) : q;
 }
 
+// Pending edit packing (chunk-local): x | z << 5 | worldY << 10 | block << 22 | byPlayer << 30
+static const int kPendingMaxY = EditBatch::MAX_Y;
+static inline uint32_t packPending(const ivec3 &worldPos, BlockType value, bool byPlayer)
+{
+	return (uint32_t)mod_floor(worldPos.x, CHUNK_SIZE)
+		| ((uint32_t)mod_floor(worldPos.z, CHUNK_SIZE) << 5)
+		| ((uint32_t)worldPos.y << 10)
+		| ((uint32_t)(uint8_t)value << 22)
+		| ((uint32_t)byPlayer << 30);
+}
+static inline ivec3 unpackPendingPos(uint32_t e, const ivec2 &chunkPos)
+{
+	return ivec3(chunkPos.x * CHUNK_SIZE + (int)(e & 31u),
+				 (int)((e >> 10) & 0xFFFu),
+				 chunkPos.y * CHUNK_SIZE + (int)((e >> 5) & 31u));
+}
+
+// LOD for a chunk at `offset` from the load center: doubles every LOD_THRESHOLD rings
+static int lodResolutionFor(const glm::ivec2 &offset)
+{
+	int chunkResolution = RESOLUTION;
+	int thresholdStep = LOD_THRESHOLD;
+	while ((std::abs(offset.x) >= thresholdStep || std::abs(offset.y) >= thresholdStep) && chunkResolution < CHUNK_SIZE) {
+		chunkResolution = std::min(CHUNK_SIZE, chunkResolution * 2);
+		if (thresholdStep > std::numeric_limits<int>::max() / 2) {
+			thresholdStep = std::numeric_limits<int>::max();
+			break;
+		}
+		thresholdStep *= 2;
+		if (thresholdStep <= 0) {
+			thresholdStep = std::numeric_limits<int>::max();
+			break;
+		}
+	}
+	return chunkResolution;
+}
+
 ChunkLoader::ChunkLoader(
 	int seed,
 	Camera &camera,
@@ -17,10 +54,12 @@ ChunkLoader::ChunkLoader(
 	std::atomic_bool *isRunning,
 	std::mutex &sharedDrawDataMutex,
 	std::queue<DisplayData *>	&solidStagedDataQueue,
-	std::queue<DisplayData *>	&transparentStagedDataQueue
+	std::queue<DisplayData *>	&transparentStagedDataQueue,
+	MemoryGovernor &memGov
 )
 :
 _sharedDrawDataMutex(sharedDrawDataMutex),
+_memGov(memGov),
 _camera(camera),
 _chronoHelper(chronoHelper),
 _threadPool(pool),
@@ -28,14 +67,23 @@ _buildingDisplay(false),
 _isRunning(isRunning),
 _perlinGenerator(seed),
 _caveGen(1000, 0.01f, 0.05f, 0.6f, 0.6f, seed),
+_regions(REGION_DIR, static_cast<uint64_t>(seed)),
 _solidStagedDataQueue(solidStagedDataQueue),
 _transparentStagedDataQueue(transparentStagedDataQueue)
 {
+	_perlinGenerator.setMemoryGovernor(&_memGov);
 	initData();
 }
 
 ChunkLoader::~ChunkLoader()
 {
+	// The cold task walks _chunks: let it finish (a joined pool drops it)
+	{
+		std::lock_guard<std::mutex> lk(_coldMutex);
+		_coldQueue.clear();
+	}
+	if (_coldJob.valid())
+		_coldJob.wait();
 	std::lock_guard<std::mutex> lock(_chunksMutex);
 	for (auto it = _chunks.begin(); it != _chunks.end(); it++)
 	{
@@ -46,15 +94,15 @@ ChunkLoader::~ChunkLoader()
 		std::lock_guard<std::mutex> lk(_sharedDrawDataMutex);
 		while (_solidStagedDataQueue.size())
 		{
-			auto &tmp = _solidStagedDataQueue.front();
+			auto tmp = _solidStagedDataQueue.front();
 			_solidStagedDataQueue.pop();
-			delete tmp;
+			_memGov.releaseDisplayData(tmp);
 		}
 		while (_transparentStagedDataQueue.size())
 		{
-			auto &tmp = _transparentStagedDataQueue.front();
+			auto tmp = _transparentStagedDataQueue.front();
 			_transparentStagedDataQueue.pop();
-			delete tmp;
+			_memGov.releaseDisplayData(tmp);
 		}
 	}
 }
@@ -62,11 +110,9 @@ ChunkLoader::~ChunkLoader()
 // --- Init methods ---
 void ChunkLoader::initData()
 {
-	_chunksMemoryUsage = 0;
 	_renderDistance = RENDER_DISTANCE;
 	_currentRender = 0;
 	_maxRender = 400;
-	_countBudget = EXTRA_CACHE_CHUNKS;
 	_modifiedCount = 0;
 	// Initialize debug snapshot mirrors
 	_dbg_chunksMemoryUsage = 0;
@@ -77,22 +123,91 @@ void ChunkLoader::initData()
 	_dbg_modifiedCount = 0;
 }
 
+Chunk *ChunkLoader::generateChunk(const ivec2 &pos)
+{
+	return createChunk(pos, RESOLUTION, /*headless=*/true);
+}
+
+// Chunks spill trees into their neighbors and test them for room, so what
+// a chunk holds depends on which neighbors exist when it generates. Runs
+// fn(i) for every position on plain threads (chunk generation waits on pool
+// jobs, running it from pool workers could starve the pool), in nine waves
+// by (x mod 3, z mod 3): chunks of one wave never touch the same neighbor,
+// so the result does not depend on thread timing.
+void ChunkLoader::runInWaves(const std::vector<ivec2> &positions, size_t threads, const std::function<void(size_t)> &fn)
+{
+	std::vector<size_t> waves[9];
+	for (size_t i = 0; i < positions.size(); ++i)
+		waves[mod_floor(positions[i].y, 3) * 3 + mod_floor(positions[i].x, 3)].push_back(i);
+
+	for (const std::vector<size_t> &wave : waves)
+	{
+		std::atomic_size_t next(0);
+		std::vector<std::thread> workers;
+		const size_t count = std::min(std::max(threads, (size_t)1), wave.size());
+		for (size_t t = 0; t < count; ++t)
+			workers.emplace_back([&]() {
+				for (size_t i = next++; i < wave.size(); i = next++)
+					fn(wave[i]);
+			});
+		for (std::thread &worker : workers)
+			worker.join();
+	}
+}
+
+void ChunkLoader::generateChunks(const std::vector<ivec2> &positions, size_t threads)
+{
+	runInWaves(positions, threads, [&](size_t i) { generateChunk(positions[i]); });
+}
+
+bool ChunkLoader::releaseChunk(const ivec2 &pos)
+{
+	return evictChunkAt(pos);
+}
+
 void ChunkLoader::initSpawn()
 {
-	// Load first chunk under the player, and pop their position on top of it
+	// Load the ring under the player, and pop their position on top of it
 	ivec2 chunkPos = _camera.getChunkPosition(CHUNK_SIZE);
 	vec3 worldPos  = _camera.getWorldPosition();
-	// Build the spawn chunk at full resolution so decorative plants
+	// Build the spawn ring at full resolution so decorative plants
 	// (grass/flowers) are present immediately on first load.
 	// Using a coarse LOD here caused sparse or missing flora until
 	// the chunk was later reloaded/refined.
-	Chunk* first = loadChunk(0, 0, 0, chunkPos, RESOLUTION);
-	if (first) {
-		// Build faces immediately and push a synchronous display build so first frame has geometry
-		first->sendFacesToDisplay();
-		updateFillData();
-		// No refinement needed: loaded at full RESOLUTION.
+	std::vector<ivec2> ring;
+	for (int dz = -SPAWN_RING_RADIUS; dz <= SPAWN_RING_RADIUS; ++dz)
+		for (int dx = -SPAWN_RING_RADIUS; dx <= SPAWN_RING_RADIUS; ++dx)
+			ring.push_back(chunkPos + ivec2(dx, dz));
+
+	// Generate in waves, as ft_vox_pregen does, so the spawn area matches a
+	// pregenerated one. Then link and apply spilled trees serially, then mesh
+	// in parallel: each chunk is meshed once, with its whole ring present
+	const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+	std::vector<Chunk *> chunks(ring.size(), nullptr);
+	runInWaves(ring, threads, [&](size_t i) { chunks[i] = createChunk(ring[i], RESOLUTION, false, /*link=*/false); });
+	for (size_t i = 0; i < ring.size(); ++i)
+	{
+		if (chunks[i])
+			chunks[i]->linkNeighbors();
+		applyPendingFor(ring[i]);
 	}
+	std::atomic_size_t next(0);
+	std::vector<std::thread> workers;
+	for (size_t t = 0; t < std::min(ring.size(), threads); ++t)
+		workers.emplace_back([&]() {
+			for (size_t i = next++; i < ring.size(); i = next++)
+				if (chunks[i] && !chunks[i]->isReady())
+					chunks[i]->sendFacesToDisplay();
+		});
+	for (std::thread &worker : workers)
+		worker.join();
+
+	// Display the ring
+	for (const ivec2 &pos : ring)
+		loadChunk(0, 0, 0, pos, RESOLUTION);
+	// Push a synchronous display build so first frame has geometry
+	updateFillData();
+
 	TopBlock topBlock = findTopBlockY(chunkPos, {worldPos.x, worldPos.z});
 	const vec3 &camPos = _camera.getPosition();
 
@@ -103,15 +218,11 @@ void ChunkLoader::initSpawn()
 // Edits (queue if chunk not ready)
 bool ChunkLoader::setBlockOrQueue(ivec2 chunkPos, ivec3 worldPos, BlockType value, bool byPlayer) {
 	auto chunk = getChunk(chunkPos);
-	if (!chunk) {
-		std::lock_guard<std::mutex> lk(_pendingMutex);
-		_pendingEdits[chunkPos].push_back({worldPos, value, byPlayer});
-		return false;
-	}
-
-	if (chunk->isBuilding()) {
+	if (!chunk || chunk->isBuilding()) {
+		if (worldPos.y < 0 || worldPos.y >= kPendingMaxY)
+			return false;
 		std::lock_guard<std::mutex> lk(_pendingMutex);
-		_pendingEdits[chunkPos].push_back({worldPos, value, byPlayer});
+		_pendingEdits[chunkPos].push_back(packPending(worldPos, value, byPlayer));
 		return false;
 	}
 
@@ -120,30 +231,305 @@ bool ChunkLoader::setBlockOrQueue(ivec2 chunkPos, ivec3 worldPos, BlockType valu
 
 // Edits (queue if chunk not ready)
 void ChunkLoader::applyPendingFor(const ivec2& pos) {
-	std::vector<PendingBlock> edits;
+	// Pinned: the regions run without any loader lock held
+	Chunk *chunk = pinChunk(pos);
+	std::vector<uint32_t> edits;
+	std::vector<PendingRegion> regions;
 	{
 		std::lock_guard<std::mutex> lk(_pendingMutex);
+		auto rit = _pendingRegions.find(pos);
+		if (rit != _pendingRegions.end()) {
+			// Regions need every cell stored: keep everything queued, in
+			// order, until the chunk is loaded at full resolution
+			if (!chunk || chunk->isBuilding() || chunk->getResolution() != 1) {
+				if (chunk) chunk->unpin();
+				return;
+			}
+			regions.swap(rit->second);
+			_pendingRegions.erase(rit);
+		}
 		auto it = _pendingEdits.find(pos);
 		if (it != _pendingEdits.end()) {
 			edits.swap(it->second);
 			_pendingEdits.erase(it);
 		}
 	}
-	if (edits.empty()) return;
+	if (edits.empty() && regions.empty()) {
+		if (chunk) chunk->unpin();
+		return;
+	}
 
-	bool anyPlayerEdit = false;
-	for (const auto& e : edits) {
-		setBlock(pos, e.worldPos, e.value, e.byPlayer);
-		anyPlayerEdit = anyPlayerEdit || e.byPlayer;
+	// Cell edits queued in [next, upTo): world spills first, so queued
+	// player edits keep the last word
+	size_t next = 0;
+	auto commitCells = [&](size_t upTo) {
+		EditBatch worldBatch;
+		EditBatch playerBatch;
+		worldBatch.byPlayer = false;
+		for (; next < upTo && next < edits.size(); ++next) {
+			const uint32_t e = edits[next];
+			EditBatch &batch = ((e >> 30) & 1u) ? playerBatch : worldBatch;
+			batch.set(unpackPendingPos(e, pos), (BlockType)(uint8_t)(e >> 22));
+		}
+		commitEdits(worldBatch);
+		commitEdits(playerBatch);
+	};
+
+	RemeshSet remesh;
+	for (const PendingRegion &region : regions) {
+		commitCells(region.after);
+		size_t changed = 0;
+		for (int sy = floor_div(region.mn.y, CHUNK_SIZE); sy <= floor_div(region.mx.y, CHUNK_SIZE); ++sy) {
+			const ivec3 base(pos.x * CHUNK_SIZE, sy * CHUNK_SIZE, pos.y * CHUNK_SIZE);
+			const ivec3 lmin = glm::max(region.mn - base, ivec3(0));
+			const ivec3 lmax = glm::min(region.mx - base, ivec3(CHUNK_SIZE - 1));
+			const size_t n = editSubChunkRegion(chunk, sy, lmin, lmax, *region.op, true);
+			if (n == 0)
+				continue;
+			changed += n;
+			addRegionRemesh(remesh, pos, sy, lmin, lmax);
+		}
+		if (changed && region.byPlayer)
+			markChunkModified(chunk);
 	}
+	commitCells(edits.size());
+	remeshSubChunks(remesh);
+	if (chunk) chunk->unpin();
+}
+
+bool ChunkLoader::acceptsRegionEdits(Chunk *chunk, const ivec2 &cpos)
+{
+	if (!chunk || chunk->isBuilding() || chunk->getResolution() != 1)
+		return false;
+	std::lock_guard<std::mutex> lk(_pendingMutex);
+	return _pendingRegions.find(cpos) == _pendingRegions.end();
+}
 
-	if (anyPlayerEdit) {
-		if (auto c = getChunk(pos)) {
-			if (!c->getModified()) { c->setAsModified(); ++_modifiedCount; }
-			c->sendFacesToDisplay();
+void ChunkLoader::queueRegion(const ivec2 &cpos, const glm::ivec3 &mn, const glm::ivec3 &mx,
+							  const std::shared_ptr<const EditCellOp> &op, bool byPlayer)
+{
+	std::lock_guard<std::mutex> lk(_pendingMutex);
+	auto it = _pendingEdits.find(cpos);
+	const size_t after = (it != _pendingEdits.end()) ? it->second.size() : 0;
+	_pendingRegions[cpos].push_back({mn, mx, op, byPlayer, after});
+}
+
+size_t ChunkLoader::editSubChunkRegion(Chunk *chunk, int subY, const glm::ivec3 &lmin, const glm::ivec3 &lmax,
+									   const EditCellOp &op, bool writes)
+{
+	const ivec3 base(chunk->getPosition().x * CHUNK_SIZE, subY * CHUNK_SIZE, chunk->getPosition().y * CHUNK_SIZE);
+	SubChunk *sc = chunk->getSubChunk(subY);
+	if (!sc)
+	{
+		if (!writes)
+			return 0;
+		// Only allocate an empty subchunk if the op puts something in it
+		bool needed = false;
+		for (int y = lmin.y; !needed && y <= lmax.y; ++y)
+		for (int z = lmin.z; !needed && z <= lmax.z; ++z)
+		for (int x = lmin.x; !needed && x <= lmax.x; ++x)
+		{
+			char out = AIR;
+			needed = op(base + ivec3(x, y, z), AIR, out) && out != AIR;
 		}
+		if (!needed)
+			return 0;
+		sc = chunk->getOrCreateSubChunk(subY, /*generate=*/false);
+		if (!sc)
+			return 0;
 	}
-	updateFillData();
+	return sc->editRegion(lmin, lmax, [&](const ivec3 &local, char current) {
+		char out = current;
+		return op(base + local, current, out) ? out : current;
+	});
+}
+
+void ChunkLoader::addRegionRemesh(RemeshSet &remesh, const ivec2 &cpos, int subY,
+								  const glm::ivec3 &lmin, const glm::ivec3 &lmax)
+{
+	remesh[cpos].insert(subY);
+	if (lmin.x == 0)				remesh[cpos + ivec2(-1, 0)].insert(subY);
+	if (lmax.x == CHUNK_SIZE - 1)	remesh[cpos + ivec2( 1, 0)].insert(subY);
+	if (lmin.z == 0)				remesh[cpos + ivec2(0, -1)].insert(subY);
+	if (lmax.z == CHUNK_SIZE - 1)	remesh[cpos + ivec2(0,  1)].insert(subY);
+	if (lmin.y == 0)				remesh[cpos].insert(subY - 1);
+	if (lmax.y == CHUNK_SIZE - 1)	remesh[cpos].insert(subY + 1);
+}
+
+size_t ChunkLoader::commitEdits(const EditBatch &batch)
+{
+	if (batch.empty())
+		return 0;
+
+	struct Keyed {
+		ivec2		chunk;
+		int			subY;
+		uint32_t	cell;	// SubChunk::packCell
+		uint32_t	order;
+	};
+	std::vector<Keyed> keyed;
+	keyed.reserve(batch.size());
+	for (size_t i = 0; i < batch.edits.size(); ++i) {
+		const ivec3 &w = batch.edits[i].worldPos;
+		keyed.push_back({
+			ivec2(floor_div(w.x, CHUNK_SIZE), floor_div(w.z, CHUNK_SIZE)),
+			floor_div(w.y, CHUNK_SIZE),
+			SubChunk::packCell(mod_floor(w.x, CHUNK_SIZE), mod_floor(w.y, CHUNK_SIZE), mod_floor(w.z, CHUNK_SIZE), batch.edits[i].value),
+			(uint32_t)i});
+	}
+	std::sort(keyed.begin(), keyed.end(), [](const Keyed &a, const Keyed &b) {
+		return std::tie(a.chunk.x, a.chunk.y, a.subY, a.order) < std::tie(b.chunk.x, b.chunk.y, b.subY, b.order);
+	});
+
+	// Subchunks to remesh per chunk: touched ones plus the ones across a touched border
+	RemeshSet remesh;
+	std::vector<uint32_t> cells;
+	size_t applied = 0;
+	size_t i = 0;
+	while (i < keyed.size()) {
+		const ivec2 cpos = keyed[i].chunk;
+		size_t chunkEnd = i;
+		while (chunkEnd < keyed.size() && keyed[chunkEnd].chunk == cpos)
+			++chunkEnd;
+
+		// Pinned while its subchunks are written
+		Chunk *chunk = pinChunk(cpos);
+		std::unique_lock<std::mutex> pendingLock(_pendingMutex);
+		// Behind a parked region: queue too so the replay keeps the order
+		if (!chunk || chunk->isBuilding() || _pendingRegions.count(cpos)) {
+			if (chunk) chunk->unpin();
+			auto &pending = _pendingEdits[cpos];
+			for (; i < chunkEnd; ++i) {
+				const Keyed &k = keyed[i];
+				const ivec3 w(cpos.x * CHUNK_SIZE + (int)(k.cell & 31u),
+							  k.subY * CHUNK_SIZE + (int)((k.cell >> 5) & 31u),
+							  cpos.y * CHUNK_SIZE + (int)((k.cell >> 10) & 31u));
+				// In range: EditBatch::set refused the rest
+				pending.push_back(packPending(w, (BlockType)(uint8_t)(k.cell >> 15), batch.byPlayer));
+			}
+			continue;
+		}
+		pendingLock.unlock();
+
+		while (i < chunkEnd) {
+			const int subY = keyed[i].subY;
+			bool border[6] = {false, false, false, false, false, false};
+			cells.clear();
+			for (; i < chunkEnd && keyed[i].subY == subY; ++i) {
+				const uint32_t c = keyed[i].cell;
+				const int lx = (int)(c & 31u);
+				const int ly = (int)((c >> 5) & 31u);
+				const int lz = (int)((c >> 10) & 31u);
+				border[0] |= (lx == 0);
+				border[1] |= (lx == CHUNK_SIZE - 1);
+				border[2] |= (lz == 0);
+				border[3] |= (lz == CHUNK_SIZE - 1);
+				border[4] |= (ly == 0);
+				border[5] |= (ly == CHUNK_SIZE - 1);
+				cells.push_back(c);
+			}
+			SubChunk *sc = chunk->getOrCreateSubChunk(subY, /*generate=*/false);
+			if (!sc)
+				continue;
+			sc->setBlocksLocal(cells.data(), cells.size());
+			applied += cells.size();
+
+			remesh[cpos].insert(subY);
+			if (border[0]) remesh[cpos + ivec2(-1, 0)].insert(subY);
+			if (border[1]) remesh[cpos + ivec2( 1, 0)].insert(subY);
+			if (border[2]) remesh[cpos + ivec2(0, -1)].insert(subY);
+			if (border[3]) remesh[cpos + ivec2(0,  1)].insert(subY);
+			if (border[4]) remesh[cpos].insert(subY - 1);
+			if (border[5]) remesh[cpos].insert(subY + 1);
+		}
+		if (batch.byPlayer)
+			markChunkModified(chunk);
+		chunk->unpin();
+	}
+
+	remeshSubChunks(remesh);
+	return applied;
+}
+
+void ChunkLoader::markChunkModified(Chunk *chunk)
+{
+	if (chunk && !chunk->getModified()) { chunk->setAsModified(); ++_modifiedCount; }
+}
+
+// Exactly one remesh per affected chunk, limited to the affected subchunks.
+// Chunks without a mesh yet are built in full when they get displayed.
+void ChunkLoader::remeshSubChunks(const RemeshSet &remesh, ThreadPool *pool)
+{
+	std::vector<std::future<void>> jobs;
+	std::vector<Chunk *> pinned;
+	bool remeshed = false;
+	for (auto &kv : remesh) {
+		Chunk *c = pinChunk(kv.first);
+		if (!c)
+			continue;
+		pinned.push_back(c);
+		if (!c->isReady())
+			continue;
+		const std::unordered_set<int> *subYs = &kv.second;
+		if (pool)
+			jobs.emplace_back(pool->enqueue([c, subYs]() { c->sendFacesToDisplay(subYs); }));
+		else
+			c->sendFacesToDisplay(subYs);
+		remeshed = true;
+	}
+	for (auto &job : jobs)
+		job.get();
+	for (Chunk *c : pinned)
+		c->unpin();
+	if (remeshed)
+		scheduleDisplayUpdate();
+}
+
+// Generate a chunk into the cache (not displayed). Returns the cached
+// instance if another thread inserted it first.
+Chunk *ChunkLoader::createChunk(ivec2 pos, int resolution, bool headless, bool link)
+{
+	// Read before taking any lock: a region hit skips all voxel generation
+	StoredChunk stored;
+	const bool fromStore = !headless && resolution == 1 && _regions.load(pos, stored);
+
+	PerlinMap *pMap = _perlinGenerator.getPerlinMap(pos, resolution);
+	Chunk *newChunk = new Chunk(pos, pMap, _caveGen, *this, _threadPool, resolution);
+
+	Chunk *chunk = nullptr;
+	bool inserted = false;
+	{
+		std::lock_guard<std::mutex> lk(_chunksMutex);
+		auto [it, didInsert] = _chunks.emplace(pos, newChunk);
+		if (didInsert)
+		{
+			chunk = newChunk;
+			inserted = true;
+		}
+		else
+		{
+			chunk = it->second;
+		}
+	}
+
+	if (!inserted)
+	{
+		delete newChunk;
+		return chunk;
+	}
+	// Heavy init outside the map lock so neighbors created later can find us.
+	if (fromStore)
+		chunk->loadStored(stored);
+	else
+		chunk->loadBlocks();
+	if (!headless && link)
+		chunk->getNeighbors();
+
+	// Insert into LRU as most-recent entry
+	touchLRU(pos);
+	++_chunksCount;
+	applyPendingFor(pos);
+	return chunk;
 }
 
 // Single chunk loader
@@ -169,42 +555,7 @@ Chunk *ChunkLoader::loadChunk(int x, int z, int render, const ivec2 &chunkPos, i
 		touchLRU(pos);
 	}
 	else
-	{
-		PerlinMap *pMap = _perlinGenerator.getPerlinMap(pos, resolution);
-		Chunk *newChunk = new Chunk(pos, pMap, _caveGen, *this, _threadPool, resolution);
-
-		bool inserted = false;
-		{
-			std::lock_guard<std::mutex> lk(_chunksMutex);
-			auto [it, didInsert] = _chunks.emplace(pos, newChunk);
-			if (didInsert)
-			{
-				chunk = newChunk;
-				inserted = true;
-			}
-			else
-			{
-				chunk = it->second;
-			}
-		}
-
-		if (!inserted)
-		{
-			delete newChunk;
-		}
-		else
-		{
-			// Heavy init outside the map lock so neighbors created later can find us.
-			chunk->loadBlocks();
-			chunk->getNeighbors();
-
-			_chunksMemoryUsage.fetch_add(chunk->getMemorySize(), std::memory_order_relaxed);
-			// Insert into LRU as most-recent entry
-			touchLRU(pos);
-			++_chunksCount;
-			applyPendingFor(pos);
-		}
-	}
+		chunk = createChunk(pos, resolution);
 
 	bool displayInserted = false;
 	{
@@ -217,20 +568,25 @@ Chunk *ChunkLoader::loadChunk(int x, int z, int render, const ivec2 &chunkPos, i
 		}
 	}
 
-	// If this chunk just became displayed again (from cache), refresh its flowers
+	// If this chunk just became displayed again (from cache), restage its flowers
 	if (displayInserted) {
-		rescanFlowersForChunk(pos);
+		restageFlowersForChunk(pos);
 	}
 
-	// Ensure a freshly created chunk becomes visible: build its mesh once
-	// and coalesce a display update. Skip if already meshed.
+	// Back to the hot tier before anything reads it
+	if (displayInserted && chunk)
+		chunk->thawBlocks();
+
+	// Ensure a freshly created chunk becomes visible: unpack its cached mesh
+	// or build it once, and coalesce a display update. Skip if already meshed.
 	if (chunk && !chunk->isReady()) {
-		chunk->sendFacesToDisplay();
+		if (!chunk->restorePackedMesh())
+			chunk->sendFacesToDisplay();
 		scheduleDisplayUpdate();
 	}
 
-	// Enforce chunk count budget after any load
-	enforceCountBudget();
+	// Enforce memory budgets after any load
+	enforceMemoryBudget();
 	// unloadChunk();
 	return chunk;
 }
@@ -241,10 +597,9 @@ void ChunkLoader::loadChunks(ivec2 chunkPos) {
 		return;
 
 	const int renderDistance = _renderDistance.load(std::memory_order_relaxed);
-	const int baseResolution = RESOLUTION;
 	_threshold = std::numeric_limits<int>::max();
 
-	const int maxRadius = std::max(0, (renderDistance - 1) / 2);
+	const int maxRadius = std::min(std::max(0, (renderDistance - 1) / 2), enforceGpuBudget(std::max(0, (renderDistance - 1) / 2)));
 
 	struct CandidateInfo {
 		glm::ivec2 offset;
@@ -275,6 +630,8 @@ void ChunkLoader::loadChunks(ivec2 chunkPos) {
 	};
 
 	const float fallbackCos = std::cos(glm::radians(70.0f));
+	// Chunks covered below their LOD target, refined once the ring is covered
+	std::vector<glm::ivec2> refine;
 
 	while (remaining > 0 && getIsRunning()) {
 		Frustum localFrustum;
@@ -359,21 +716,17 @@ void ChunkLoader::loadChunks(ivec2 chunkPos) {
 			break;
 
 		const CandidateInfo &chosen = candidates[bestIndex];
-		int chunkResolution = baseResolution;
-		int thresholdStep = LOD_THRESHOLD;
-		while ((std::abs(chosen.offset.x) >= thresholdStep || std::abs(chosen.offset.y) >= thresholdStep) && chunkResolution < CHUNK_SIZE) {
-			chunkResolution = std::min(CHUNK_SIZE, chunkResolution * 2);
-			if (thresholdStep > std::numeric_limits<int>::max() / 2) {
-				thresholdStep = std::numeric_limits<int>::max();
-				break;
-			}
-			thresholdStep *= 2;
-			if (thresholdStep <= 0) {
-				thresholdStep = std::numeric_limits<int>::max();
-				break;
-			}
-		}
-		loadChunk(chosen.offset.x, chosen.offset.y, 0, chunkPos, chunkResolution);
+		int chunkResolution = lodResolutionFor(chosen.offset);
+		// Cover first: far fewer voxels to generate and mesh at the coarse LOD.
+		// Cached chunks keep their finer data (loadChunk never coarsens).
+		// Pregenerated chunks are only a read away: no coarse pass for them.
+		int coverResolution = chunkResolution;
+		if (chosen.radius > PROGRESSIVE_FULL_RADIUS
+			&& !(chunkResolution == 1 && _regions.has(chunkPos + chosen.offset)))
+			coverResolution = std::max(chunkResolution, std::min(PROGRESSIVE_COARSE_RES, CHUNK_SIZE));
+		Chunk *loaded = loadChunk(chosen.offset.x, chosen.offset.y, 0, chunkPos, coverResolution);
+		if (loaded && loaded->getResolution() > chunkResolution)
+			refine.push_back(chosen.offset);
 		processed[bestIndex] = 1;
 		--remaining;
 		maxRadiusLoaded = std::max(maxRadiusLoaded, chosen.radius);
@@ -389,6 +742,11 @@ void ChunkLoader::loadChunks(ivec2 chunkPos) {
 	if (batchCounter > 0)
 		enqueueUpdate();
 
+	// Ring covered: bring detail back, then spend the idle time on the predicted path
+	const bool refined = remaining == 0 && refineChunks(chunkPos, refine);
+	if (refined && getIsRunning())
+		prefetchAlongPath(chunkPos, maxRadius);
+
 	for (auto &ret : retLst) {
 		while (ret.wait_for(std::chrono::milliseconds(10)) == std::future_status::timeout) {
 			if (!getIsRunning())
@@ -397,11 +755,85 @@ void ChunkLoader::loadChunks(ivec2 chunkPos) {
 	}
 }
 
+// Refine chunks loaded at the coarse LOD towards their target resolution.
+// Works in slices of REFINE_BUDGET_MS, re-sorted each slice (visible first,
+// then nearest) and paced to one slice per REFINE_FRAME_MS so the coarse
+// world stays responsive while detail fills in. Returns false when the camera
+// changed chunk first: the next pass re-covers and re-queues what is left.
+bool ChunkLoader::refineChunks(const ivec2 &chunkPos, std::vector<glm::ivec2> &pending)
+{
+	typedef std::chrono::steady_clock clock;
+	const auto budget = std::chrono::milliseconds(REFINE_BUDGET_MS);
+	const auto frame = std::chrono::milliseconds(REFINE_FRAME_MS);
+
+	struct Entry {
+		glm::ivec2	offset;
+		bool		visible;
+		float		distance2;
+	};
+	std::vector<Entry> order;
+	_refinePending = static_cast<int>(pending.size());
+	while (!pending.empty() && getIsRunning())
+	{
+		if (hasMoved(chunkPos))
+			break;
+		const auto sliceStart = clock::now();
+
+		Frustum localFrustum;
+		bool hasFrustum = false;
+		{
+			std::lock_guard<std::mutex> lk(_frustumMutex);
+			if (_hasCachedFrustum) {
+				localFrustum = _cachedFrustum;
+				hasFrustum = true;
+			}
+		}
+		const glm::vec3 cam = _camera.getWorldPosition();
+		order.clear();
+		for (const glm::ivec2 &offset : pending)
+		{
+			const glm::ivec2 chunkCoord = chunkPos + offset;
+			const glm::vec3 aabbMin(chunkCoord.x * CHUNK_SIZE, -2048.0f, chunkCoord.y * CHUNK_SIZE);
+			const glm::vec3 aabbMax = aabbMin + glm::vec3(CHUNK_SIZE, 4096.0f, CHUNK_SIZE);
+			const glm::vec2 toCenter(aabbMin.x + CHUNK_SIZE * 0.5f - cam.x, aabbMin.z + CHUNK_SIZE * 0.5f - cam.z);
+			const bool visible = !hasFrustum || localFrustum.aabbVisible(aabbMin, aabbMax);
+			order.push_back({offset, visible, glm::dot(toCenter, toCenter)});
+		}
+		std::sort(order.begin(), order.end(), [](const Entry &a, const Entry &b) {
+			if (a.visible != b.visible) return a.visible;
+			return a.distance2 < b.distance2;
+		});
+
+		// At least one chunk per slice, even if it alone overruns the budget
+		size_t done = 0;
+		while (done < order.size() && getIsRunning())
+		{
+			const glm::ivec2 offset = order[done++].offset;
+			loadChunk(offset.x, offset.y, 0, chunkPos, lodResolutionFor(offset));
+			if (clock::now() - sliceStart >= budget)
+				break;
+		}
+		pending.clear();
+		for (size_t i = done; i < order.size(); ++i)
+			pending.push_back(order[i].offset);
+		_refinePending = static_cast<int>(pending.size());
+		scheduleDisplayUpdate();
+
+		const auto spent = clock::now() - sliceStart;
+		if (!pending.empty() && spent < frame)
+			std::this_thread::sleep_for(frame - spent);
+	}
+	return pending.empty();
+}
+
 void ChunkLoader::unloadChunks(ivec2 newCamChunk)
 {
 	// make sure queued edits + dirty meshes are up-to-date
 	flushDirtyChunks();
 
+	// Render distance, or the ring the GPU budget pulled the display back to
+	const int keepRadius = std::min(_renderDistance.load(std::memory_order_relaxed) / 2,
+									_gpuRadiusCap.load(std::memory_order_relaxed));
 	std::vector<ivec2> toErase;
 	{
 		std::lock_guard<std::mutex> lk(_displayedChunksMutex);
@@ -412,8 +844,8 @@ void ChunkLoader::unloadChunks(ivec2 newCamChunk)
 			Chunk *chunk = kv.second;
 			if (!chunk) continue;
 			ivec2 chunkPos = chunk->getPosition();
-			if (std::abs(chunkPos.x - newCamChunk.x) > _renderDistance.load(std::memory_order_relaxed) / 2
-				|| std::abs(chunkPos.y - newCamChunk.y) > _renderDistance.load(std::memory_order_relaxed) / 2)
+			if (std::abs(chunkPos.x - newCamChunk.x) > keepRadius
+				|| std::abs(chunkPos.y - newCamChunk.y) > keepRadius)
 			{
 				toErase.push_back(kv.first);
 			}
@@ -427,13 +859,85 @@ void ChunkLoader::unloadChunks(ivec2 newCamChunk)
 				_displayedChunks.erase(it2);
 				--_displayedCount;
 			}
-			// Allow re-scan of flowers when this chunk becomes displayed again
-			clearFlowerScanMarksFor(key);
+			// Release its flower instances until it becomes displayed again
+			dropFlowersForChunk(key);
+		}
+	}
+	// Cached chunks keep their mesh packed until redisplayed (loads run
+	// before unloads on the same task, nothing re-displays them meanwhile)
+	if (PACK_CACHED_MESHES) {
+		for (const auto& key : toErase) {
+			{
+				std::lock_guard<std::mutex> lk(_displayedChunksMutex);
+				if (_displayedChunks.count(key))
+					continue;
+			}
+			if (Chunk *c = getChunk(key))
+				c->releaseMeshData();
 		}
 	}
+	if (COLD_VOXEL_TIER)
+		scheduleColdTier(toErase);
 	updateFillData();
 	// After display set shrinks, re-check cache pressure
-	enforceCountBudget();
+	enforceMemoryBudget();
+}
+
+void ChunkLoader::scheduleColdTier(const std::vector<ivec2> &positions)
+{
+	if (positions.empty())
+		return;
+	std::lock_guard<std::mutex> lk(_coldMutex);
+	_coldQueue.insert(_coldQueue.end(), positions.begin(), positions.end());
+	if (_coldScheduled)
+		return;
+	_coldScheduled = true;
+	_coldJob = _threadPool.enqueue(&ChunkLoader::compressColdChunks, this);
+}
+
+void ChunkLoader::compressColdChunks()
+{
+	for (;;)
+	{
+		ivec2 pos;
+		{
+			std::lock_guard<std::mutex> lk(_coldMutex);
+			if (_coldQueue.empty() || !getIsRunning()) {
+				_coldQueue.clear();
+				_coldScheduled = false;
+				return;
+			}
+			pos = _coldQueue.back();
+			_coldQueue.pop_back();
+		}
+		{
+			// Displayed again since it was queued
+			std::lock_guard<std::mutex> dk(_displayedChunksMutex);
+			if (_displayedChunks.count(pos))
+				continue;
+		}
+		// Pinned without touching the LRU: eviction skips it meanwhile
+		Chunk *chunk = nullptr;
+		{
+			std::lock_guard<std::mutex> ck(_chunksMutex);
+			auto it = _chunks.find(pos);
+			if (it != _chunks.end()) chunk = it->second;
+			if (chunk) chunk->pin();
+		}
+		if (!chunk)
+			continue;
+		chunk->freezeBlocks();
+		// loadChunk may have re-displayed and thawed it while we froze:
+		// thaw again so a displayed chunk never stays cold
+		bool displayed;
+		{
+			std::lock_guard<std::mutex> dk(_displayedChunksMutex);
+			displayed = _displayedChunks.count(pos) != 0;
+		}
+		if (displayed)
+			chunk->thawBlocks();
+		chunk->unpin();
+	}
 }
 
 // Check if player moved
@@ -448,6 +952,108 @@ bool ChunkLoader::hasMoved(const ivec2 &oldPos)
 	return (std::max(dx, dz) > 1);
 }
 
+// Chunks ahead of the camera along its smoothed velocity, outside the visible
+// ring, ordered by arrival time. They are generated into the cache only, so
+// loadChunk finds them ready once the ring moves over them.
+void ChunkLoader::prefetchAlongPath(ivec2 chunkPos, int maxRadius)
+{
+	glm::vec3 vel = _camera.getVelocity();
+	glm::vec2 vel2D(vel.x, vel.z);
+	float speed = glm::length(vel2D);
+	if (speed < PREFETCH_MIN_SPEED)
+		return;
+	glm::vec2 dir = vel2D / speed;
+	glm::vec2 side(-dir.y, dir.x);
+	glm::vec3 cam = _camera.getWorldPosition();
+	glm::vec2 origin(cam.x, cam.z);
+	const float reach = speed * PREFETCH_LOOKAHEAD_SEC;
+	const float cs = static_cast<float>(CHUNK_SIZE);
+
+	std::vector<ivec2> path;
+	std::unordered_set<ivec2, ivec2_hash> seen;
+	for (float t = 0.0f; t <= reach && path.size() < PREFETCH_MAX_CHUNKS; t += cs * 0.5f) {
+		for (int b = -PREFETCH_BAND; b <= PREFETCH_BAND && path.size() < PREFETCH_MAX_CHUNKS; ++b) {
+			glm::vec2 p = origin + dir * t + side * (static_cast<float>(b) * cs);
+			ivec2 c(static_cast<int>(std::floor(p.x / cs)), static_cast<int>(std::floor(p.y / cs)));
+			ivec2 off = c - chunkPos;
+			// The visible ring is loadChunks' job
+			if (std::max(std::abs(off.x), std::abs(off.y)) <= maxRadius)
+				continue;
+			if (seen.insert(c).second)
+				path.push_back(c);
+		}
+	}
+
+	// Chunks first appear on the ring edge: generate them at that LOD
+	const int resolution = lodResolutionFor(ivec2(maxRadius, 0));
+	for (const ivec2 &c : path) {
+		if (!getIsRunning() || prefetchTrajectoryChanged(chunkPos, dir)) {
+			++_prefetchCancelled;
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lk(_chunksMutex);
+			if (_chunks.count(c))
+				continue;
+		}
+		createChunk(c, resolution);
+		++_prefetchedCount;
+		enforceMemoryBudget();
+	}
+}
+
+// A band is stale once the camera left its load center (visible chunks take
+// over again) or the heading turned away from the planned direction.
+bool ChunkLoader::prefetchTrajectoryChanged(const ivec2 &chunkPos, const glm::vec2 &plannedDir)
+{
+	if (_camera.getChunkPosition(CHUNK_SIZE) != chunkPos)
+		return true;
+	glm::vec3 vel = _camera.getVelocity();
+	glm::vec2 vel2D(vel.x, vel.z);
+	float speed = glm::length(vel2D);
+	if (speed < PREFETCH_MIN_SPEED * 0.5f)
+		return true;
+	return glm::dot(vel2D / speed, plannedDir) < PREFETCH_CANCEL_COS;
+}
+
+// Count frames where a frustum-visible chunk inside the ring (the outermost,
+// still-streaming ring excluded) is missing or not meshed yet.
+void ChunkLoader::sampleVisibleHoles()
+{
+	Frustum frustum;
+	{
+		std::lock_guard<std::mutex> lk(_frustumMutex);
+		if (!_hasCachedFrustum)
+			return;
+		frustum = _cachedFrustum;
+	}
+	const int radius = std::max(0, (_renderDistance.load(std::memory_order_relaxed) - 1) / 2) - 1;
+	if (radius < 0)
+		return;
+	const ivec2 center = _camera.getChunkPosition(CHUNK_SIZE);
+
+	std::lock_guard<std::mutex> lk(_displayedChunksMutex);
+	if (_displayedChunks.empty())
+		return;
+	for (int dz = -radius; dz <= radius; ++dz) {
+		for (int dx = -radius; dx <= radius; ++dx) {
+			ivec2 c = center + ivec2(dx, dz);
+			glm::vec3 aabbMin(
+				static_cast<float>(c.x * CHUNK_SIZE),
+				-2048.0f,
+				static_cast<float>(c.y * CHUNK_SIZE));
+			glm::vec3 aabbMax = aabbMin + glm::vec3(CHUNK_SIZE, 4096.0f, CHUNK_SIZE);
+			if (!frustum.aabbVisible(aabbMin, aabbMax))
+				continue;
+			auto it = _displayedChunks.find(c);
+			if (it == _displayedChunks.end() || !it->second || !it->second->isReady()) {
+				++_dbg_holeFrames;
+				return;
+			}
+		}
+	}
+}
+
 // Update data to be rendered
 void ChunkLoader::updateFillData()
 {
@@ -479,6 +1085,9 @@ void ChunkLoader::updateFillData()
 	}
 	else
 	{
+		// Staged copies are released by ChunkRenderer once replaced
+		_memGov.chargeDisplayData(fillData);
+		_memGov.chargeDisplayData(transparentData);
 		std::lock_guard<std::mutex> lk(_sharedDrawDataMutex);
 		_solidStagedDataQueue.emplace(fillData);
 		_transparentStagedDataQueue.emplace(transparentData);
@@ -624,6 +1233,18 @@ Chunk *ChunkLoader::getChunk(const ivec2& pos) {
 	return c;
 }
 
+Chunk *ChunkLoader::pinChunk(const ivec2& pos) {
+	Chunk* c = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(_chunksMutex);
+		auto it = _chunks.find(pos);
+		if (it != _chunks.end()) c = it->second;
+		if (c) c->pin();
+	}
+	if (c) touchLRU(pos);
+	return c;
+}
+
 SubChunk* ChunkLoader::getSubChunk(ivec3 &position) {
 	Chunk* c = nullptr;
 	{
@@ -684,21 +1305,20 @@ TopBlock ChunkLoader::findTopBlockY(ivec2 chunkPos, ivec2 worldPos) {
 }
 
 TopBlock ChunkLoader::findBlockUnderPlayer(ivec2 chunkPos, ivec3 worldPos) {
-	std::lock_guard<std::mutex> lock(_chunksMutex);
-
-	auto it = _chunks.find({chunkPos.x, chunkPos.y});
-	if (it == _chunks.end() || !it->second)
+	// Pinned rather than scanned under _chunksMutex, which streaming workers need
+	Chunk* chunk = pinChunk(chunkPos);
+	if (!chunk)
 		return TopBlock();
 
-	Chunk* chunk = it->second;
-
 	const int localX = mod_floor(worldPos.x, CHUNK_SIZE);
 	const int localZ = mod_floor(worldPos.z, CHUNK_SIZE);
 
 	int startSubY   = floor_div(worldPos.y, CHUNK_SIZE);
 	int startLocalY = mod_floor(worldPos.y, CHUNK_SIZE);
 
-	return chunk->getFirstSolidBelow(localX, startLocalY, localZ, startSubY);
+	const TopBlock top = chunk->getFirstSolidBelow(localX, startLocalY, localZ, startSubY);
+	chunk->unpin();
+	return top;
 }
 
 bool ChunkLoader::getIsRunning() {
@@ -710,20 +1330,29 @@ bool ChunkLoader::getIsRunning() {
 
 void ChunkLoader::snapshotDebugCounters() {
 	// Called from main thread before UI render
-	_dbg_chunksMemoryUsage = _chunksMemoryUsage.load(std::memory_order_relaxed);
+	_memGov.snapshot();
+	_dbg_chunksMemoryUsage = _memGov.usage(MEM_VOXELS);
 	_dbg_renderDistance   = _renderDistance.load(std::memory_order_relaxed);
 	_dbg_currentRender    = _currentRender.load(std::memory_order_relaxed);
 	_dbg_chunksCount      = _chunksCount.load(std::memory_order_relaxed);
 	_dbg_displayedCount   = _displayedCount.load(std::memory_order_relaxed);
 	_dbg_modifiedCount    = _modifiedCount.load(std::memory_order_relaxed);
+	_dbg_prefetchedCount  = _prefetchedCount.load(std::memory_order_relaxed);
+	_dbg_prefetchCancelled = _prefetchCancelled.load(std::memory_order_relaxed);
+	_dbg_refinePending    = _refinePending.load(std::memory_order_relaxed);
 }
 
 int *ChunkLoader::getCurrentRenderPtr() { return &_dbg_currentRender; }
 size_t *ChunkLoader::getMemorySizePtr() { return &_dbg_chunksMemoryUsage; }
+MemoryGovernor &ChunkLoader::getMemoryGovernor() { return _memGov; }
 int *ChunkLoader::getRenderDistancePtr() { return &_dbg_renderDistance; }
 int *ChunkLoader::getCachedChunksCountPtr() { return &_dbg_chunksCount; }
 int *ChunkLoader::getDisplayedChunksCountPtr() { return &_dbg_displayedCount; }
 int *ChunkLoader::getModifiedChunksCountPtr() { return &_dbg_modifiedCount; }
+int *ChunkLoader::getPrefetchedChunksCountPtr() { return &_dbg_prefetchedCount; }
+int *ChunkLoader::getPrefetchCancelledCountPtr() { return &_dbg_prefetchCancelled; }
+int *ChunkLoader::getRefinePendingPtr() { return &_dbg_refinePending; }
+int *ChunkLoader::getHoleFramesPtr() { return &_dbg_holeFrames; }
 NoiseGenerator &ChunkLoader::getNoiseGenerator() { return _perlinGenerator; }
 
 void ChunkLoader::printSizes() const
@@ -781,9 +1410,12 @@ void ChunkLoader::touchLRU(const ivec2& pos) {
 	}
 }
 
-void ChunkLoader::enforceCountBudget() {
-	// Dynamic budget: visible grid + slack + modified chunks (non-evictable)
-	int renderCells = _renderDistance.load(std::memory_order_relaxed) * _renderDistance.load(std::memory_order_relaxed);
+void ChunkLoader::enforceMemoryBudget() {
+	// Nothing to do while every category fits and the total is under the cap
+	const MemoryCategory worst = _memGov.mostOverBudget();
+	if (worst == MEM_CATEGORY_COUNT && !_memGov.overHardCap())
+		return;
+
 	std::vector<std::pair<ivec2,int>> candidates; // pos, distance
 	candidates.reserve(_chunks.size());
 
@@ -797,17 +1429,14 @@ void ChunkLoader::enforceCountBudget() {
 		for (auto &kv : _displayedChunks) displayedSnapshot.insert(kv.first);
 	}
 
-	int modifiedCount = 0;
 	{
 		std::lock_guard<std::mutex> ck(_chunksMutex);
 		for (auto &kv : _chunks) {
 			Chunk* c = kv.second;
 			if (!c) continue;
-			if (c->getModified()) {
-				++modifiedCount;
-				continue; // never evict modified
-			}
-			// Prefer to only evict non-displayed chunks
+			if (c->getModified() || c->isPinned())
+				continue; // never evict modified or in use by a query
+			// Only evict non-displayed chunks
 			if (displayedSnapshot.find(kv.first) != displayedSnapshot.end())
 				continue;
 			// Chebyshev distance on chunk grid
@@ -817,19 +1446,47 @@ void ChunkLoader::enforceCountBudget() {
 			candidates.emplace_back(kv.first, dist);
 		}
 	}
+	if (candidates.empty())
+		return;
 
-	const int requiredBudget = renderCells + _countBudget + modifiedCount;
-	if (_chunksCount <= requiredBudget) return;
-
-	// Evict farthest first
+	// Farthest first
 	std::sort(candidates.begin(), candidates.end(), [](auto &a, auto &b){ return a.second > b.second; });
 
+	// Meshes of cached chunks are rebuilt on redisplay: strip them before
+	// dropping voxel data when meshes are the category over budget.
+	if (worst == MEM_MESHES) {
+		for (auto &cand : candidates) {
+			if (!_memGov.overBudget(MEM_MESHES)) break;
+			Chunk *c = getChunk(cand.first);
+			if (c) c->releaseMeshData();
+		}
+	}
+
+	// Voxels and noise maps only go away with their chunk
 	for (auto &cand : candidates) {
-		if (_chunksCount <= requiredBudget) break;
+		if (!_memGov.overBudget(MEM_VOXELS) && !_memGov.overBudget(MEM_NOISE)
+			&& !_memGov.overBudget(MEM_MESHES) && !_memGov.overHardCap())
+			break;
 		evictChunkAt(cand.first);
 	}
 }
 
+// GPU bytes only shrink with the displayed set, evicting cached chunks frees
+// none: pull the display radius in one ring per call while the GPU budget is
+// exceeded, widen it one ring once usage is back under the regrow share.
+// Returns the radius the caller may display.
+int ChunkLoader::enforceGpuBudget(int maxRadius) {
+	int cap = std::min(_gpuRadiusCap.load(std::memory_order_relaxed), maxRadius);
+	if (_memGov.overGpuBudget())
+		cap = std::max(std::min(GPU_BUDGET_MIN_RADIUS, maxRadius), cap - 1);
+	else if (cap < maxRadius
+		&& _memGov.usage(MEM_GPU) < _memGov.budget(MEM_GPU) / 100 * GPU_BUDGET_REGROW_PERCENT
+		&& _memGov.usage(MEM_FLOWERS) < _memGov.budget(MEM_FLOWERS) / 100 * GPU_BUDGET_REGROW_PERCENT)
+		++cap;
+	_gpuRadiusCap = (cap >= maxRadius) ? std::numeric_limits<int>::max() : cap;
+	return cap;
+}
+
 bool ChunkLoader::evictChunkAt(const ivec2& candidate) {
 	// Lookup the chunk
 	Chunk* chunk = nullptr;
@@ -850,6 +1507,22 @@ bool ChunkLoader::evictChunkAt(const ivec2& candidate) {
 			return false;
 	}
 
+	// Unlink first: pins are taken under the same lock, so a chunk that
+	// is not pinned here cannot be reached by a new query afterwards.
+	// Chunks with queued edits (cells or parked regions) stay cached until
+	// applyPendingFor replays them together, in order
+	{
+		std::lock_guard<std::mutex> ck(_chunksMutex);
+		auto itc = _chunks.find(candidate);
+		if (itc == _chunks.end() || itc->second != chunk || chunk->isPinned())
+			return false;
+		std::lock_guard<std::mutex> pk(_pendingMutex);
+		if (_pendingEdits.count(candidate) || _pendingRegions.count(candidate))
+			return false;
+		_chunks.erase(itc);
+		--_chunksCount;
+	}
+
 	// Evict: remove from LRU, maps and free memory
 	{
 		std::lock_guard<std::mutex> lk(_chunksListMutex);
@@ -860,27 +1533,12 @@ bool ChunkLoader::evictChunkAt(const ivec2& candidate) {
 		}
 	}
 
-	size_t freed = chunk->getMemorySize();
 	chunk->unloadNeighbors();
 
-	// Drop any staged/planted flower data for this chunk to prevent
+	// Drop any flower instances for this chunk to prevent
 	// unbounded growth while exploring.
-	{
-		std::lock_guard<std::mutex> fk(_flowersMutex);
-		// Remove any still-staged discoveries for this chunk
-		_discoveredFlowers.erase(candidate);
-		// Remove scanned-keys for all subY belonging to this chunk
-		const std::string prefix = std::to_string(candidate.x) + ":" + std::to_string(candidate.y) + ":";
-		for (auto it = _flowersScannedKeys.begin(); it != _flowersScannedKeys.end(); ) {
-			if (it->rfind(prefix, 0) == 0) it = _flowersScannedKeys.erase(it);
-			else ++it;
-		}
-	}
+	dropFlowersForChunk(candidate);
 
-	{
-		std::lock_guard<std::mutex> pk(_pendingMutex);
-		_pendingEdits.erase(candidate);
-	}
 	{
 		std::lock_guard<std::mutex> dk(_displayedChunksMutex);
 		auto it = _displayedChunks.find(candidate);
@@ -889,78 +1547,38 @@ bool ChunkLoader::evictChunkAt(const ivec2& candidate) {
 			--_displayedCount;
 		}
 	}
-	{
-		std::lock_guard<std::mutex> ck(_chunksMutex);
-		auto itc = _chunks.find(candidate);
-		if (itc != _chunks.end()) {
-			_chunks.erase(itc);
-			--_chunksCount;
-		}
-	}
 	ivec2 chunkPos = chunk->getPosition();
 	_perlinGenerator.removePerlinMap(chunkPos.x, chunkPos.y);
+	// Voxel, mesh and noise bytes are released by their owners' destructors
 	chunk->freeSubChunks();
 	delete chunk;
-	if (_chunksMemoryUsage.load(std::memory_order_relaxed) >= freed)
-		_chunksMemoryUsage.fetch_sub(freed, std::memory_order_relaxed);
-	else
-		_chunksMemoryUsage = 0;
 	return true;
 }
 
-// --- Flowers discovery helpers ---
-void ChunkLoader::scanAndRecordFlowersFor(const glm::ivec2& cpos, int subY, SubChunk* sc, int resolution)
-{
-	if (!sc) return;
-	// Avoid scanning the same sublayer multiple times
-	const std::string key = _flowerKey(cpos, subY);
-	{
-		std::lock_guard<std::mutex> lk(_flowersMutex);
-		if (_flowersScannedKeys.find(key) != _flowersScannedKeys.end()) return;
-		_flowersScannedKeys.insert(key);
-	}
-
-	// Iterate the subchunk cells at its resolution and record any FLOWER blocks
-	std::vector<std::pair<glm::ivec3, BlockType>> flowers;
-	flowers.reserve(8);
-	for (int z = 0; z < CHUNK_SIZE; z += resolution) {
-		for (int y = 0; y < CHUNK_SIZE; y += resolution) {
-			for (int x = 0; x < CHUNK_SIZE; x += resolution) {
-				BlockType b = sc->getBlock({x, y, z});
-				if (b == FLOWER_POPPY || b == FLOWER_DANDELION || b == FLOWER_CYAN || b == FLOWER_SHORT_GRASS || b == FLOWER_DEAD_BUSH) {
-					// Convert to absolute world cell
-					glm::ivec3 cell(
-						x + cpos.x * CHUNK_SIZE,
-						y + subY   * CHUNK_SIZE,
-						z + cpos.y * CHUNK_SIZE
-					);
-					flowers.emplace_back(cell, b);
-				}
-			}
-		}
-	}
-	if (!flowers.empty()) {
-		std::lock_guard<std::mutex> lk(_flowersMutex);
-		auto &bySub = _discoveredFlowers[cpos];
-		auto &vec = bySub[subY];
-		vec.insert(vec.end(), flowers.begin(), flowers.end());
+// --- Flowers staging helpers ---
+void ChunkLoader::stageFlowersFor(const glm::ivec2& cpos, int subY, std::vector<uint32_t> &&cells)
+{
+	std::lock_guard<std::mutex> lk(_flowersMutex);
+	auto it = _flowerSubs.find(cpos);
+	const bool held = (it != _flowerSubs.end() && it->second.count(subY));
+	// Nothing staged before and nothing now: most subchunks end here
+	if (cells.empty() && !held)
+		return;
+	if (cells.empty()) {
+		it->second.erase(subY);
+		if (it->second.empty())
+			_flowerSubs.erase(it);
+	} else {
+		_flowerSubs[cpos].insert(subY);
 	}
+	_flowerUpdates.push_back(FlowerSubUpdate{cpos, subY, std::move(cells)});
 }
 
-void ChunkLoader::fetchAndClearDiscoveredFlowers(std::vector<std::tuple<glm::ivec2,int,glm::ivec3,BlockType>>& out)
+void ChunkLoader::fetchFlowerUpdates(std::vector<FlowerSubUpdate>& out)
 {
 	std::lock_guard<std::mutex> lk(_flowersMutex);
-	for (auto &kv : _discoveredFlowers) {
-		const glm::ivec2 cpos = kv.first;
-		for (auto &kv2 : kv.second) {
-			int subY = kv2.first;
-			auto &lst = kv2.second;
-			for (auto &p : lst) {
-				out.emplace_back(cpos, subY, p.first, p.second);
-			}
-		}
-	}
-	_discoveredFlowers.clear();
+	out.swap(_flowerUpdates);
+	_flowerUpdates.clear();
 }
 
 void ChunkLoader::getDisplayedSubchunksSnapshot(std::unordered_map<glm::ivec2, std::unordered_set<int>, ivec2_hash>& out)
@@ -969,24 +1587,24 @@ void ChunkLoader::getDisplayedSubchunksSnapshot(std::unordered_map<glm::ivec2, s
 	out = _lastDisplayedSubY;
 }
 
-void ChunkLoader::clearFlowerScanMarksFor(const glm::ivec2& cpos)
+void ChunkLoader::dropFlowersForChunk(const glm::ivec2& cpos)
 {
 	std::lock_guard<std::mutex> lk(_flowersMutex);
-	const std::string prefix = std::to_string(cpos.x) + ":" + std::to_string(cpos.y) + ":";
-	for (auto it = _flowersScannedKeys.begin(); it != _flowersScannedKeys.end(); ) {
-		if (it->rfind(prefix, 0) == 0) it = _flowersScannedKeys.erase(it);
-		else ++it;
-	}
+	auto it = _flowerSubs.find(cpos);
+	if (it == _flowerSubs.end()) return;
+	for (int subY : it->second)
+		_flowerUpdates.push_back(FlowerSubUpdate{cpos, subY, {}});
+	_flowerSubs.erase(it);
 }
 
-void ChunkLoader::rescanFlowersForChunk(const glm::ivec2& cpos)
+void ChunkLoader::restageFlowersForChunk(const glm::ivec2& cpos)
 {
 	Chunk* c = getChunk(cpos);
 	if (!c) return;
-	if (c->getResolution() != 1) return; // only scan at full-res
+	if (c->getResolution() != 1) return; // plants only exist at full-res
 	std::vector<int> subs; c->getSubIndices(subs);
 	for (int subY : subs) {
 		SubChunk* sc = c->getSubChunk(subY);
-		if (sc) scanAndRecordFlowersFor(cpos, subY, sc, c->getResolution());
+		if (sc) stageFlowersFor(cpos, subY, sc->getPlants());
 	}
 }
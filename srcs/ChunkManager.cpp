@@ -14,6 +14,7 @@ _chronoHelper(chrono),
 _threadPool(pool),
 _solidStagedDataQueue(),
 _transparentStagedDataQueue(),
+_memGov(),
 _chunkLoader(
 	seed,
 	_camera,
@@ -22,15 +23,18 @@ _chunkLoader(
 	_isRunning,
 	_solidDrawDataMutex,
 	_solidStagedDataQueue,
-	_transparentStagedDataQueue
+	_transparentStagedDataQueue,
+	_memGov
 ),
 _chunkRenderer(
 	_solidDrawDataMutex,
 	_transparentDrawDataMutex,
 	_solidStagedDataQueue,
-	_transparentStagedDataQueue
+	_transparentStagedDataQueue,
+	_memGov
 ),
-_raycaster(_chunkLoader, _camera)
+_raycaster(_chunkLoader, _camera),
+_worldEdit(_chunkLoader, _threadPool)
 {
 }
 
@@ -60,6 +64,7 @@ void ChunkManager::shutDownGL()
 size_t *ChunkManager::getMemorySizePtr() { 
 	return _chunkLoader.getMemorySizePtr();
 }
+MemoryGovernor &ChunkManager::getMemoryGovernor() { return _memGov; }
 
 int	*ChunkManager::getRenderDistancePtr() { 
 	return _chunkLoader.getRenderDistancePtr();
@@ -81,11 +86,32 @@ int *ChunkManager::getModifiedChunksCountPtr() {
 	return _chunkLoader.getModifiedChunksCountPtr();
 }
 
+int *ChunkManager::getPrefetchedChunksCountPtr() {
+	return _chunkLoader.getPrefetchedChunksCountPtr();
+}
+
+int *ChunkManager::getPrefetchCancelledCountPtr() {
+	return _chunkLoader.getPrefetchCancelledCountPtr();
+}
+
+int *ChunkManager::getRefinePendingPtr() {
+	return _chunkLoader.getRefinePendingPtr();
+}
+
+int *ChunkManager::getHoleFramesPtr() {
+	return _chunkLoader.getHoleFramesPtr();
+}
+
 BlockType ChunkManager::getBlock(ivec2 chunkPos, ivec3 worldPos)
 {
 	return _chunkLoader.getBlock(chunkPos, worldPos);
 }
 
+BlockQuery ChunkManager::makeQuery()
+{
+	return BlockQuery(_chunkLoader);
+}
+
 void ChunkManager::getDisplayedChunksSnapshot(std::vector<ivec2>& out)
 {
 	_chunkLoader.getDisplayedChunksSnapshot(out);
@@ -103,7 +129,9 @@ void ChunkManager::setViewProj(const glm::mat4& view, const glm::mat4& proj)
 	glm::vec4 planes[6];
 	for (int i = 0; i < 6; ++i)
 		planes[i] = glm::vec4(f.p[i].n, f.p[i].d);
-	_chunkRenderer.setViewProj(planes);
+	// World-space eye (view may carry the camera translation or be a mirror)
+	glm::vec3 camPos = glm::vec3(glm::inverse(view)[3]);
+	_chunkRenderer.setViewProj(planes, camPos);
 	_chunkLoader.setViewProj(f);
 }
 
@@ -124,6 +152,11 @@ void ChunkManager::snapshotDebugCounters()
 	_chunkLoader.snapshotDebugCounters();
 }
 
+void ChunkManager::sampleVisibleHoles()
+{
+	_chunkLoader.sampleVisibleHoles();
+}
+
 // Chunks loading and unloading methods
 void ChunkManager::loadChunks(ivec2 camPos)
 {
@@ -147,9 +180,9 @@ int ChunkManager::renderSolidBlocks()
 	return _chunkRenderer.renderSolidBlocks();
 }
 
-int ChunkManager::renderTransparentBlocks()
+int ChunkManager::renderTransparentBlocks(TransparentView view)
 {
-	return _chunkRenderer.renderTransparentBlocks();
+	return _chunkRenderer.renderTransparentBlocks(view);
 }
 
 int ChunkManager::renderTransparentBlocksNoCullForShadow()
@@ -157,6 +190,11 @@ int ChunkManager::renderTransparentBlocksNoCullForShadow()
 	return _chunkRenderer.renderTransparentBlocksNoCullForShadow();
 }
 
+int ChunkManager::renderSolidBlocksForCascade(int cascade)
+{
+	return _chunkRenderer.renderSolidBlocksForCascade(cascade);
+}
+
 // Collisions helper
 TopBlock ChunkManager::findBlockUnderPlayer(ivec2 chunkPos, ivec3 worldPos)
 {
@@ -210,9 +248,40 @@ bool ChunkManager::raycastPlaceOne(const glm::vec3& originWorld,
 	return _raycaster.raycastPlaceOne(originWorld, dirWorld, maxDistance, block, outPlaced);
 }
 
-void ChunkManager::fetchAndClearDiscoveredFlowers(std::vector<std::tuple<glm::ivec2,int,glm::ivec3,BlockType>>& out)
+void ChunkManager::raycastBatch(const std::vector<RayQuery> &rays, std::vector<RayHit> &out)
+{
+	_raycaster.raycastBatch(rays, out);
+}
+
+// Bulk world edits
+size_t ChunkManager::fillBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockType value)
+{
+	return _worldEdit.fillBox(a, b, value);
+}
+
+size_t ChunkManager::fillEllipsoid(const glm::vec3 &center, const glm::vec3 &radii, BlockType value)
+{
+	return _worldEdit.fillEllipsoid(center, radii, value);
+}
+
+size_t ChunkManager::replaceInBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockType from, BlockType to)
+{
+	return _worldEdit.replaceInBox(a, b, from, to);
+}
+
+bool ChunkManager::copyBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockRegion &out)
+{
+	return _worldEdit.copyBox(a, b, out);
+}
+
+size_t ChunkManager::paste(const BlockRegion &region, const glm::ivec3 &origin, bool skipAir)
+{
+	return _worldEdit.paste(region, origin, skipAir);
+}
+
+void ChunkManager::fetchFlowerUpdates(std::vector<FlowerSubUpdate>& out)
 {
-	_chunkLoader.fetchAndClearDiscoveredFlowers(out);
+	_chunkLoader.fetchFlowerUpdates(out);
 }
 
 void ChunkManager::getDisplayedSubchunksSnapshot(std::unordered_map<glm::ivec2, std::unordered_set<int>, ivec2_hash>& out)
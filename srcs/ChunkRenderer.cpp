@@ -5,10 +5,12 @@ ChunkRenderer::ChunkRenderer(
 	std::mutex &solidDrawDataMutex,
 	std::mutex &transparentDrawDataMutex,
 	std::queue<DisplayData *>	&solidStagedDataQueue,
-	std::queue<DisplayData *>	&transparentStagedDataQueue
+	std::queue<DisplayData *>	&transparentStagedDataQueue,
+	MemoryGovernor &memGov
 ) :
 _needUpdate(true),
 _needTransparentUpdate(true),
+_memGov(memGov),
 _solidDrawDataMutex(solidDrawDataMutex),
 _transparentDrawDataMutex(transparentDrawDataMutex),
 _solidDrawData(nullptr),
@@ -23,8 +25,8 @@ _hasBufferInitialized(false)
 
 ChunkRenderer::~ChunkRenderer()
 {
-	delete _solidDrawData;
-	delete _transparentDrawData;
+	releaseDisplayData(_solidDrawData);
+	releaseDisplayData(_transparentDrawData);
 	if (_uploadGuard) { glDeleteSync(_uploadGuard); _uploadGuard = 0; }
 }
 
@@ -65,12 +67,62 @@ void ChunkRenderer::shutdownGL()
 
 	// Reveal buffer
 	if (_revealSSBO) { glDeleteBuffers(1, &_revealSSBO); _revealSSBO = 0; }
+
+	// Transparent lists of the views past the main one
+	for (TranspSort &sort : _transpSort) {
+		GLuint bufs[3] = { sort.cmds, sort.pos, sort.meta };
+		if (sort.cmds) glDeleteBuffers(3, bufs);
+		sort.cmds = sort.pos = sort.meta = 0;
+		sort.capCmds = sort.capPos = sort.capMeta = 0;
+		sort.uploaded = false;
+	}
+
+	// Shadow cascade lists
+	for (CascadeLists &lists : _cascadeLists) {
+		GLuint bufs[4] = { lists.cmds, lists.posRes, lists.meta, lists.params };
+		if (lists.cmds) glDeleteBuffers(4, bufs);
+		lists = CascadeLists();
+	}
+
+	_memGov.sub(MEM_GPU, _gpuMemoryReported);
+	_gpuMemoryReported = 0;
+}
+
+void ChunkRenderer::reportGpuMemory()
+{
+	const GLsizeiptr caps[] = {
+		_capTemplSolidCmd, _capOutSolidCmd, _capSolidInst, _capSolidSSBO,
+		_capTemplTranspCmd, _capOutTranspCmd, _capTranspInst, _capTranspSSBO,
+		_capSolidSSBOSrc, _capTranspSSBOSrc, _capSolidMetaSrc, _capTranspMetaSrc,
+		_capSolidMeta, _capTranspMeta, _capHyst, _capReveal, _capCullDebugIDs
+	};
+	size_t bytes = 0;
+	for (GLsizeiptr c : caps)
+		if (c > 0) bytes += (size_t)c;
+	for (const CascadeLists &lists : _cascadeLists)
+		bytes += (size_t)lists.capDraws * (sizeof(DrawArraysIndirectCommand) + sizeof(glm::vec4) + sizeof(GLuint));
+	for (const TranspSort &sort : _transpSort)
+		bytes += (size_t)(sort.capCmds + sort.capPos + sort.capMeta);
+	_memGov.adjust(MEM_GPU, _gpuMemoryReported, bytes);
+	_gpuMemoryReported = bytes;
+}
+
+void ChunkRenderer::releaseDisplayData(DisplayData *data)
+{
+	_memGov.releaseDisplayData(data);
 }
 
 // Shared data setters
-void ChunkRenderer::setViewProj(glm::vec4 planes[6]) {
+void ChunkRenderer::setViewProj(glm::vec4 planes[6], const glm::vec3 &camPos) {
 	// Orphan UBO storage to avoid writing into memory potentially in use
 	glNamedBufferData(_frustumUBO, 6 * sizeof(glm::vec4), planes, GL_DYNAMIC_DRAW);
+	// CPU copy for the transparent pass (culled and sorted on the CPU)
+	for (int i = 0; i < 6; ++i)
+	{
+		_frustum.p[i].n = glm::vec3(planes[i]);
+		_frustum.p[i].d = planes[i].w;
+	}
+	_viewCamPos = camPos;
 	// Reset occlusion source unless explicitly set for this view
 	_occAvailable = false;
 }
@@ -105,19 +157,19 @@ void ChunkRenderer::updateDrawData()
 	{
 		DisplayData *old = _solidStagedDataQueue.front();
 		_solidStagedDataQueue.pop();
-		delete old;
+		releaseDisplayData(old);
 	}
 	while (_transparentStagedDataQueue.size() > 1)
 	{
 		DisplayData *old = _transparentStagedDataQueue.front();
 		_transparentStagedDataQueue.pop();
-		delete old;
+		releaseDisplayData(old);
 	}
 	if (!_solidStagedDataQueue.empty())
 	{
 		DisplayData *stagedData = _solidStagedDataQueue.front();
 		std::swap(stagedData, _solidDrawData);
-		delete stagedData;
+		releaseDisplayData(stagedData);
 		stagedData = nullptr;
 		_solidStagedDataQueue.pop();
 		_needUpdate = true;
@@ -129,7 +181,7 @@ void ChunkRenderer::updateDrawData()
 		
 		DisplayData *stagedData = _transparentStagedDataQueue.front();
 		std::swap(stagedData, _transparentDrawData);
-		delete stagedData;
+		releaseDisplayData(stagedData);
 		stagedData = nullptr;
 		_transparentStagedDataQueue.pop();
 		_needTransparentUpdate = true;
@@ -309,33 +361,33 @@ int ChunkRenderer::renderSolidBlocks()
 
 	// After solid upload/draw, CPU-side solid draw data is no longer needed
 	// Keep ssboData for the transparent pass upload
-	if (!_needUpdate) {
-		_solidDrawData->vertexData.clear();
-		_solidDrawData->indirectBufferData.clear();
-		_solidDrawData->drawMeta.clear();
-		std::vector<int>().swap(_solidDrawData->vertexData);
-		std::vector<DrawArraysIndirectCommand>().swap(_solidDrawData->indirectBufferData);
-		std::vector<uint32_t>().swap(_solidDrawData->drawMeta);
-	}
+	if (!_needUpdate)
+		_memGov.trimDisplayData(_solidDrawData);
 	// removed draw count log
 	return (int)tris;
 }
 
-int ChunkRenderer::renderTransparentBlocks()
+int ChunkRenderer::renderTransparentBlocks(TransparentView view)
 {
 	if (!_transparentDrawData) return 0;
 	if (_needTransparentUpdate) { pushVerticesToOpenGL(true); }
 	if (_transpDrawCount == 0) return 0;
 
-	// Bypass compute compaction for transparent: use template commands and SOURCE buffers
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, _transpPosSrcSSBO);
+	// Cull against the current frustum and draw the survivors back to front
+	sortTransparentDraws(_transpSort[view]);
+	GLsizei visible = cullAndUploadTransparent(view);
+	if (visible == 0) return 0;
+
+	GLuint cmds, pos, meta;
+	transparentDrawBuffers(view, cmds, pos, meta);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, pos);
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, _transpInstSSBO);
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, _transpMetaSrcSSBO);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, meta);
 
 	glDisable(GL_CULL_FACE);
 	glBindVertexArray(_transparentVao);
-	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _transpTemplIndirectBuffer);
-	glMultiDrawArraysIndirect(GL_TRIANGLE_STRIP, nullptr, _transpDrawCount,
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, cmds);
+	glMultiDrawArraysIndirect(GL_TRIANGLE_STRIP, nullptr, visible,
 							  sizeof(DrawArraysIndirectCommand));
 	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
 	glBindVertexArray(0);
@@ -343,18 +395,149 @@ int ChunkRenderer::renderTransparentBlocks()
 	if (_uploadGuard) { glDeleteSync(_uploadGuard); _uploadGuard = 0; }
 	_uploadGuard = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 	// After transparent upload/draw, CPU-side transparent draw data is no longer needed
-	if (!_needTransparentUpdate) {
-		_transparentDrawData->vertexData.clear();
-		_transparentDrawData->indirectBufferData.clear();
-		_transparentDrawData->drawMeta.clear();
-		std::vector<int>().swap(_transparentDrawData->vertexData);
-		std::vector<DrawArraysIndirectCommand>().swap(_transparentDrawData->indirectBufferData);
-		std::vector<uint32_t>().swap(_transparentDrawData->drawMeta);
+	// (sorting works from the compact copies kept at upload time)
+	if (!_needTransparentUpdate)
+		_memGov.trimDisplayData(_transparentDrawData);
+	return (int)visible;
+}
+
+// Back-to-front order of every transparent draw by quantised distance of its
+// subchunk center. Full LSD radix sort when the list changed or the camera
+// moved far; otherwise an insertion pass over last order (nearly sorted, ~O(n)).
+void ChunkRenderer::sortTransparentDraws(TranspSort &sort)
+{
+	std::vector<uint32_t> &order = sort.order;
+	std::vector<uint32_t> &keys = sort.keys;
+	const size_t n = _transpCmdsCPU.size();
+	if (n == 0) { order.clear(); return; }
+	if (sort.valid && order.size() == n && _viewCamPos == sort.camPos)
+		return;
+
+	const float half = (float)CHUNK_SIZE * 0.5f;
+	keys.resize(n);
+	for (size_t i = 0; i < n; ++i)
+	{
+		glm::vec3 center = glm::vec3(_transpPosCPU[i]) + glm::vec3(half);
+		float dist = glm::length(center - _viewCamPos) * TRANSP_SORT_DEPTH_SCALE;
+		uint32_t q = (uint32_t)std::min(dist, 65535.0f);
+		keys[i] = 0xFFFFu - q; // ascending key == far to near
 	}
-	return (int)_transpDrawCount;
-	// removed dumps for transparent
-	// Early-return above; code below is never executed in template path
-	// Keeping function structure minimal for now while stabilizing visuals.
+
+	const bool incremental = sort.valid && order.size() == n
+		&& glm::length(_viewCamPos - sort.camPos) < TRANSP_SORT_RESORT_DIST;
+	if (incremental)
+	{
+		for (size_t i = 1; i < n; ++i)
+		{
+			uint32_t idx = order[i];
+			uint32_t key = keys[idx];
+			size_t j = i;
+			while (j > 0 && keys[order[j - 1]] > key)
+			{
+				order[j] = order[j - 1];
+				--j;
+			}
+			order[j] = idx;
+		}
+	}
+	else
+	{
+		order.resize(n);
+		_transpSortTmp.resize(n);
+		for (size_t i = 0; i < n; ++i) order[i] = (uint32_t)i;
+		// 16-bit keys: two stable 8-bit passes
+		for (int shift = 0; shift < 16; shift += 8)
+		{
+			size_t counts[257] = {0};
+			for (size_t i = 0; i < n; ++i)
+				++counts[((keys[order[i]] >> shift) & 0xFFu) + 1];
+			for (int b = 0; b < 256; ++b)
+				counts[b + 1] += counts[b];
+			for (size_t i = 0; i < n; ++i)
+			{
+				uint32_t idx = order[i];
+				_transpSortTmp[counts[(keys[idx] >> shift) & 0xFFu]++] = idx;
+			}
+			order.swap(_transpSortTmp);
+		}
+	}
+	sort.camPos = _viewCamPos;
+	sort.valid = true;
+}
+
+// Compact visible draws in sorted order into the draw-time buffers
+// (binding 3 pos, 7 meta, indirect commands). Skips the upload when the
+// visible sequence did not change since the view's last call.
+GLsizei ChunkRenderer::cullAndUploadTransparent(TransparentView view)
+{
+	TranspSort &sort = _transpSort[view];
+	const float cs = (float)CHUNK_SIZE;
+	_transpVisibleScratch.clear();
+	for (uint32_t idx : sort.order)
+	{
+		glm::vec3 mn = glm::vec3(_transpPosCPU[idx]);
+		if (_frustum.aabbVisible(mn, mn + glm::vec3(cs)))
+			_transpVisibleScratch.push_back(idx);
+	}
+	if (sort.uploaded && _transpVisibleScratch == sort.visible)
+		return (GLsizei)sort.visible.size();
+	sort.visible.swap(_transpVisibleScratch);
+
+	const size_t v = sort.visible.size();
+	_transpVisCmds.resize(v);
+	_transpVisPos.resize(v);
+	_transpVisMeta.resize(v);
+	for (size_t i = 0; i < v; ++i)
+	{
+		uint32_t idx = sort.visible[i];
+		_transpVisCmds[i] = _transpCmdsCPU[idx];
+		_transpVisPos[i]  = _transpPosCPU[idx];
+		_transpVisMeta[i] = _transpMetaCPU[idx];
+	}
+	if (v > 0)
+	{
+		// Grow-only: trackers hold the allocated size and only change when
+		// the buffer is reallocated, smaller uploads reuse the storage
+		bool grown = false;
+		auto upload = [&grown](GLuint buf, GLsizeiptr &cap, GLsizeiptr bytes, const void *data)
+		{
+			if (cap < bytes)
+			{
+				GLsizeiptr newCap = cap > 0 ? cap : (GLsizeiptr)4096;
+				while (newCap < bytes) newCap *= 2;
+				glNamedBufferData(buf, newCap, nullptr, GL_DYNAMIC_DRAW);
+				cap = newCap;
+				grown = true;
+			}
+			glNamedBufferSubData(buf, 0, bytes, data);
+		};
+		const bool main = view == TRANSP_VIEW_MAIN;
+		if (!main && !sort.cmds)
+		{
+			glCreateBuffers(1, &sort.cmds);
+			glCreateBuffers(1, &sort.pos);
+			glCreateBuffers(1, &sort.meta);
+		}
+		upload(main ? _transparentIndirectBuffer : sort.cmds, main ? _capOutTranspCmd : sort.capCmds,
+			(GLsizeiptr)(v * sizeof(DrawArraysIndirectCommand)), _transpVisCmds.data());
+		upload(main ? _transpPosSSBO : sort.pos, main ? _capTranspSSBO : sort.capPos,
+			(GLsizeiptr)(v * sizeof(glm::vec4)), _transpVisPos.data());
+		upload(main ? _transpMetaSSBO : sort.meta, main ? _capTranspMeta : sort.capMeta,
+			(GLsizeiptr)(v * sizeof(uint32_t)), _transpVisMeta.data());
+		if (grown)
+			reportGpuMemory();
+	}
+	sort.uploaded = true;
+	return (GLsizei)v;
+}
+
+void ChunkRenderer::transparentDrawBuffers(TransparentView view, GLuint &cmds, GLuint &pos, GLuint &meta)
+{
+	const TranspSort &sort = _transpSort[view];
+	const bool main = view == TRANSP_VIEW_MAIN;
+	cmds = main ? _transparentIndirectBuffer : sort.cmds;
+	pos  = main ? _transpPosSSBO : sort.pos;
+	meta = main ? _transpMetaSSBO : sort.meta;
 }
 
 int ChunkRenderer::renderTransparentBlocksNoCullForShadow()
@@ -379,6 +562,83 @@ int ChunkRenderer::renderTransparentBlocksNoCullForShadow()
 	return (int)_transpDrawCount;
 }
 
+int ChunkRenderer::renderSolidBlocksForCascade(int cascade)
+{
+	if (!_solidDrawData || cascade < 0 || cascade >= SHADOW_CASCADES) return 0;
+	if (_needUpdate) { pushVerticesToOpenGL(false); }
+	const GLsizei count = _solidDrawCount;
+	if (count <= 0 || !_templIndirectBuffer || !_solidPosSrcSSBO) return 0;
+
+	CascadeLists &lists = _cascadeLists[cascade];
+	if (lists.cmds == 0) {
+		glCreateBuffers(1, &lists.cmds);
+		glCreateBuffers(1, &lists.posRes);
+		glCreateBuffers(1, &lists.meta);
+		glCreateBuffers(1, &lists.params);
+	}
+	if (lists.capDraws < count) {
+		GLsizeiptr cap = lists.capDraws > 0 ? lists.capDraws : (GLsizeiptr)256;
+		while (cap < count) cap *= 2;
+		glNamedBufferData(lists.cmds, cap * (GLsizeiptr)sizeof(DrawArraysIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+		glNamedBufferData(lists.posRes, cap * (GLsizeiptr)sizeof(glm::vec4), nullptr, GL_DYNAMIC_DRAW);
+		glNamedBufferData(lists.meta, cap * (GLsizeiptr)sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+		lists.capDraws = cap;
+		reportGpuMemory();
+	}
+	GLuint zero = 0;
+	glNamedBufferData(lists.params, sizeof(GLuint), &zero, GL_DYNAMIC_DRAW);
+	glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+	// Same compaction as the camera pass, frustum only: there is no depth
+	// from the light's point of view to test occlusion against
+	GLint prev = 0; glGetIntegerv(GL_CURRENT_PROGRAM, &prev);
+	glUseProgram(_cullProgram);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, _solidPosSrcSSBO);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, _templIndirectBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, lists.cmds);
+	glBindBufferBase(GL_UNIFORM_BUFFER,        3, _frustumUBO);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, lists.params);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, lists.posRes);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, _solidMetaSrcSSBO);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, lists.meta);
+	glUniform1ui(_locNumDraws, (GLuint)count);
+	glUniform1f (_locChunkSize, (float)CHUNK_SIZE);
+	if (_locUseOcclu >= 0) glUniform1i(_locUseOcclu, 0);
+	if (_locDebugLogOcclu >= 0) glUniform1i(_locDebugLogOcclu, 0);
+	glDispatchCompute((GLuint)(count + 63) / 64u, 1, 1);
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+	glUseProgram(prev ? (GLuint)prev : 0);
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, lists.posRes);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, _solidInstSSBO);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, lists.meta);
+	glBindVertexArray(_vao);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, lists.cmds);
+	// Small lists: explicit count, as in renderSolidBlocks
+	bool usedExplicit = false;
+	if (count <= 32) {
+		GLuint* mapped = (GLuint*)glMapNamedBufferRange(lists.params, 0, sizeof(GLuint), GL_MAP_READ_BIT);
+		GLuint dc = 0;
+		if (mapped) { dc = *mapped; glUnmapNamedBuffer(lists.params); usedExplicit = true; }
+		if (dc > 0)
+			glMultiDrawArraysIndirect(GL_TRIANGLE_STRIP, nullptr, (GLsizei)dc,
+									   sizeof(DrawArraysIndirectCommand));
+	}
+	if (!usedExplicit) {
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, lists.params);
+		glMultiDrawArraysIndirectCount(GL_TRIANGLE_STRIP, nullptr, 0, count,
+									   sizeof(DrawArraysIndirectCommand));
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, 0);
+	}
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	glBindVertexArray(0);
+
+	// Uploads wait for these draws too
+	if (_uploadGuard) { glDeleteSync(_uploadGuard); _uploadGuard = 0; }
+	_uploadGuard = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	return (int)count;
+}
+
 // GPU side frustum culling helpers (init and run)
 void ChunkRenderer::initGpuCulling() {
 	_cullProgram  = compileComputeShader("shaders/compute/frustum_cull.glsl");
@@ -437,6 +697,7 @@ void ChunkRenderer::runGpuCulling(bool transparent) {
 		glNamedBufferData(_hystSSBO, cap, nullptr, GL_DYNAMIC_DRAW);
 		_capHyst = cap;
 		_hystDrawsStored = 0; // force zeroing below
+		reportGpuMemory();
 	}
 	if (_hystDrawsStored != (GLsizei)count) {
 		// Reset counters to zero when draw list size changes (mapping may change)
@@ -455,6 +716,7 @@ void ChunkRenderer::runGpuCulling(bool transparent) {
 		glNamedBufferData(_revealSSBO, cap, nullptr, GL_DYNAMIC_DRAW);
 		_capReveal = cap;
 		_revealDrawsStored = 0;
+		reportGpuMemory();
 	}
 	if (_revealDrawsStored != (GLsizei)count) {
 		std::vector<GLuint> zeros(count, 0u);
@@ -623,6 +885,13 @@ void ChunkRenderer::pushVerticesToOpenGL(bool transparent)
 		// No SubData upload; compute shader fills it.
 		ensureCapacityOnly(_transpPosSSBO, _capTranspSSBO, bytesSSBO, GL_DYNAMIC_DRAW);
 
+		// Keep compact copies for per-frame culling and sorting
+		_transpCmdsCPU = _transparentDrawData->indirectBufferData;
+		_transpPosCPU  = _transparentDrawData->ssboData;
+		_transpMetaCPU = _transparentDrawData->drawMeta;
+		for (TranspSort &sort : _transpSort)
+			sort.valid = sort.uploaded = false;
+
 		_transpDrawCount = (GLsizei)nCmd;
 		_needTransparentUpdate = false;
 	}
@@ -674,4 +943,5 @@ void ChunkRenderer::pushVerticesToOpenGL(bool transparent)
 		_lastSolidTris = tris;
 		_needUpdate = false;
 	}
+	reportGpuMemory();
 }
@@ -0,0 +1,228 @@
+#include "FarTerrain.hpp"
+
+static inline int mod_floor(int a, int b)
+{
+	int m = a % b;
+	return (m < 0) ? m + b : m;
+}
+
+static inline int floor_div(int a, int b)
+{
+	int q = a / b;
+	int r = a % b;
+	if ((r != 0) && ((r < 0) != (b < 0))) --q;
+	return q;
+}
+
+FarTerrain::FarTerrain(size_t seed, ThreadPool &pool) : _pool(pool)
+{
+	// Fixed level count: vector never reallocates once jobs hold references
+	_levels.resize(FAR_TERRAIN_LEVELS);
+	for (int i = 0; i < FAR_TERRAIN_LEVELS; ++i)
+	{
+		Level &lvl = _levels[i];
+		lvl.step = FAR_TERRAIN_STEP << i;
+		lvl.noise = std::make_unique<NoiseGenerator>(seed);
+		lvl.cells.assign(FAR_TERRAIN_GRID * FAR_TERRAIN_GRID, glm::vec4(0.0f));
+	}
+}
+
+FarTerrain::~FarTerrain()
+{
+	// Jobs capture `this`, drain them before members go away
+	for (auto &lvl : _levels)
+		if (lvl.job.valid())
+			lvl.job.wait();
+	shutdownGL();
+}
+
+void FarTerrain::initGL()
+{
+	_program = createShaderProgram("shaders/render/far_terrain.vert", "shaders/render/far_terrain.frag");
+	// Grid vertices are generated from gl_VertexID, the VAO stays empty
+	glGenVertexArrays(1, &_vao);
+	for (auto &lvl : _levels)
+	{
+		glGenTextures(1, &lvl.texture);
+		glBindTexture(GL_TEXTURE_2D, lvl.texture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, FAR_TERRAIN_GRID, FAR_TERRAIN_GRID, 0, GL_RGBA, GL_FLOAT, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void FarTerrain::shutdownGL()
+{
+	for (auto &lvl : _levels)
+	{
+		if (lvl.texture) { glDeleteTextures(1, &lvl.texture); lvl.texture = 0; }
+		lvl.gpuValid = false;
+	}
+	if (_vao) { glDeleteVertexArrays(1, &_vao); _vao = 0; }
+	if (_program) { glDeleteProgram(_program); _program = 0; }
+}
+
+glm::vec4 FarTerrain::sampleCell(NoiseGenerator &noise, int wx, int wz)
+{
+	ivec2 pos(wx, wz);
+	double height = noise.getHeight(pos);
+	Biome biome = noise.getBiome(pos, height);
+
+	glm::vec3 color;
+	switch (biome)
+	{
+		case DESERT:	color = glm::vec3(0.86f, 0.80f, 0.58f); break;
+		case SNOWY:		color = glm::vec3(0.93f, 0.95f, 0.97f); break;
+		case MOUNTAINS:	color = glm::vec3(0.50f, 0.50f, 0.50f); break;
+		case FOREST:	color = glm::vec3(0.24f, 0.42f, 0.16f); break;
+		case OCEAN:		color = glm::vec3(0.16f, 0.32f, 0.55f); break;
+		case BEACH:		color = glm::vec3(0.88f, 0.83f, 0.62f); break;
+		case PLAINS:
+		default:		color = glm::vec3(0.36f, 0.55f, 0.22f); break;
+	}
+	// Snow caps on high peaks, flat water surface below sea level
+	if (biome == MOUNTAINS && height > MOUNT_HEIGHT - 20)
+		color = glm::vec3(0.93f, 0.95f, 0.97f);
+	if (height < OCEAN_HEIGHT)
+	{
+		color = glm::vec3(0.16f, 0.32f, 0.55f);
+		height = OCEAN_HEIGHT + 1;
+	}
+	return glm::vec4(color, (float)height);
+}
+
+void FarTerrain::buildLevel(Level &lvl, glm::ivec2 newOrigin)
+{
+	const int n = FAR_TERRAIN_GRID;
+	for (int lz = 0; lz < n; ++lz)
+	{
+		const int gz = newOrigin.y + lz;
+		const bool rowKept = lvl.valid && gz >= lvl.origin.y && gz < lvl.origin.y + n;
+		for (int lx = 0; lx < n; ++lx)
+		{
+			const int gx = newOrigin.x + lx;
+			// Cells still inside the previous window already hold the right sample
+			if (rowKept && gx >= lvl.origin.x && gx < lvl.origin.x + n)
+				continue;
+			lvl.cells[mod_floor(gz, n) * n + mod_floor(gx, n)] = sampleCell(*lvl.noise, gx * lvl.step, gz * lvl.step);
+		}
+	}
+	lvl.origin = newOrigin;
+	lvl.valid = true;
+}
+
+glm::ivec2 FarTerrain::desiredOrigin(const Level &lvl, glm::ivec2 centerWorld) const
+{
+	// Snap the center to even cells: the origin, and the even-sized drawn
+	// window, then land on the parent's (2 * step) vertices
+	const int cx = floor_div(centerWorld.x, lvl.step * 2) * 2;
+	const int cz = floor_div(centerWorld.y, lvl.step * 2) * 2;
+	return glm::ivec2(cx - FAR_TERRAIN_GRID / 2, cz - FAR_TERRAIN_GRID / 2);
+}
+
+void FarTerrain::uploadLevel(Level &lvl)
+{
+	if (!lvl.texture)
+		return;
+	glBindTexture(GL_TEXTURE_2D, lvl.texture);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, FAR_TERRAIN_GRID, FAR_TERRAIN_GRID, GL_RGBA, GL_FLOAT, lvl.cells.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+	lvl.gpuOrigin = lvl.origin;
+	lvl.gpuValid = true;
+}
+
+void FarTerrain::update(const glm::vec3 &camWorld)
+{
+	// Level 0 follows the camera, every coarser level follows its child's target
+	glm::ivec2 center((int)std::floor(camWorld.x), (int)std::floor(camWorld.z));
+	for (auto &lvl : _levels)
+	{
+		const bool busy = lvl.job.valid() && lvl.job.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+		if (lvl.job.valid() && !busy)
+		{
+			lvl.job.get();
+			uploadLevel(lvl);
+		}
+		if (!busy)
+		{
+			glm::ivec2 want = desiredOrigin(lvl, center);
+			if (!lvl.valid
+				|| std::abs(want.x - lvl.origin.x) >= FAR_TERRAIN_RECENTER_CELLS
+				|| std::abs(want.y - lvl.origin.y) >= FAR_TERRAIN_RECENTER_CELLS)
+			{
+				lvl.target = want;
+				lvl.job = _pool.enqueue(&FarTerrain::buildLevel, this, std::ref(lvl), want);
+			}
+			else
+				lvl.target = lvl.origin;
+		}
+		center = (lvl.target + FAR_TERRAIN_GRID / 2) * lvl.step;
+	}
+}
+
+void FarTerrain::render(const glm::mat4 &viewRot, const glm::mat4 &projection,
+						const glm::vec3 &camWorld, const glm::vec3 &sunDir,
+						int timeValue, float innerRadius)
+{
+	if (!_program || !_vao)
+		return;
+
+	const int n = FAR_TERRAIN_GRID;
+	glUseProgram(_program);
+	glUniformMatrix4fv(glGetUniformLocation(_program, "view"), 1, GL_FALSE, glm::value_ptr(viewRot));
+	glUniformMatrix4fv(glGetUniformLocation(_program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+	glUniform3fv(glGetUniformLocation(_program, "cameraPos"), 1, glm::value_ptr(camWorld));
+	glUniform3fv(glGetUniformLocation(_program, "sunDir"), 1, glm::value_ptr(sunDir));
+	glUniform1i(glGetUniformLocation(_program, "timeValue"), timeValue);
+	glUniform1i(glGetUniformLocation(_program, "gridSize"), n);
+	glUniform1f(glGetUniformLocation(_program, "innerRadius"), innerRadius);
+	glUniform1f(glGetUniformLocation(_program, "sinkDepth"), FAR_TERRAIN_SINK);
+	glUniform1f(glGetUniformLocation(_program, "skirtCells"), FAR_TERRAIN_SKIRT);
+	glUniform1i(glGetUniformLocation(_program, "cells"), 0);
+	GLint originLoc = glGetUniformLocation(_program, "origin");
+	GLint stepLoc = glGetUniformLocation(_program, "cellStep");
+	GLint holeLoc = glGetUniformLocation(_program, "holeRect");
+	GLint morphLoc = glGetUniformLocation(_program, "morphCells");
+
+	GLboolean cullWasEnabled = glIsEnabled(GL_CULL_FACE);
+	glDisable(GL_CULL_FACE);
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_TRUE);
+	glBindVertexArray(_vao);
+	glActiveTexture(GL_TEXTURE0);
+
+	// Even quad count so both window edges sit on the parent's vertices,
+	// plus one skirt quad per border segment
+	const int quads = n - 2;
+	const GLsizei vertexCount = (quads * quads + 4 * quads) * 6;
+	for (size_t i = 0; i < _levels.size(); ++i)
+	{
+		const Level &lvl = _levels[i];
+		if (!lvl.gpuValid)
+			continue;
+		// The finer level's window is cut out of this one (empty rect when none)
+		glm::vec4 hole(1.0f, 1.0f, 0.0f, 0.0f);
+		if (i > 0 && _levels[i - 1].gpuValid)
+		{
+			const Level &fine = _levels[i - 1];
+			hole = glm::vec4(fine.gpuOrigin.x * fine.step, fine.gpuOrigin.y * fine.step,
+							 (fine.gpuOrigin.x + quads) * fine.step, (fine.gpuOrigin.y + quads) * fine.step);
+		}
+		// Morph the border onto the parent only when the parent is drawn around it
+		const bool hasParent = i + 1 < _levels.size() && _levels[i + 1].gpuValid;
+		glBindTexture(GL_TEXTURE_2D, lvl.texture);
+		glUniform2i(originLoc, lvl.gpuOrigin.x, lvl.gpuOrigin.y);
+		glUniform1f(stepLoc, (float)lvl.step);
+		glUniform4fv(holeLoc, 1, glm::value_ptr(hole));
+		glUniform1f(morphLoc, hasParent ? (float)FAR_TERRAIN_MORPH_CELLS : 0.0f);
+		glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindVertexArray(0);
+	if (cullWasEnabled)
+		glEnable(GL_CULL_FACE);
+}
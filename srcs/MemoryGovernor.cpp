@@ -0,0 +1,168 @@
+#include "MemoryGovernor.hpp"
+
+static constexpr size_t MB = (size_t)1 << 20;
+
+static const char *categoryName(MemoryCategory cat)
+{
+	switch (cat)
+	{
+		case MEM_VOXELS:	return "voxels";
+		case MEM_MESHES:	return "meshes";
+		case MEM_NOISE:		return "noise";
+		case MEM_GPU:		return "gpu";
+		case MEM_FLOWERS:	return "flowers";
+		default:			return "?";
+	}
+}
+
+MemoryGovernor::MemoryGovernor()
+{
+	for (int i = 0; i < MEM_CATEGORY_COUNT; ++i)
+	{
+		_usage[i] = 0;
+		_underflows[i] = 0;
+		_dbgUsage[i] = 0;
+	}
+	_budget[MEM_VOXELS]  = (size_t)MEMORY_BUDGET_VOXELS_MB * MB;
+	_budget[MEM_MESHES]  = (size_t)MEMORY_BUDGET_MESHES_MB * MB;
+	_budget[MEM_NOISE]   = (size_t)MEMORY_BUDGET_NOISE_MB * MB;
+	_budget[MEM_GPU]     = (size_t)MEMORY_BUDGET_GPU_MB * MB;
+	_budget[MEM_FLOWERS] = (size_t)MEMORY_BUDGET_FLOWERS_MB * MB;
+	_hardCap = (size_t)MEMORY_HARD_CAP_MB * MB;
+}
+
+void MemoryGovernor::add(MemoryCategory cat, size_t bytes)
+{
+	_usage[cat].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryGovernor::sub(MemoryCategory cat, size_t bytes)
+{
+	// Clamp at zero so the counter does not wrap, but surface the bug:
+	// releasing more than was added means a double release or a missed add
+	size_t cur = _usage[cat].load(std::memory_order_relaxed);
+	size_t next;
+	do {
+		next = (cur >= bytes) ? cur - bytes : 0;
+	} while (!_usage[cat].compare_exchange_weak(cur, next, std::memory_order_relaxed));
+	if (cur < bytes && _underflows[cat].fetch_add(1, std::memory_order_relaxed) == 0)
+		std::cerr << "MemoryGovernor: " << categoryName(cat) << " released " << bytes
+				  << " bytes with only " << cur << " tracked (double release?)" << std::endl;
+}
+
+void MemoryGovernor::adjust(MemoryCategory cat, size_t oldBytes, size_t newBytes)
+{
+	if (newBytes > oldBytes)
+		add(cat, newBytes - oldBytes);
+	else if (oldBytes > newBytes)
+		sub(cat, oldBytes - newBytes);
+}
+
+size_t MemoryGovernor::usage(MemoryCategory cat) const
+{
+	return _usage[cat].load(std::memory_order_relaxed);
+}
+
+size_t MemoryGovernor::budget(MemoryCategory cat) const
+{
+	return _budget[cat];
+}
+
+size_t MemoryGovernor::total() const
+{
+	size_t sum = 0;
+	for (int i = 0; i < MEM_CATEGORY_COUNT; ++i)
+		sum += _usage[i].load(std::memory_order_relaxed);
+	return sum;
+}
+
+size_t MemoryGovernor::cpuTotal() const
+{
+	size_t sum = 0;
+	for (int i = 0; i < MEM_CATEGORY_COUNT; ++i)
+		if (!isGpuCategory((MemoryCategory)i))
+			sum += _usage[i].load(std::memory_order_relaxed);
+	return sum;
+}
+
+bool MemoryGovernor::overBudget(MemoryCategory cat) const
+{
+	return usage(cat) > _budget[cat];
+}
+
+bool MemoryGovernor::overHardCap() const
+{
+	return cpuTotal() > _hardCap;
+}
+
+bool MemoryGovernor::overGpuBudget() const
+{
+	return overBudget(MEM_GPU) || overBudget(MEM_FLOWERS);
+}
+
+size_t MemoryGovernor::underflows(MemoryCategory cat) const
+{
+	return _underflows[cat].load(std::memory_order_relaxed);
+}
+
+MemoryCategory MemoryGovernor::mostOverBudget() const
+{
+	MemoryCategory worst = MEM_CATEGORY_COUNT;
+	double worstRatio = 1.0;
+	for (int i = 0; i < MEM_CATEGORY_COUNT; ++i)
+	{
+		if (_budget[i] == 0 || isGpuCategory((MemoryCategory)i))
+			continue;
+		double ratio = (double)usage((MemoryCategory)i) / (double)_budget[i];
+		if (ratio > worstRatio)
+		{
+			worstRatio = ratio;
+			worst = (MemoryCategory)i;
+		}
+	}
+	return worst;
+}
+
+size_t MemoryGovernor::bytesOf(const DisplayData *data)
+{
+	if (!data)
+		return 0;
+	return sizeof(DisplayData)
+		+ data->ssboData.capacity() * sizeof(vec4)
+		+ data->vertexData.capacity() * sizeof(int)
+		+ data->indirectBufferData.capacity() * sizeof(DrawArraysIndirectCommand)
+		+ data->drawMeta.capacity() * sizeof(uint32_t);
+}
+
+void MemoryGovernor::chargeDisplayData(DisplayData *data)
+{
+	const size_t bytes = bytesOf(data);
+	adjust(MEM_MESHES, data->memCharged, bytes);
+	data->memCharged = bytes;
+}
+
+void MemoryGovernor::trimDisplayData(DisplayData *data)
+{
+	std::vector<int>().swap(data->vertexData);
+	std::vector<DrawArraysIndirectCommand>().swap(data->indirectBufferData);
+	std::vector<uint32_t>().swap(data->drawMeta);
+	chargeDisplayData(data);
+}
+
+void MemoryGovernor::releaseDisplayData(DisplayData *data)
+{
+	if (!data)
+		return;
+	sub(MEM_MESHES, data->memCharged);
+	delete data;
+}
+
+void MemoryGovernor::snapshot()
+{
+	for (int i = 0; i < MEM_CATEGORY_COUNT; ++i)
+		_dbgUsage[i] = usage((MemoryCategory)i);
+	_dbgTotal = total();
+}
+
+size_t *MemoryGovernor::getUsagePtr(MemoryCategory cat) { return &_dbgUsage[cat]; }
+size_t *MemoryGovernor::getTotalPtr() { return &_dbgTotal; }
@@ -0,0 +1,307 @@
+#include "NoiseBackend.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+	template <typename T> inline T fade(T t)
+	{
+		return t * t * t * (t * (t * 6 - 15) + 10);
+	}
+
+	template <typename T> inline T lerp(T a, T b, T t)
+	{
+		return a + t * (b - a);
+	}
+
+	template <typename T> inline int floorInt(T v)
+	{
+		return static_cast<int>(std::floor(v));
+	}
+
+	// Classic Perlin: same arithmetic as the original generators
+	class PerlinBackend : public NoiseBackend
+	{
+		std::vector<int> _p;
+
+		template <typename T> static T grad2(int hash, T x, T y)
+		{
+			int h = hash & 3; // Only 4 gradients
+			T u = h < 2 ? x : y;
+			T v = h < 2 ? y : x;
+			return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+		}
+
+		template <typename T> static T grad3(int hash, T x, T y, T z)
+		{
+			int h = hash & 15;
+			T u = h < 8 ? x : y;
+			T v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+			return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+		}
+
+		template <typename T> T sample(T x, T y) const
+		{
+			int X = floorInt(x) & 255;
+			int Y = floorInt(y) & 255;
+
+			x -= std::floor(x);
+			y -= std::floor(y);
+
+			T u = fade(x);
+			T v = fade(y);
+
+			int A = _p[X] + Y;
+			int B = _p[X + 1] + Y;
+
+			return lerp(
+				lerp(grad2(_p[A], x, y), grad2(_p[B], x - 1, y), u),
+				lerp(grad2(_p[A + 1], x, y - 1), grad2(_p[B + 1], x - 1, y - 1), u),
+				v
+			);
+		}
+
+		template <typename T> T sample(T x, T y, T z) const
+		{
+			int X = floorInt(x) & 255;
+			int Y = floorInt(y) & 255;
+			int Z = floorInt(z) & 255;
+
+			x -= std::floor(x);
+			y -= std::floor(y);
+			z -= std::floor(z);
+
+			T u = fade(x);
+			T v = fade(y);
+			T w = fade(z);
+
+			int A  = _p[X] + Y,		AA = _p[A] + Z,	AB = _p[A + 1] + Z;
+			int B  = _p[X + 1] + Y,	BA = _p[B] + Z,	BB = _p[B + 1] + Z;
+
+			return lerp(
+				lerp(
+					lerp(grad3(_p[AA], x, y, z), grad3(_p[BA], x - 1, y, z), u),
+					lerp(grad3(_p[AB], x, y - 1, z), grad3(_p[BB], x - 1, y - 1, z), u),
+					v),
+				lerp(
+					lerp(grad3(_p[AA + 1], x, y, z - 1), grad3(_p[BA + 1], x - 1, y, z - 1), u),
+					lerp(grad3(_p[AB + 1], x, y - 1, z - 1), grad3(_p[BB + 1], x - 1, y - 1, z - 1), u),
+					v),
+				w
+			);
+		}
+	public:
+		explicit PerlinBackend(const std::vector<int> &permutation) : _p(permutation) {}
+		double	noise(double x, double y) const override { return sample(x, y); }
+		float	noise(float x, float y) const override { return sample(x, y); }
+		double	noise(double x, double y, double z) const override { return sample(x, y, z); }
+		float	noise(float x, float y, float z) const override { return sample(x, y, z); }
+	};
+
+	// OpenSimplex2-style: simplex triangles in 2D, the two interleaved cubic
+	// lattices of the BCC grid in 3D, radial kernels instead of a cell lerp
+	class OpenSimplex2Backend : public NoiseBackend
+	{
+		// Brings the 3D sum back to about [-1, 1]
+		static constexpr double SCALE3 = 32.0;
+		std::vector<int> _p;
+
+		int hash(int x, int y) const
+		{
+			return _p[(_p[x & 255] + (y & 255)) & 255];
+		}
+		int hash(int x, int y, int z) const
+		{
+			return _p[(_p[(_p[x & 255] + (y & 255)) & 255] + (z & 255)) & 255];
+		}
+
+		template <typename T> static T dot2(int h, T x, T y)
+		{
+			static const int g[8][2] = {{1, 1}, {-1, 1}, {1, -1}, {-1, -1}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+			return g[h & 7][0] * x + g[h & 7][1] * y;
+		}
+		template <typename T> static T dot3(int h, T x, T y, T z)
+		{
+			static const int g[12][3] = {
+				{1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0},
+				{1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1},
+				{0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1}};
+			const int *v = g[h % 12];
+			return v[0] * x + v[1] * y + v[2] * z;
+		}
+
+		template <typename T> T sample(T x, T y) const
+		{
+			const T F2 = T(0.36602540378443864676);
+			const T G2 = T(0.21132486540518711775);
+			const T s = (x + y) * F2;
+			const int i = floorInt(x + s);
+			const int j = floorInt(y + s);
+			const T t = T(i + j) * G2;
+			const T x0 = x - (T(i) - t);
+			const T y0 = y - (T(j) - t);
+			const int i1 = x0 > y0 ? 1 : 0;
+			const int j1 = 1 - i1;
+			const T dx[3] = {x0, x0 - i1 + G2, x0 - 1 + 2 * G2};
+			const T dy[3] = {y0, y0 - j1 + G2, y0 - 1 + 2 * G2};
+			const int h[3] = {hash(i, j), hash(i + i1, j + j1), hash(i + 1, j + 1)};
+
+			T sum = 0;
+			for (int k = 0; k < 3; ++k)
+			{
+				T a = T(0.5) - dx[k] * dx[k] - dy[k] * dy[k];
+				if (a <= 0)
+					continue;
+				a *= a;
+				sum += a * a * dot2(h[k], dx[k], dy[k]);
+			}
+			return sum * T(70);
+		}
+
+		template <typename T> T sample(T x, T y, T z) const
+		{
+			T sum = 0;
+			// Lattice A on integer points, lattice B on cube centers
+			for (int l = 0; l < 2; ++l)
+			{
+				const T off = l ? T(0.5) : T(0);
+				const int bx = floorInt(x - off), by = floorInt(y - off), bz = floorInt(z - off);
+				for (int c = 0; c < 8; ++c)
+				{
+					const int px = bx + (c & 1), py = by + ((c >> 1) & 1), pz = bz + (c >> 2);
+					const T dx = x - (T(px) + off), dy = y - (T(py) + off), dz = z - (T(pz) + off);
+					T a = T(0.6) - dx * dx - dy * dy - dz * dz;
+					if (a <= 0)
+						continue;
+					a *= a;
+					sum += a * a * dot3(hash(px + l * 97, py, pz), dx, dy, dz);
+				}
+			}
+			return sum * T(SCALE3);
+		}
+	public:
+		explicit OpenSimplex2Backend(const std::vector<int> &permutation) : _p(permutation) {}
+		double	noise(double x, double y) const override { return sample(x, y); }
+		float	noise(float x, float y) const override { return sample(x, y); }
+		double	noise(double x, double y, double z) const override { return sample(x, y, z); }
+		float	noise(float x, float y, float z) const override { return sample(x, y, z); }
+	};
+
+	// Value noise: one hashed value per lattice point, smoothed with fade
+	class ValueBackend : public NoiseBackend
+	{
+		uint32_t _seed;
+
+		template <typename T> T value(int x, int y, int z) const
+		{
+			uint32_t h = _seed;
+			h ^= static_cast<uint32_t>(x) * 0x27d4eb2dU;
+			h ^= static_cast<uint32_t>(y) * 0x165667b1U;
+			h ^= static_cast<uint32_t>(z) * 0x9e3779b1U;
+			h ^= h >> 15;
+			h *= 0x2c1b3c6dU;
+			h ^= h >> 12;
+			h *= 0x297a2d39U;
+			h ^= h >> 15;
+			return T(h & 0xffffff) * T(1.0 / 8388607.5) - T(1);
+		}
+
+		template <typename T> T sample(T x, T y) const
+		{
+			const int X = floorInt(x), Y = floorInt(y);
+			const T u = fade(x - T(X)), v = fade(y - T(Y));
+			return lerp(
+				lerp(value<T>(X, Y, 0), value<T>(X + 1, Y, 0), u),
+				lerp(value<T>(X, Y + 1, 0), value<T>(X + 1, Y + 1, 0), u),
+				v);
+		}
+
+		template <typename T> T sample(T x, T y, T z) const
+		{
+			const int X = floorInt(x), Y = floorInt(y), Z = floorInt(z);
+			const T u = fade(x - T(X)), v = fade(y - T(Y)), w = fade(z - T(Z));
+			return lerp(
+				lerp(
+					lerp(value<T>(X, Y, Z), value<T>(X + 1, Y, Z), u),
+					lerp(value<T>(X, Y + 1, Z), value<T>(X + 1, Y + 1, Z), u),
+					v),
+				lerp(
+					lerp(value<T>(X, Y, Z + 1), value<T>(X + 1, Y, Z + 1), u),
+					lerp(value<T>(X, Y + 1, Z + 1), value<T>(X + 1, Y + 1, Z + 1), u),
+					v),
+				w);
+		}
+	public:
+		explicit ValueBackend(uint32_t seed) : _seed(seed * 0x85ebca6bU + 0x68e31da4U) {}
+		double	noise(double x, double y) const override { return sample(x, y); }
+		float	noise(float x, float y) const override { return sample(x, y); }
+		double	noise(double x, double y, double z) const override { return sample(x, y, z); }
+		float	noise(float x, float y, float z) const override { return sample(x, y, z); }
+	};
+
+	NoiseBackendType g_selected = static_cast<NoiseBackendType>(NOISE_BACKEND);
+}
+
+std::unique_ptr<NoiseBackend> NoiseBackend::create(NoiseBackendType type, uint32_t seed, const std::vector<int> &permutation)
+{
+	switch (type)
+	{
+		case NOISE_OPENSIMPLEX2:	return std::unique_ptr<NoiseBackend>(new OpenSimplex2Backend(permutation));
+		case NOISE_VALUE:			return std::unique_ptr<NoiseBackend>(new ValueBackend(seed));
+		case NOISE_PERLIN:
+		default:					return std::unique_ptr<NoiseBackend>(new PerlinBackend(permutation));
+	}
+}
+
+std::unique_ptr<NoiseBackend> NoiseBackend::create(uint32_t seed, const std::vector<int> &permutation)
+{
+	return create(g_selected, seed, permutation);
+}
+
+void NoiseBackend::select(NoiseBackendType type)
+{
+	g_selected = type;
+}
+
+NoiseBackendType NoiseBackend::selected()
+{
+	return g_selected;
+}
+
+bool NoiseBackend::parse(const std::string &name, NoiseBackendType &out)
+{
+	if (name == "perlin")
+		out = NOISE_PERLIN;
+	else if (name == "opensimplex2" || name == "simplex")
+		out = NOISE_OPENSIMPLEX2;
+	else if (name == "value")
+		out = NOISE_VALUE;
+	else
+		return false;
+	return true;
+}
+
+const char *NoiseBackend::name(NoiseBackendType type)
+{
+	switch (type)
+	{
+		case NOISE_OPENSIMPLEX2:	return "opensimplex2";
+		case NOISE_VALUE:			return "value";
+		case NOISE_PERLIN:
+		default:					return "perlin";
+	}
+}
+
+void NoiseBackend::selectFromEnvironment()
+{
+	const char *noiseName = std::getenv("FT_VOX_NOISE");
+	if (!noiseName)
+		return;
+	NoiseBackendType type;
+	if (parse(noiseName, type))
+		select(type);
+	else
+		std::cerr << "Unknown FT_VOX_NOISE '" << noiseName << "', using "
+			<< name(selected()) << std::endl;
+}
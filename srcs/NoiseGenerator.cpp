@@ -1,4 +1,12 @@
 #include "NoiseGenerator.hpp"
+#include "MemoryGovernor.hpp"
+
+// Continentalness: Base terrain height with plateaux
+// Erosion: Erosion simili for somewhat smoothed out areas
+// Peaks: High height values for mountains and peaks generation
+const std::vector<Point> SplineData::continentalPoints = {{-1.0, -10.0}, {-0.4, -10.0}, {-0.3, 50.0}, {-0.1, 50.0}, {-0.05, 100.0}, {0, 100.0}, {0.1, 115}, {0.3, 125.0}, {1.0, 145.0}};
+const std::vector<Point> SplineData::erosionPoints = {{-1.0, 150.0}, {-0.8, 100.0}, {-0.5, 75.0}, {0.0, 25.0}, {0.3, 22.5}, {0.4, 20.0}, {0.5, 10.0}, {0.6, 15.0}, {0.7, 20.0}, {1.0, 10.0}};
+const std::vector<Point> SplineData::peaksPoints = {{-1.0, -15.0}, {-0.8, 25.0}, {-0.4, 75.0}, {0.0, 125.0}, {0.4, 225.0}, {1.0, 350.0}};
 
 NoiseGenerator::NoiseGenerator(size_t seed): _seed(seed)
 {
@@ -9,18 +17,11 @@ NoiseGenerator::NoiseGenerator(size_t seed): _seed(seed)
 	std::shuffle(p.begin(), p.end(), generator);
 	_permutation.resize(512);
 	for (int i = 0; i < 512; i++) _permutation[i] = p[i % 256];
+	_backend = NoiseBackend::create(static_cast<uint32_t>(seed), _permutation);
 
-	// Spline points of the height for each noise value (from -1.0 to 1.0)
-	// Continentalness: Base terrain height with plateaux
-	// Erosion: Erosion simili for somewhat smoothed out areas
-	// Peaks: High height values for mountains and peaks generation
-	std::vector<Point> continentalPoints = {{-1.0, -10.0}, {-0.4, -10.0}, {-0.3, 50.0}, {-0.1, 50.0}, {-0.05, 100.0}, {0, 100.0}, {0.1, 115}, {0.3, 125.0}, {1.0, 145.0}};
-	std::vector<Point> erosionPoints = {{-1.0, 150.0}, {-0.8, 100.0}, {-0.5, 75.0}, {0.0, 25.0}, {0.3, 22.5}, {0.4, 20.0}, {0.5, 10.0}, {0.6, 15.0}, {0.7, 20.0}, {1.0, 10.0}};
-	std::vector<Point> peaksPoints = {{-1.0, -15.0}, {-0.8, 25.0}, {-0.4, 75.0}, {0.0, 125.0}, {0.4, 225.0}, {1.0, 350.0}};
-
-	spline.continentalSpline.setPoints(continentalPoints);
-	spline.erosionSpline.setPoints(erosionPoints);
-	spline.peaksValleysSpline.setPoints(peaksPoints);
+	spline.continentalSpline.setPoints(SplineData::continentalPoints);
+	spline.erosionSpline.setPoints(SplineData::erosionPoints);
+	spline.peaksValleysSpline.setPoints(SplineData::peaksPoints);
 }
 
 NoiseGenerator::~NoiseGenerator()
@@ -34,21 +35,95 @@ void NoiseGenerator::setSeed(size_t seed)
 	_seed = seed;
 }
 
+void NoiseGenerator::setMemoryGovernor(MemoryGovernor *memGov)
+{
+	_memGov = memGov;
+}
+
+size_t NoiseGenerator::perlinMapBytes(const PerlinMap *map)
+{
+	if (!map)
+		return 0;
+	return sizeof(PerlinMap) + map->blockBytes;
+}
+
+void NoiseGenerator::PerlinMap::allocateBase()
+{
+	const size_t n = (size_t)size * (size_t)size;
+	// Heights first keeps both arrays naturally aligned
+	block.reset(new uint8_t[n * (sizeof(float) + sizeof(uint8_t))]());
+	heightMap = reinterpret_cast<float*>(block.get());
+	biomeMap = block.get() + n * sizeof(float);
+	blockBytes = n * (sizeof(float) + sizeof(uint8_t));
+}
+
+void NoiseGenerator::PerlinMap::setDecoration(bool withDecoration)
+{
+	const size_t n = (size_t)size * (size_t)size;
+	const size_t bytes = n * (sizeof(uint16_t) + 5 * sizeof(uint8_t));
+	if (withDecoration == (decoration != nullptr))
+		return;
+	treeMap = nullptr;
+	grassMap = flowerMask = flowerR = flowerY = flowerB = nullptr;
+	if (!withDecoration)
+	{
+		decoration.reset();
+		blockBytes -= bytes;
+		return;
+	}
+	decoration.reset(new uint8_t[bytes]());
+	uint8_t *cursor = decoration.get();
+	treeMap = reinterpret_cast<uint16_t*>(cursor);	cursor += n * sizeof(uint16_t);
+	grassMap = cursor;		cursor += n;
+	flowerMask = cursor;	cursor += n;
+	flowerR = cursor;		cursor += n;
+	flowerY = cursor;		cursor += n;
+	flowerB = cursor;
+	blockBytes += bytes;
+}
+
+void NoiseGenerator::acquireDecoration(PerlinMap *map)
+{
+	if (!map)
+		return;
+	std::lock_guard<std::mutex> lock(_perlinMutex);
+	if (map->decorationResolution != (int)map->resolution)
+	{
+		size_t oldBytes = perlinMapBytes(map);
+		map->setDecoration(true);
+		buildTreeMap(map, map->resolution);
+		buildPlantMaps(map, map->resolution);
+		map->decorationResolution = map->resolution;
+		if (_memGov)
+			_memGov->adjust(MEM_NOISE, oldBytes, perlinMapBytes(map));
+	}
+	map->decorationUsers++;
+}
+
+void NoiseGenerator::releaseDecoration(PerlinMap *map)
+{
+	if (!map)
+		return;
+	std::lock_guard<std::mutex> lock(_perlinMutex);
+	if (map->decorationUsers > 0 && --map->decorationUsers > 0)
+		return;
+	if (!map->treeMap)
+		return;
+	size_t oldBytes = perlinMapBytes(map);
+	map->setDecoration(false);
+	map->decorationResolution = 0;
+	if (_memGov)
+		_memGov->adjust(MEM_NOISE, oldBytes, perlinMapBytes(map));
+}
+
 void NoiseGenerator::clearPerlinMaps(void)
 {
 	for (auto &map : _perlinMaps)
 	{
-		if (map.second && map.second->heightMap)
-		{
-			delete [] map.second->heightMap;
-			map.second->heightMap = nullptr;
-		}
-		if (map.second && map.second->treeMap) { delete[] map.second->treeMap; map.second->treeMap = nullptr; }
-		if (map.second)
-		{
-			delete map.second;
-			map.second = nullptr;
-		}
+		if (_memGov)
+			_memGov->sub(MEM_NOISE, perlinMapBytes(map.second));
+		delete map.second;
+		map.second = nullptr;
 	}
 	_perlinMaps.clear();
 }
@@ -213,35 +288,77 @@ ivec2 NoiseGenerator::getBiomeBorderWarping(int x, int z)
 	return offset;
 }
 
-Biome NoiseGenerator::getBiome(ivec2 pos, double height)
+BiomeClimate NoiseGenerator::getBiomeClimate(ivec2 pos)
 {
 	// Domain warp to avoid grid-aligned borders for sampling
 	pos = getBiomeBorderWarping(pos.x, pos.y);
 
+	BiomeClimate climate;
 	// Base noises in [-1, 1]
-	double temp = getTemperatureNoise(pos);
-	double humidity = getHumidityNoise(pos);
-
-	// Add large-scale variation and physically-inspired biases
-// Elevation (cooler and drier with altitude)
-	double alt01 = std::clamp((height - (double)OCEAN_HEIGHT) / (double)(MOUNT_HEIGHT - OCEAN_HEIGHT), 0.0, 1.0);
+	climate.temp = getTemperatureNoise(pos);
+	climate.humidity = getHumidityNoise(pos);
 
 	// Latitudinal bands (very low frequency): use trigs to create belts
 	double latS = std::sin(pos.x * 0.00003);
 	double latC = std::cos(pos.y * 0.000008);
+	climate.latitude = (latS * 0.6) + (latC * 0.2);
 
 	// Continentalness: interiors tend to be drier
-	double continental = getContinentalNoise(pos); // [-1, 1]
+	climate.continental = getContinentalNoise(pos); // [-1, 1]
+	climate.belt = std::cos(pos.y * 0.00002) * 0.3; // tropical/rain belts
+	return climate;
+}
+
+void NoiseGenerator::biasedClimate(const BiomeClimate &climate, double height, double &temp, double &humidity)
+{
+	// Add large-scale variation and physically-inspired biases
+	// Elevation (cooler and drier with altitude)
+	double alt01 = std::clamp((height - (double)OCEAN_HEIGHT) / (double)(MOUNT_HEIGHT - OCEAN_HEIGHT), 0.0, 1.0);
 
 	// Apply biases
-	double tempBias = (latS * 0.6) + (latC * 0.2) - (alt01 * 0.8);
-	double humidBias = (-continental * 0.5)              // wetter near coasts (low continentalness)
+	double tempBias = climate.latitude - (alt01 * 0.8);
+	double humidBias = (-climate.continental * 0.5)       // wetter near coasts (low continentalness)
 						+ ((1.0 - alt01) * 0.2)             // more humidity at low elevations
-						+ (std::cos(pos.y * 0.00002) * 0.3); // tropical/rain belts
-
-	temp = std::clamp(temp + tempBias, -1.0, 1.0);
-	humidity = std::clamp(humidity + humidBias, -1.0, 1.0);
+						+ climate.belt;
+
+	temp = std::clamp(climate.temp + tempBias, -1.0, 1.0);
+	humidity = std::clamp(climate.humidity + humidBias, -1.0, 1.0);
+}
+
+// How far (largest of the temperature and humidity moves) a biased climate
+// is from one classifyBiome puts in another biome. The climate biomes as
+// (temp, humidity) boxes:
+//   DESERT  temp > 0.2, or 0 < temp <= 0.2 with humidity < -0.1
+//   SNOWY   temp <= -0.2
+//   FOREST  -0.2 < temp <= 0.2 with humidity > 0.55
+//   PLAINS  -0.2 < temp <= 0 with humidity <= 0.55, or 0 < temp <= 0.2
+//           with -0.1 <= humidity <= 0.55
+double NoiseGenerator::climateMargin(double temp, double humidity)
+{
+	struct Box { Biome biome; double t0, t1, h0, h1; };
+	static const Box boxes[] = {
+		{Biome::DESERT,  0.2,  1.0, -1.0,  1.0},
+		{Biome::DESERT,  0.0,  0.2, -1.0, -0.1},
+		{Biome::SNOWY,  -1.0, -0.2, -1.0,  1.0},
+		{Biome::FOREST, -0.2,  0.2,  0.55, 1.0},
+		{Biome::PLAINS, -0.2,  0.0, -1.0,  0.55},
+		{Biome::PLAINS,  0.0,  0.2, -0.1,  0.55},
+	};
+	const Biome biome = classifyClimate(temp, humidity);
+	double margin = 2.0;
+	for (const Box &box : boxes)
+	{
+		if (box.biome == biome)
+			continue;
+		const double dt = std::max({box.t0 - temp, temp - box.t1, 0.0});
+		const double dh = std::max({box.h0 - humidity, humidity - box.h1, 0.0});
+		margin = std::min(margin, std::max(dt, dh));
+	}
+	return margin;
+}
 
+Biome NoiseGenerator::classifyBiome(const BiomeClimate &climate, double height)
+{
 	// Height-gated biomes first
 	if (height >= MOUNT_HEIGHT)
 		return Biome::MOUNTAINS;
@@ -252,7 +369,14 @@ Biome NoiseGenerator::getBiome(ivec2 pos, double height)
 	if (height <= OCEAN_HEIGHT + 3)
 		return Biome::BEACH;
 
-	// Climate-driven biomes
+	double temp, humidity;
+	biasedClimate(climate, height, temp, humidity);
+	return classifyClimate(temp, humidity);
+}
+
+Biome NoiseGenerator::classifyClimate(double temp, double humidity)
+{
+	// Climate-driven biomes (boxes mirrored in climateMargin)
 	// Desert selection
 	// 1) High-temperature override tuned to observed range (max ~0.4)
 	//    Slightly hot (>=0.2) and moderately dry becomes desert
@@ -276,6 +400,63 @@ Biome NoiseGenerator::getBiome(ivec2 pos, double height)
 	return Biome::PLAINS;
 }
 
+Biome NoiseGenerator::getBiome(ivec2 pos, double height)
+{
+	// Height-gated biomes need no climate
+	if (height >= MOUNT_HEIGHT || height <= OCEAN_HEIGHT + 3)
+		return classifyBiome(BiomeClimate(), height);
+	return classifyBiome(getBiomeClimate(pos), height);
+}
+
+void NoiseGenerator::buildBiomeLattice(BiomeLattice &lattice, const PerlinMap *map, int resolution)
+{
+	// Coarse maps only sample lattice columns anyway
+	if (resolution >= BIOME_LATTICE || map->size % BIOME_LATTICE)
+	{
+		lattice.step = 0;
+		return;
+	}
+	lattice.step = BIOME_LATTICE;
+	lattice.count = map->size / BIOME_LATTICE + 1;
+	lattice.origin = map->position * map->size;
+	lattice.corners.resize((size_t)lattice.count * (size_t)lattice.count);
+	for (int cz = 0; cz < lattice.count; ++cz)
+		for (int cx = 0; cx < lattice.count; ++cx)
+			lattice.corners[cz * lattice.count + cx] = getBiomeClimate(lattice.origin + ivec2(cx, cz) * lattice.step);
+}
+
+// Biomes span hundreds of columns: when the climate at the four corners of
+// the column's lattice cell gives the same biome for this height, each at
+// least BIOME_LATTICE_MARGIN away from a threshold, the column is inside that
+// biome. Only cells near a border pay for exact noise.
+Biome NoiseGenerator::getLatticeBiome(const BiomeLattice &lattice, ivec2 pos, double height)
+{
+	if (lattice.step == 0)
+		return getBiome(pos, height);
+	// Height-gated biomes need no climate
+	if (height >= MOUNT_HEIGHT || height <= OCEAN_HEIGHT + 3)
+		return classifyBiome(BiomeClimate(), height);
+	const ivec2 local = pos - lattice.origin;
+	const int cx = local.x / lattice.step;
+	const int cz = local.y / lattice.step;
+	const BiomeClimate *row0 = &lattice.corners[cz * lattice.count + cx];
+	const BiomeClimate *row1 = row0 + lattice.count;
+	const BiomeClimate *corners[4] = {row0, row0 + 1, row1, row1 + 1};
+
+	Biome biome = Biome::PLAINS;
+	for (int i = 0; i < 4; ++i)
+	{
+		double temp, humidity;
+		biasedClimate(*corners[i], height, temp, humidity);
+		const Biome cornerBiome = classifyClimate(temp, humidity);
+		if (i == 0)
+			biome = cornerBiome;
+		if (cornerBiome != biome || climateMargin(temp, humidity) <= BIOME_LATTICE_MARGIN)
+			return getBiome(pos, height);
+	}
+	return biome;
+}
+
 double smoothBlend(double a, double b, double blendFactor)
 {
 	// Smoothstep
@@ -283,17 +464,14 @@ double smoothBlend(double a, double b, double blendFactor)
 	return a * (1.0 - blendFactor) + b * blendFactor;
 }
 
-double NoiseGenerator::getHeight(ivec2 pos)
+// Terrain noises of one column, before the spline lookups
+NoiseGenerator::HeightNoise NoiseGenerator::sampleHeightNoise(ivec2 pos)
 {
+	HeightNoise n;
 	pos = getBorderWarping(pos.x, pos.y);
-	double continentalNoise = getContinentalNoise(pos);
-	double surfaceHeight = spline.continentalSpline.interpolate(continentalNoise);
-	double erosionNoise = getErosionNoise(pos);
-	double erosionHeight = spline.erosionSpline.interpolate(erosionNoise);
-	double erosionMask = (erosionNoise + 1.0) * 0.5;
-	double peaksNoise = getPeaksValleysNoise(pos);
-	double peaksHeight = spline.peaksValleysSpline.interpolate(peaksNoise) * 1.8; // slightly reduce global peak scale
-	double peaksMask = (peaksNoise + 1.0) * 0.5;
+	n.continental = getContinentalNoise(pos);
+	n.erosion = getErosionNoise(pos);
+	n.peaks = getPeaksValleysNoise(pos);
 
 	// Large-scale "flatness" modulation to create occasional flatter regions
 	// Uses a very low-frequency noise field to locally damp erosion/peaks contributions
@@ -312,7 +490,17 @@ double NoiseGenerator::getHeight(ivec2 pos)
 	double flatSupp = flat01 * flat01 * (3.0 - 2.0 * flat01); // [0, 1]
 	// Only engage when very flat (top ~15%)
 	double gateT = std::clamp((flatSupp - 0.85) / 0.15, 0.0, 1.0);
-	double flatGate = gateT * gateT * (3.0 - 2.0 * gateT);
+	n.flatGate = gateT * gateT * (3.0 - 2.0 * gateT);
+	return n;
+}
+
+// Height from the column noises and their spline values
+double NoiseGenerator::blendHeight(const HeightNoise &n, double surfaceHeight, double erosionHeight, double peaksHeight)
+{
+	const double flatGate = n.flatGate;
+	double erosionMask = (n.erosion + 1.0) * 0.5;
+	double peaksMask = (n.peaks + 1.0) * 0.5;
+	peaksHeight *= 1.8; // slightly reduce global peak scale
 
 	// Suppress roughness only when gate is active
 	double erosionWeight = 1.0 - 0.65 * flatGate; // keep some erosion
@@ -344,6 +532,36 @@ double NoiseGenerator::getHeight(ivec2 pos)
 	return height;
 }
 
+double NoiseGenerator::getHeight(ivec2 pos)
+{
+	const HeightNoise n = sampleHeightNoise(pos);
+	return blendHeight(n, spline.continentalSpline.interpolate(n.continental),
+		spline.erosionSpline.interpolate(n.erosion),
+		spline.peaksValleysSpline.interpolate(n.peaks));
+}
+
+// getHeight over a run of columns, the spline lookups done in batch
+void NoiseGenerator::getHeights(const ivec2 *pos, double *heights, size_t count)
+{
+	std::vector<HeightNoise> samples(count);
+	std::vector<double> in(count), surface(count), erosion(count), peaks(count);
+	for (size_t i = 0; i < count; ++i)
+		samples[i] = sampleHeightNoise(pos[i]);
+
+	for (size_t i = 0; i < count; ++i)
+		in[i] = samples[i].continental;
+	spline.continentalSpline.interpolate(in.data(), surface.data(), count);
+	for (size_t i = 0; i < count; ++i)
+		in[i] = samples[i].erosion;
+	spline.erosionSpline.interpolate(in.data(), erosion.data(), count);
+	for (size_t i = 0; i < count; ++i)
+		in[i] = samples[i].peaks;
+	spline.peaksValleysSpline.interpolate(in.data(), peaks.data(), count);
+
+	for (size_t i = 0; i < count; ++i)
+		heights[i] = blendHeight(samples[i], surface[i], erosion[i], peaks[i]);
+}
+
 void NoiseGenerator::updatePerlinMapResolution(PerlinMap *map, int newResolution)
 {
 	if (!map || newResolution >= map->resolution)
@@ -351,18 +569,30 @@ void NoiseGenerator::updatePerlinMapResolution(PerlinMap *map, int newResolution
 
 	int oldResolution = map->resolution;
 	map->resolution = newResolution;
+	BiomeLattice lattice;
+	buildBiomeLattice(lattice, map, newResolution);
+	std::vector<ivec2> columns;
+	std::vector<double> heights;
 	for (int x = 0; x < map->size; x += newResolution)
 	{
+		columns.clear();
 		for (int z = 0; z < map->size; z += newResolution)
 		{
 			// If this point was already computed at the previous resolution, skip
 			if (x % oldResolution == 0 && z % oldResolution == 0)
 				continue;
+			columns.push_back({(map->position.x * map->size) + x, (map->position.y * map->size) + z});
+		}
+		heights.resize(columns.size());
+		getHeights(columns.data(), heights.data(), columns.size());
 
-			double height = getHeight({(map->position.x * map->size) + x, (map->position.y * map->size) + z});
-			Biome biome = getBiome({(map->position.x * map->size) + x, (map->position.y * map->size) + z}, height);
+		for (size_t i = 0; i < columns.size(); ++i)
+		{
+			const int z = columns[i].y - map->position.y * map->size;
+			double height = heights[i];
+			Biome biome = getLatticeBiome(lattice, columns[i], height);
 			map->heightMap[z * map->size + x] = height;
-			map->biomeMap[z * map->size + x] = biome;
+			map->biomeMap[z * map->size + x] = (uint8_t)biome;
 			if (height > map->heighest)
 				map->heighest = height;
 			if (height < map->lowest)
@@ -372,9 +602,13 @@ void NoiseGenerator::updatePerlinMapResolution(PerlinMap *map, int newResolution
 
 	map->resolution = newResolution;
 	_perlinMaps[map->position] = map;
-	// Rebuild downsampled plant maps for this resolution
-	buildTreeMap(map, newResolution);
-	buildPlantMaps(map, newResolution);
+	// Decoration maps are rebuilt at the new resolution by the next acquireDecoration
+	if (map->decorationUsers > 0)
+	{
+		buildTreeMap(map, newResolution);
+		buildPlantMaps(map, newResolution);
+		map->decorationResolution = newResolution;
+	}
 }
 
 
@@ -382,32 +616,40 @@ PerlinMap *NoiseGenerator::addPerlinMap(ivec2 &pos, int size, int resolution)
 {
 	PerlinMap *map = new PerlinMap();
 	map->size = size;
-	map->heightMap = new double[size * size];
-	map->biomeMap = new Biome[size * size];
+	map->allocateBase();
 	map->resolution = resolution;
 	map->position = pos;
 	map->heighest = 0;
 	map->lowest = 2048;
 
+	BiomeLattice lattice;
+	buildBiomeLattice(lattice, map, resolution);
+	std::vector<ivec2> columns;
+	std::vector<double> heights((size + resolution - 1) / resolution);
 	for (int x = 0; x < size; x += resolution)
 	{
+		columns.clear();
+		for (int z = 0; z < size; z += resolution)
+			columns.push_back({(pos.x * size) + x, (pos.y * size) + z});
+		getHeights(columns.data(), heights.data(), columns.size());
+
 		for (int z = 0; z < size; z += resolution)
 		{
 			int index = z * size + x;
-			double height = getHeight({(pos.x * size) + x, (pos.y * size) + z});
-			Biome biome = getBiome({(map->position.x * map->size) + x, (map->position.y * map->size) + z}, height);
-				
-			map->heightMap[index] = height;
-			map->biomeMap[index] = biome;
-			if (map->heightMap[index] > map->heighest)
-				map->heighest = map->heightMap[index];
-			if (map->heightMap[index] < map->lowest)
-				map->lowest = map->heightMap[index];
+			double height = heights[z / resolution];
+			Biome biome = getLatticeBiome(lattice, columns[z / resolution], height);
+
+			map->heightMap[index] = (float)height;
+			map->biomeMap[index] = (uint8_t)biome;
+			if (height > map->heighest)
+				map->heighest = height;
+			if (height < map->lowest)
+				map->lowest = height;
 		}
 	}
-	buildTreeMap(map, resolution);
-	buildPlantMaps(map, resolution);
 	_perlinMaps[pos] = map;
+	if (_memGov)
+		_memGov->add(MEM_NOISE, perlinMapBytes(map));
 	return (map);
 }
 
@@ -419,17 +661,9 @@ void NoiseGenerator::removePerlinMap(int x, int z)
 	if (it != itend)
 	{
 		PerlinMap *map = (*it).second;
-		if (map && map->heightMap)
-		{
-			delete [] map->heightMap;
-			map->heightMap = nullptr;
-		}
-		if (map && map->treeMap) { delete[] map->treeMap; map->treeMap = nullptr; }
-		if (map)
-		{
-			delete map;
-			map = nullptr;
-		}
+		if (_memGov)
+			_memGov->sub(MEM_NOISE, perlinMapBytes(map));
+		delete map;
 		_perlinMaps.erase({x, z});
 	}
 }
@@ -468,41 +702,7 @@ double NoiseGenerator::noise(double x, double y) const
 
 double NoiseGenerator::singleNoise(double x, double y) const
 {
-	int X = (int)std::floor(x) & 255;
-	int Y = (int)std::floor(y) & 255;
-
-	x -= std::floor(x);
-	y -= std::floor(y);
-
-	double u = fade(x);
-	double v = fade(y);
-
-	int A = _permutation[X] + Y;
-	int B = _permutation[X + 1] + Y;
-
-	return lerp(
-		lerp(grad(_permutation[A], x, y), grad(_permutation[B], x - 1, y), u),
-		lerp(grad(_permutation[A + 1], x, y - 1), grad(_permutation[B + 1], x - 1, y - 1), u),
-		v
-	);
-}
-
-double NoiseGenerator::fade(double t) const
-{
-	return t * t * t * (t * (t * 6 - 15) + 10);
-}
-
-double NoiseGenerator::lerp(double a, double b, double t) const
-{
-	return a + t * (b - a);
-}
-
-double NoiseGenerator::grad(int hash, double x, double y) const
-{
-	int h = hash & 3; // Only 4 gradients
-	double u = h < 2 ? x : y;
-	double v = h < 2 ? y : x;
-	return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+	return _backend->noise(x, y);
 }
 
 double NoiseGenerator::getTreeNoise(ivec2 pos)
@@ -528,15 +728,14 @@ double NoiseGenerator::getTreeProbability(ivec2 pos)
 
 void NoiseGenerator::buildTreeMap(PerlinMap* map, int resolution)
 {
-	if (!map) return;
-	if (!map->treeMap) map->treeMap = new double[map->size * map->size];
+	if (!map || !map->treeMap) return;
 
 	for (int x = 0; x < map->size; x += resolution)
 	for (int z = 0; z < map->size; z += resolution)
 	{
 		ivec2 worldXZ = { map->position.x * map->size + x,
 							map->position.y * map->size + z };
-		map->treeMap[z * map->size + x] = getTreeProbability(worldXZ);
+		map->treeMap[z * map->size + x] = PerlinMap::toUnorm16(getTreeProbability(worldXZ));
 	}
 }
 
@@ -592,13 +791,8 @@ double NoiseGenerator::getFlowerClusterNoise(ivec2 pos, int channel)
 
 void NoiseGenerator::buildPlantMaps(PerlinMap* map, int resolution)
 {
-	if (!map) return;
+	if (!map || !map->grassMap) return;
 	int size = map->size;
-	if (!map->grassMap)   map->grassMap   = new double[size * size];
-	if (!map->flowerMask) map->flowerMask = new double[size * size];
-	if (!map->flowerR)    map->flowerR    = new double[size * size];
-	if (!map->flowerY)    map->flowerY    = new double[size * size];
-	if (!map->flowerB)    map->flowerB    = new double[size * size];
 
 	for (int x = 0; x < size; x += resolution)
 	for (int z = 0; z < size; z += resolution)
@@ -606,11 +800,11 @@ void NoiseGenerator::buildPlantMaps(PerlinMap* map, int resolution)
 		ivec2 worldXZ = { map->position.x * size + x,
 						  map->position.y * size + z };
 		// Normalize noises to [0,1]
-		double g  = 0.5 * (getGrassNoise(worldXZ) + 1.0);
-		double fb = 0.5 * (getFlowerBaseNoise(worldXZ) + 1.0);
-		double r  = 0.5 * (getFlowerClusterNoise(worldXZ, 0) + 1.0);
-		double y  = 0.5 * (getFlowerClusterNoise(worldXZ, 1) + 1.0);
-		double b  = 0.5 * (getFlowerClusterNoise(worldXZ, 2) + 1.0);
+		uint8_t g  = PerlinMap::toUnorm8(0.5 * (getGrassNoise(worldXZ) + 1.0));
+		uint8_t fb = PerlinMap::toUnorm8(0.5 * (getFlowerBaseNoise(worldXZ) + 1.0));
+		uint8_t r  = PerlinMap::toUnorm8(0.5 * (getFlowerClusterNoise(worldXZ, 0) + 1.0));
+		uint8_t y  = PerlinMap::toUnorm8(0.5 * (getFlowerClusterNoise(worldXZ, 1) + 1.0));
+		uint8_t b  = PerlinMap::toUnorm8(0.5 * (getFlowerClusterNoise(worldXZ, 2) + 1.0));
 
 		map->grassMap[z * size + x]   = g;
 		map->flowerMask[z * size + x] = fb;
@@ -14,62 +14,47 @@ void Player::updateNow(std::chrono::steady_clock::time_point &now)
 	_now = now;
 }
 
+// Decorative plants never block movement
+static inline bool isPassable(BlockType b)
+{
+	return (b == AIR || b == WATER || b == FLOWER_POPPY || b == FLOWER_DANDELION || b == FLOWER_CYAN || b == FLOWER_SHORT_GRASS || b == FLOWER_DEAD_BUSH);
+}
+
 void Player::updatePlayerStates()
 {
 	if (_gravity)
 	{
 		vec3 worldPos = _cam.getWorldPosition();
-		BlockType camStandingBlock = AIR;
-		BlockType camBodyBlockLegs = AIR;
-		BlockType camBodyBlockTorso = AIR;
-	
-		// Compute world integer cell first
+
+		// One read of everything this tick's fall and walk can touch
+		const vec3 walk = worldDelta(vec3(_moveSpeed, 0.0f, _moveSpeed));
+		const vec3 fall = worldDelta(vec3(0.0f, std::abs(_fallSpeed * _deltaTime) + _moveSpeed, 0.0f));
+		snapshotAround(worldPos, glm::abs(vec3(walk.x, fall.y, walk.z)), true);
+
 		int worldX = static_cast<int>(std::floor(worldPos.x));
 		int worldZ = static_cast<int>(std::floor(worldPos.z));
-	
-		// Derive chunk strictly from the integer world cell to avoid float-boundary mismatches
-		ivec2 chunkPos = {
-			static_cast<int>(std::floor(static_cast<float>(worldX) / static_cast<float>(CHUNK_SIZE))),
-			static_cast<int>(std::floor(static_cast<float>(worldZ) / static_cast<float>(CHUNK_SIZE)))};
-	
+
 		// Compute foot cell from eye height
 		int footCell = static_cast<int>(std::floor(worldPos.y - EYE_HEIGHT + EPS));
-		// int footSubY = static_cast<int>(std::floor(static_cast<float>(footCell) / static_cast<float>(CHUNK_SIZE)));
-	
-		// If the destination chunk or the needed subchunk is not yet loaded, avoid updating
-		// ground/physics to prevent erroneous falling while streaming catches up.
-		// if (Chunk* c = _chunkMgr.getChunk(chunkPos); c == nullptr || c->getSubChunk(std::max(0, footSubY)) == nullptr)
-		// 	return;
-	
-		_camTopBlock = _chunkMgr.findBlockUnderPlayer(chunkPos, {worldX, static_cast<int>(std::floor(worldPos.y)), worldZ});
-		camStandingBlock = _chunkMgr.getBlock(chunkPos, {worldX, footCell - 1, worldZ});
-		camBodyBlockLegs = _chunkMgr.getBlock(chunkPos, {worldX, footCell, worldZ});
-		camBodyBlockTorso = _chunkMgr.getBlock(chunkPos, {worldX, footCell + 1, worldZ});
-	
+
+		_camTopBlock = groundUnder(worldPos);
+		BlockType camStandingBlock = _snapshot.at(worldX, footCell - 1, worldZ);
+		BlockType camBodyBlockLegs = _snapshot.at(worldX, footCell, worldZ);
+		BlockType camBodyBlockTorso = _snapshot.at(worldX, footCell + 1, worldZ);
+
 		// Consider underwater slightly sooner by biasing eye sample downward
 		const float eyeBias = 0.10f;
 		int eyeCellY = static_cast<int>(std::floor(worldPos.y - eyeBias));
-		BlockType camHeadBlock = _chunkMgr.getBlock(chunkPos, {worldX, eyeCellY, worldZ});
-		_isUnderWater = (camHeadBlock == WATER);
-	
-		// Body blocks states debug
-		// std::cout << '[' << camStandingBlock << ']' << std::endl;
-		// std::cout << '[' << camBodyBlockLegs << ']' << std::endl;
-		// std::cout << '[' << camBodyBlockTorso << ']' << std::endl;
-	
+		_isUnderWater = (_snapshot.at(worldX, eyeCellY, worldZ) == WATER);
+
 		BlockType inWater = (camStandingBlock == WATER || camBodyBlockLegs == WATER || camBodyBlockTorso == WATER) ? WATER : AIR;
-	
-		BlockType camBodyOverHead = AIR;
+
 		_ascending = _fallSpeed > 0.0;
-		if (_ascending)
+		if (_ascending && sweepAxis(worldPos, 1, 1.0f) < 1.0f - EPS)
 		{
-			// Ceiling check
-			camBodyOverHead = _chunkMgr.getBlock(chunkPos, {worldX, footCell + 2, worldZ});
-			if (camBodyOverHead != WATER && camBodyOverHead != AIR)
-			{
-				_falling = false;
-				_fallSpeed = 0.0;
-			}
+			// Ceiling within a block above the head
+			_falling = false;
+			_fallSpeed = 0.0;
 		}
 		updateFalling(worldPos, _camTopBlock.height);
 		updateSwimming(inWater);
@@ -80,70 +65,133 @@ void Player::updatePlayerStates()
 		vec3 worldPos = _cam.getWorldPosition();
 		int worldX = static_cast<int>(std::floor(worldPos.x));
 		int worldZ = static_cast<int>(std::floor(worldPos.z));
-		ivec2 chunkPos = {
-			static_cast<int>(std::floor(static_cast<float>(worldX) / static_cast<float>(CHUNK_SIZE))),
-			static_cast<int>(std::floor(static_cast<float>(worldZ) / static_cast<float>(CHUNK_SIZE)))};
 		const float eyeBias = 0.30f;
 		int eyeCellY = static_cast<int>(std::floor(worldPos.y - eyeBias));
-		BlockType camHeadBlock = _chunkMgr.getBlock(chunkPos, {worldX, eyeCellY, worldZ});
+		BlockType camHeadBlock = _chunkMgr.makeQuery().getBlock({worldX, eyeCellY, worldZ});
 		_isUnderWater = (camHeadBlock == WATER);
 	}
 }
 
-bool Player::canMove(const glm::vec3& offset, float extra)
+// World-space displacement of a camera move (the camera stores the negated position)
+vec3 Player::worldDelta(const vec3 &offset)
 {
-	glm::vec3 probe = offset;
-	if (glm::length(probe) > 0.0f)
-		probe = glm::normalize(probe) * (glm::length(probe) + extra);
-
-	vec3 nextCamPos = _cam.moveCheck(probe);
-	float nextEyeY = -nextCamPos.y;
-	int footCell = static_cast<int>(std::floor(nextEyeY - EYE_HEIGHT + EPS));
-	int worldX = static_cast<int>(std::floor(-nextCamPos.x));
-	int worldZ = static_cast<int>(std::floor(-nextCamPos.z));
-	ivec3 worldPosFeet = {worldX, footCell, worldZ};
-	ivec3 worldPosTorso = {worldX, footCell + 1, worldZ};
-
-	// Derive chunk from integer world cell to avoid float-boundary errors
-	ivec2 chunkPos = {
-		static_cast<int>(std::floor(static_cast<float>(worldX) / static_cast<float>(CHUNK_SIZE))),
-		static_cast<int>(std::floor(static_cast<float>(worldZ) / static_cast<float>(CHUNK_SIZE)))};
-
-	// Check both the block in front of the legs and the upper body
-	BlockType blockFeet = _chunkMgr.getBlock(chunkPos, worldPosFeet);
-	BlockType blockTorso = _chunkMgr.getBlock(chunkPos, worldPosTorso);
-	auto passable = [](BlockType b)
-	{
-		return (b == AIR || b == WATER || b == FLOWER_POPPY || b == FLOWER_DANDELION || b == FLOWER_CYAN || b == FLOWER_SHORT_GRASS || b == FLOWER_DEAD_BUSH);
-	};
-	return (passable(blockFeet) && passable(blockTorso));
+	return _cam.getPosition() - _cam.moveCheck(offset);
 }
 
-// Divides every move into smaller steps if necessary typically if the player goes very
-// fast to avoid block skips
-bool Player::tryMoveStepwise(const glm::vec3 &moveVec, float stepSize)
+bool Player::VoxelSnapshot::contains(const ivec3 &mn, const ivec3 &mx) const
 {
-	// Total distance to move
-	float distance = glm::length(moveVec);
-	if (distance <= 0.0f)
-		return false;
+	return mn.x >= origin.x && mn.y >= origin.y && mn.z >= origin.z
+		&& mx.x < origin.x + size.x && mx.y < origin.y + size.y && mx.z < origin.z + size.z;
+}
 
-	// Normalize and scale to step size
-	glm::vec3 direction = glm::normalize(moveVec);
-	float moved = 0.0f;
+BlockType Player::VoxelSnapshot::at(int x, int y, int z) const
+{
+	x -= origin.x;
+	y -= origin.y;
+	z -= origin.z;
+	if (x < 0 || y < 0 || z < 0 || x >= size.x || y >= size.y || z >= size.z)
+		return AIR;
+	return cells[(size_t)x + (size_t)z * (size_t)size.x + (size_t)y * (size_t)size.x * (size_t)size.z];
+}
 
-	while (moved < distance)
-	{
-		float step = std::min(stepSize, distance - moved);
-		glm::vec3 offset = direction * step;
+// Player box swept by `reach` on each axis, plus the ground probe below the feet
+void Player::snapshotAround(const vec3 &eyePos, const vec3 &reach, bool force)
+{
+	const float feet = eyePos.y - EYE_HEIGHT;
+	const ivec3 mn(
+		static_cast<int>(std::floor(eyePos.x - PLAYER_HALF_WIDTH - reach.x)) - 1,
+		std::max(0, static_cast<int>(std::floor(feet - reach.y)) - PLAYER_SNAPSHOT_DEPTH),
+		static_cast<int>(std::floor(eyePos.z - PLAYER_HALF_WIDTH - reach.z)) - 1);
+	const ivec3 mx(
+		static_cast<int>(std::floor(eyePos.x + PLAYER_HALF_WIDTH + reach.x)) + 1,
+		std::max(0, static_cast<int>(std::floor(feet + PLAYER_HEIGHT + reach.y)) + 2),
+		static_cast<int>(std::floor(eyePos.z + PLAYER_HALF_WIDTH + reach.z)) + 1);
+	if (!force && _snapshot.contains(mn, mx))
+		return;
 
-		if (!canMove(offset, 0.04f))
-			return false;
+	_snapshot.origin = mn;
+	_snapshot.size = mx - mn + 1;
+	_snapshot.cells.resize((size_t)_snapshot.size.x * (size_t)_snapshot.size.y * (size_t)_snapshot.size.z);
+	BlockQuery query = _chunkMgr.makeQuery();
+	query.readRegion(_snapshot.origin, _snapshot.size, _snapshot.cells.data());
+}
 
-		_cam.move(offset);
-		moved += step;
+bool Player::isSolidAt(int x, int y, int z) const
+{
+	return !isPassable(_snapshot.at(x, y, z));
+}
+
+// Highest solid block strictly below the eye cell, over the whole footprint.
+// Without one inside the snapshot the ground is reported out of this tick's reach.
+TopBlock Player::groundUnder(const vec3 &eyePos) const
+{
+	const int x0 = static_cast<int>(std::floor(eyePos.x - PLAYER_HALF_WIDTH + EPS));
+	const int x1 = static_cast<int>(std::floor(eyePos.x + PLAYER_HALF_WIDTH - EPS));
+	const int z0 = static_cast<int>(std::floor(eyePos.z - PLAYER_HALF_WIDTH + EPS));
+	const int z1 = static_cast<int>(std::floor(eyePos.z + PLAYER_HALF_WIDTH - EPS));
+	const int bottom = _snapshot.origin.y;
+
+	for (int y = static_cast<int>(std::floor(eyePos.y)) - 1; y >= bottom; --y)
+		for (int z = z0; z <= z1; ++z)
+			for (int x = x0; x <= x1; ++x)
+				if (isSolidAt(x, y, z))
+					return {y, _snapshot.at(x, y, z), {x, z}};
+	if (bottom <= 0)
+		return TopBlock();
+	return {bottom - 2, AIR, {0, 0}};
+}
+
+// Longest part of `delta` (world units, along one axis) the player box can
+// travel before touching a solid cell. Cells already overlapped are ignored.
+float Player::sweepAxis(const vec3 &eyePos, int axis, float delta) const
+{
+	if (delta == 0.0f)
+		return 0.0f;
+
+	const vec3 mn(eyePos.x - PLAYER_HALF_WIDTH, eyePos.y - EYE_HEIGHT, eyePos.z - PLAYER_HALF_WIDTH);
+	const vec3 mx(eyePos.x + PLAYER_HALF_WIDTH, mn.y + PLAYER_HEIGHT, eyePos.z + PLAYER_HALF_WIDTH);
+	const float gap = 1e-3f;
+
+	// Cells the box covers on the two other axes
+	ivec3 lo(0), hi(0);
+	for (int a = 0; a < 3; ++a)
+	{
+		lo[a] = static_cast<int>(std::floor(mn[a] + EPS));
+		hi[a] = static_cast<int>(std::floor(mx[a] - EPS));
+	}
+	auto slabBlocked = [&](int c) {
+		ivec3 cell(0);
+		cell[axis] = c;
+		const int u = (axis == 0) ? 1 : 0;
+		const int v = (axis == 2) ? 1 : 2;
+		for (int i = lo[u]; i <= hi[u]; ++i)
+			for (int j = lo[v]; j <= hi[v]; ++j)
+			{
+				cell[u] = i;
+				cell[v] = j;
+				if (isSolidAt(cell.x, cell.y, cell.z))
+					return true;
+			}
+		return false;
+	};
+
+	if (delta > 0.0f)
+	{
+		const int first = static_cast<int>(std::floor(mx[axis] - gap)) + 1;
+		const int last = static_cast<int>(std::floor(mx[axis] + delta));
+		for (int c = first; c <= last; ++c)
+			if (slabBlocked(c))
+				return std::max(0.0f, std::min(delta, float(c) - mx[axis] - gap));
+	}
+	else
+	{
+		const int first = static_cast<int>(std::floor(mn[axis] + gap)) - 1;
+		const int last = static_cast<int>(std::floor(mn[axis] + delta));
+		for (int c = first; c >= last; --c)
+			if (slabBlocked(c))
+				return std::min(0.0f, std::max(delta, float(c + 1) - mn[axis] + gap));
 	}
-	return true;
+	return delta;
 }
 
 void Player::initPlayerStates()
@@ -299,18 +347,22 @@ void Player::updateMovement()
 
 	if (_gravity)
 	{
-		float stepSize = 0.5f;
-
-		glm::vec3 moveX(moveVec.x, 0.0f, 0.0f);
-		glm::vec3 moveZ(0.0f, 0.0f, moveVec.z);
-		glm::vec3 moveY(0.0f, moveVec.y, 0.0f);
-
-		if (moveX.x != 0.0f)
-			tryMoveStepwise(moveX, stepSize);
-		if (moveZ.z != 0.0f)
-			tryMoveStepwise(moveZ, stepSize);
-		if (moveY.y != 0.0f)
-			tryMoveStepwise(moveY, stepSize);
+		const vec3 want = worldDelta(moveVec);
+		snapshotAround(_cam.getWorldPosition(), glm::abs(want), false);
+
+		// Swept box, one axis at a time (X, Z, then Y) so walls slide
+		const int order[3] = {0, 2, 1};
+		for (int axis : order)
+		{
+			if (want[axis] == 0.0f)
+				continue;
+			const float got = sweepAxis(_cam.getWorldPosition(), axis, want[axis]);
+			if (got == 0.0f)
+				continue;
+			vec3 offset(0.0f);
+			offset[axis] = moveVec[axis] * (got / want[axis]);
+			_cam.move(offset);
+		}
 	}
 	else
 		_cam.move(moveVec);
@@ -329,6 +381,8 @@ bool Player::updatePlacing()
 		_placeCooldown = _now + std::chrono::milliseconds(150);
 		if (placed)
 		{
+			// The snapshot no longer matches the world
+			_snapshot.size = ivec3(0);
 			return true;
 		}
 	}
@@ -3,6 +3,11 @@
 Raycaster::Raycaster(ChunkLoader &chunkLoader, Camera &camera) : _chunkLoader(chunkLoader), _camera(camera) { }
 Raycaster::~Raycaster() { }
 
+static inline int floor_div(int a, int b) {
+	int q = a / b, r = a % b;
+	return (r && ((r < 0) != (b < 0))) ? (q - 1) : q;
+}
+
 static inline bool isSolidDeletable(BlockType b) {
 	// Flowers are deletable but non-solid in physics; still considered here
 	return (b != AIR && b != WATER && b != BEDROCK);
@@ -40,24 +45,51 @@ static inline bool flowerPlaceCondition(BlockType support, BlockType placing)
 	);
 }
 
-bool Raycaster::raycastHit(const glm::vec3& originWorld,
-						const glm::vec3& dirWorld,
-						float maxDistance,
-						glm::ivec3& outBlock)
+// Queue the cactus column starting at `cur` for removal (reads the world
+// before the batch is committed)
+static void queueCactusColumn(BlockQuery &query, glm::ivec3 cur, EditBatch &batch)
+{
+	while (query.getBlock(cur) == CACTUS && batch.set(cur, AIR))
+		cur.y += 1;
+}
+
+Raycaster::ChunkCache::~ChunkCache()
+{
+	for (auto &kv : chunks)
+		if (kv.second) kv.second->unpin();
+}
+
+SubChunk *Raycaster::lookupSubChunk(ChunkCache &cache, const glm::ivec3 &key)
+{
+	if (cache.hasLast && cache.lastKey == key)
+		return cache.last;
+	const ivec2 cpos(key.x, key.z);
+	auto it = cache.chunks.find(cpos);
+	if (it == cache.chunks.end())
+		it = cache.chunks.emplace(cpos, _chunkLoader.pinChunk(cpos)).first;
+	cache.last = (it->second && key.y >= 0) ? it->second->getSubChunk(key.y) : nullptr;
+	cache.lastKey = key;
+	cache.hasLast = true;
+	return cache.last;
+}
+
+RayHit Raycaster::march(const RayQuery &ray, ChunkCache &cache)
 {
-	if (maxDistance <= 0.0f) return false;
+	RayHit out;
+	if (ray.maxDistance <= 0.0f) return out;
 
-	glm::vec3 dir = dirWorld;
+	glm::vec3 dir = ray.dir;
 	float dlen = glm::length(dir);
-	if (dlen < 1e-8f) return false;
+	if (dlen < 1e-8f) return out;
 	dir /= dlen;
 
-	glm::vec3 ro = originWorld + dir * 0.001f; // nudge
+	glm::vec3 ro = ray.origin + dir * 0.001f; // nudge
 	glm::ivec3 voxel(
 		(int)std::floor(ro.x),
 		(int)std::floor(ro.y),
 		(int)std::floor(ro.z)
 	);
+	glm::ivec3 prev = voxel;
 
 	glm::ivec3 step(
 		(dir.x > 0.f) ? 1 : (dir.x < 0.f) ? -1 : 0,
@@ -84,10 +116,11 @@ bool Raycaster::raycastHit(const glm::vec3& originWorld,
 	);
 
 	float t = 0.0f;
+	int steps = 0;
 	const int MAX_STEPS = 512;
 
-	for (int i = 0; i < MAX_STEPS; ++i) {
-		// step to next voxel
+	auto advance = [&]() {
+		prev = voxel;
 		if (tMaxV.x < tMaxV.y) {
 			if (tMaxV.x < tMaxV.z)	{ voxel.x += step.x; t = tMaxV.x; tMaxV.x += tDelta.x; }
 			else					{ voxel.z += step.z; t = tMaxV.z; tMaxV.z += tDelta.z; }
@@ -95,89 +128,143 @@ bool Raycaster::raycastHit(const glm::vec3& originWorld,
 			if (tMaxV.y < tMaxV.z)	{ voxel.y += step.y; t = tMaxV.y; tMaxV.y += tDelta.y; }
 			else					{ voxel.z += step.z; t = tMaxV.z; tMaxV.z += tDelta.z; }
 		}
-		if (t > maxDistance) return false;
+		++steps;
+	};
 
-		ivec2 chunkPos(
-			(int)std::floor((float)voxel.x / (float)CHUNK_SIZE),
-			(int)std::floor((float)voxel.z / (float)CHUNK_SIZE)
-		);
-		BlockType b = _chunkLoader.getBlock(chunkPos, voxel);
-		if (isSolidDeletable(b)) {
-			outBlock = voxel;
-			return true;
+	// Move to the first voxel past the subchunk at `base` in one go: the
+	// exit crossing is the earliest one that leaves the box on its axis,
+	// every other axis takes the crossings that come before it
+	auto jumpOut = [&](const glm::ivec3 &base) {
+		int exitAxis = -1;
+		float tExit = INF;
+		glm::ivec3 toLeave(0);
+		for (int a = 0; a < 3; ++a)
+		{
+			if (step[a] == 0) continue;
+			toLeave[a] = (step[a] > 0) ? (base[a] + CHUNK_SIZE - voxel[a]) : (voxel[a] - base[a] + 1);
+			const float ta = tMaxV[a] + float(toLeave[a] - 1) * tDelta[a];
+			if (ta < tExit) { tExit = ta; exitAxis = a; }
 		}
+		if (exitAxis < 0)
+		{
+			t = INF;
+			return;
+		}
+		for (int a = 0; a < 3; ++a)
+		{
+			int k = 0;
+			if (a == exitAxis)
+				k = toLeave[a];
+			else if (step[a] != 0 && tExit > tMaxV[a])
+				k = std::min(toLeave[a] - 1, (int)std::ceil((tExit - tMaxV[a]) / tDelta[a]));
+			voxel[a] += step[a] * k;
+			tMaxV[a] += tDelta[a] * float(k);
+		}
+		prev = voxel;
+		prev[exitAxis] -= step[exitAxis];
+		t = tExit;
+		++steps;
+	};
+
+	advance();
+	while (steps < MAX_STEPS && t <= ray.maxDistance)
+	{
+		const glm::ivec3 key(
+			floor_div(voxel.x, CHUNK_SIZE),
+			floor_div(voxel.y, CHUNK_SIZE),
+			floor_div(voxel.z, CHUNK_SIZE)
+		);
+		const glm::ivec3 base = key * CHUNK_SIZE;
+		bool stop = false;
+
+		auto walk = [&](const uint8_t *blocks, int chunkSize, int resolution, int occupied) {
+			if (!blocks || chunkSize <= 0 || occupied == 0)
+			{
+				jumpOut(base);
+				return;
+			}
+			const size_t plane = static_cast<size_t>(chunkSize) * static_cast<size_t>(chunkSize);
+			while (true)
+			{
+				const glm::ivec3 l = (voxel - base) / resolution;
+				const BlockType b = (BlockType)blocks[static_cast<size_t>(l.x)
+					+ static_cast<size_t>(l.z) * static_cast<size_t>(chunkSize)
+					+ static_cast<size_t>(l.y) * plane];
+				if (b != AIR && b != WATER)
+				{
+					out.hit = true;
+					out.block = b;
+					out.voxel = voxel;
+					out.prev = prev;
+					out.distance = t;
+					stop = true;
+					return;
+				}
+				if (steps >= MAX_STEPS) return;
+				advance();
+				if (t > ray.maxDistance) return;
+				const glm::ivec3 d = voxel - base;
+				if (d.x < 0 || d.y < 0 || d.z < 0 || d.x >= CHUNK_SIZE || d.y >= CHUNK_SIZE || d.z >= CHUNK_SIZE)
+					return;
+			}
+		};
+		if (SubChunk *sc = lookupSubChunk(cache, key))
+			sc->withBlocks(walk);
+		else
+			walk(nullptr, 0, 1, 0);
+		if (stop)
+			return out;
 	}
-	return false;
+	return out;
 }
 
-BlockType Raycaster::raycastHitFetch(const glm::vec3& originWorld,
+void Raycaster::raycastBatch(const std::vector<RayQuery> &rays, std::vector<RayHit> &out)
+{
+	out.assign(rays.size(), RayHit());
+
+	// Rays leaving from the same subchunk run back to back
+	std::vector<std::pair<glm::ivec3, size_t>> order;
+	order.reserve(rays.size());
+	for (size_t i = 0; i < rays.size(); ++i)
+	{
+		const glm::ivec3 v(glm::floor(rays[i].origin));
+		order.emplace_back(glm::ivec3(
+			floor_div(v.x, CHUNK_SIZE),
+			floor_div(v.y, CHUNK_SIZE),
+			floor_div(v.z, CHUNK_SIZE)), i);
+	}
+	std::sort(order.begin(), order.end(), [](const auto &a, const auto &b) {
+		if (a.first.x != b.first.x) return a.first.x < b.first.x;
+		if (a.first.z != b.first.z) return a.first.z < b.first.z;
+		if (a.first.y != b.first.y) return a.first.y < b.first.y;
+		return a.second < b.second;
+	});
+
+	ChunkCache cache;
+	for (const auto &entry : order)
+		out[entry.second] = march(rays[entry.second], cache);
+}
+
+bool Raycaster::raycastHit(const glm::vec3& originWorld,
 						const glm::vec3& dirWorld,
 						float maxDistance,
 						glm::ivec3& outBlock)
 {
-	if (maxDistance <= 0.0f) return AIR;
-
-	glm::vec3 dir = dirWorld;
-	float dlen = glm::length(dir);
-	if (dlen < 1e-8f) return AIR;
-	dir /= dlen;
-
-	glm::vec3 ro = originWorld + dir * 0.001f; // nudge
-	glm::ivec3 voxel(
-		(int)std::floor(ro.x),
-		(int)std::floor(ro.y),
-		(int)std::floor(ro.z)
-	);
-
-	glm::ivec3 step(
-		(dir.x > 0.f) ? 1 : (dir.x < 0.f) ? -1 : 0,
-		(dir.y > 0.f) ? 1 : (dir.y < 0.f) ? -1 : 0,
-		(dir.z > 0.f) ? 1 : (dir.z < 0.f) ? -1 : 0
-	);
-
-	const float INF = std::numeric_limits<float>::infinity();
-	glm::vec3 tDelta(
-		(step.x != 0) ? 1.0f / std::abs(dir.x) : INF,
-		(step.y != 0) ? 1.0f / std::abs(dir.y) : INF,
-		(step.z != 0) ? 1.0f / std::abs(dir.z) : INF
-	);
-
-	auto firstBoundaryT = [&](float r, int v, int s, float d) -> float {
-		if (s > 0) return ((float(v) + 1.0f) - r) / d;
-		if (s < 0) return (r - float(v)) / -d;
-		return INF;
-	};
-	glm::vec3 tMaxV(
-		firstBoundaryT(ro.x, voxel.x, step.x, dir.x),
-		firstBoundaryT(ro.y, voxel.y, step.y, dir.y),
-		firstBoundaryT(ro.z, voxel.z, step.z, dir.z)
-	);
-
-	float t = 0.0f;
-	const int MAX_STEPS = 512;
-
-	for (int i = 0; i < MAX_STEPS; ++i) {
-		// step to next voxel
-		if (tMaxV.x < tMaxV.y) {
-			if (tMaxV.x < tMaxV.z)	{ voxel.x += step.x; t = tMaxV.x; tMaxV.x += tDelta.x; }
-			else					{ voxel.z += step.z; t = tMaxV.z; tMaxV.z += tDelta.z; }
-		} else {
-			if (tMaxV.y < tMaxV.z)	{ voxel.y += step.y; t = tMaxV.y; tMaxV.y += tDelta.y; }
-			else					{ voxel.z += step.z; t = tMaxV.z; tMaxV.z += tDelta.z; }
-		}
-		if (t > maxDistance) return AIR;
+	return raycastHitFetch(originWorld, dirWorld, maxDistance, outBlock) != AIR;
+}
 
-		ivec2 chunkPos(
-			(int)std::floor((float)voxel.x / (float)CHUNK_SIZE),
-			(int)std::floor((float)voxel.z / (float)CHUNK_SIZE)
-		);
-		BlockType b = _chunkLoader.getBlock(chunkPos, voxel);
-		if (isSolidDeletable(b)) {
-			outBlock = voxel;
-			return b;
-		}
-	}
-	return AIR;
+BlockType Raycaster::raycastHitFetch(const glm::vec3& originWorld,
+						const glm::vec3& dirWorld,
+						float maxDistance,
+						glm::ivec3& outBlock)
+{
+	ChunkCache cache;
+	const RayHit hit = march({originWorld, dirWorld, maxDistance}, cache);
+	// Bedrock stops the ray but is not a selectable block
+	if (!hit.hit || !isSolidDeletable(hit.block))
+		return AIR;
+	outBlock = hit.voxel;
+	return hit.block;
 }
 
 bool Raycaster::raycastDeleteOne(const glm::vec3& originWorld,
@@ -188,167 +275,37 @@ bool Raycaster::raycastDeleteOne(const glm::vec3& originWorld,
 	if (!raycastHit(originWorld, dirWorld, maxDistance, hit))
 		return false;
 
-	// Chunk that owns the hit voxel
-	ivec2 chunkPos(
-		(int)std::floor((float)hit.x / (float)CHUNK_SIZE),
-		(int)std::floor((float)hit.z / (float)CHUNK_SIZE)
-	);
+	// Pins the chunks read by the plant cascades below
+	BlockQuery query(_chunkLoader);
 
 	// Fetch block type before deletion (for cascading behavior)
-	BlockType hitTypeBefore = _chunkLoader.getBlock(chunkPos, hit);
-
-	// Try to apply immediately (falls back to queue if chunk not ready)
-	bool wroteNow = _chunkLoader.setBlockOrQueue(chunkPos, hit, AIR, /*byPlayer=*/true);
-
-	if (wroteNow)
-	{
-		// 1) Rebuild current chunk mesh
-		if (Chunk* c = _chunkLoader.getChunk(chunkPos))
-		{
-			c->setAsModified();
-			c->sendFacesToDisplay();
-		}
-
-		// 2) If at border, rebuild neighbor meshes that share the broken face
-		const int lx = (hit.x % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-		const int lz = (hit.z % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-
-		ivec2 neighbors[4];
-		int n = 0;
-		if (lx == 0)               neighbors[n++] = { chunkPos.x - 1, chunkPos.y };
-		if (lx == CHUNK_SIZE - 1)  neighbors[n++] = { chunkPos.x + 1, chunkPos.y };
-		if (lz == 0)               neighbors[n++] = { chunkPos.x,     chunkPos.y - 1 };
-		if (lz == CHUNK_SIZE - 1)  neighbors[n++] = { chunkPos.x,     chunkPos.y + 1 };
-
-		for (int i = 0; i < n; ++i)
-			if (Chunk* nc = _chunkLoader.getChunk(neighbors[i]))
-				nc->sendFacesToDisplay();
+	BlockType hitTypeBefore = query.getBlock(hit);
 
-		// 3) Stage a fresh display snapshot off-thread (coalesced)
-		_chunkLoader.scheduleDisplayUpdate();
-	}
+	// The block and everything it held up go in one batch: written together,
+	// each touched chunk remeshed once (parts on chunks not ready are queued)
+	EditBatch batch;
+	if (!batch.set(hit, AIR))
+		return false;
 
 	// If the broken block was a support block, handle any plant sitting above
 	if (hitTypeBefore == SAND || hitTypeBefore == DIRT || hitTypeBefore == GRASS)
 	{
 		glm::ivec3 above = hit + glm::ivec3(0, 1, 0);
-		ivec2 aboveChunk(
-			(int)std::floor((float)above.x / (float)CHUNK_SIZE),
-			(int)std::floor((float)above.z / (float)CHUNK_SIZE)
-		);
-		BlockType aboveType = _chunkLoader.getBlock(aboveChunk, above);
+		BlockType aboveType = query.getBlock(above);
 
+		// Cascade remove the entire cactus column above the broken sand
 		if (hitTypeBefore == SAND && aboveType == CACTUS)
-		{
-			// Cascade remove the entire cactus column above the broken sand
-			glm::ivec3 cur = above;
-			while (true)
-			{
-				ivec2 curChunk(
-					(int)std::floor((float)cur.x / (float)CHUNK_SIZE),
-					(int)std::floor((float)cur.z / (float)CHUNK_SIZE)
-				);
-				BlockType curType = _chunkLoader.getBlock(curChunk, cur);
-				if (curType != CACTUS) break;
-
-				bool wrote = _chunkLoader.setBlockOrQueue(curChunk, cur, AIR, /*byPlayer=*/true);
-				if (wrote)
-				{
-					if (Chunk* c2 = _chunkLoader.getChunk(curChunk))
-					{
-						c2->setAsModified();
-						c2->sendFacesToDisplay();
-					}
-
-					const int lx2 = (cur.x % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-					const int lz2 = (cur.z % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-					ivec2 neighbors2[4];
-					int n2 = 0;
-					if (lx2 == 0)               neighbors2[n2++] = { curChunk.x - 1, curChunk.y };
-					if (lx2 == CHUNK_SIZE - 1)  neighbors2[n2++] = { curChunk.x + 1, curChunk.y };
-					if (lz2 == 0)               neighbors2[n2++] = { curChunk.x,     curChunk.y - 1 };
-					if (lz2 == CHUNK_SIZE - 1)  neighbors2[n2++] = { curChunk.x,     curChunk.y + 1 };
-					for (int i = 0; i < n2; ++i)
-						if (Chunk* nc2 = _chunkLoader.getChunk(neighbors2[i]))
-							nc2->sendFacesToDisplay();
-				}
-
-				// Move upward
-				cur.y += 1;
-			}
-
-			// Coalesce display update once
-			_chunkLoader.scheduleDisplayUpdate();
-		}
+			queueCactusColumn(query, above, batch);
+		// Remove a single billboard plant above when breaking its support
 		else if (isFlower(aboveType))
-		{
-			// Remove a single billboard plant above when breaking its support
-			bool wroteTop = _chunkLoader.setBlockOrQueue(aboveChunk, above, AIR, /*byPlayer=*/true);
-			if (wroteTop)
-			{
-				if (Chunk* c2 = _chunkLoader.getChunk(aboveChunk))
-				{
-					c2->setAsModified();
-					c2->sendFacesToDisplay();
-				}
-
-				const int lx2 = (above.x % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-				const int lz2 = (above.z % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-				ivec2 neighbors2[4];
-				int n2 = 0;
-				if (lx2 == 0)               neighbors2[n2++] = { aboveChunk.x - 1, aboveChunk.y };
-				if (lx2 == CHUNK_SIZE - 1)  neighbors2[n2++] = { aboveChunk.x + 1, aboveChunk.y };
-				if (lz2 == 0)               neighbors2[n2++] = { aboveChunk.x,     aboveChunk.y - 1 };
-				if (lz2 == CHUNK_SIZE - 1)  neighbors2[n2++] = { aboveChunk.x,     aboveChunk.y + 1 };
-				for (int i = 0; i < n2; ++i)
-					if (Chunk* nc2 = _chunkLoader.getChunk(neighbors2[i]))
-						nc2->sendFacesToDisplay();
-
-				_chunkLoader.scheduleDisplayUpdate();
-			}
-		}
+			batch.set(above, AIR);
 	}
 
 	// If we directly broke a cactus block, cascade-remove all cactus blocks above it
 	if (hitTypeBefore == CACTUS)
-	{
-		glm::ivec3 cur = hit + glm::ivec3(0, 1, 0);
-		while (true)
-		{
-			ivec2 curChunk(
-				(int)std::floor((float)cur.x / (float)CHUNK_SIZE),
-				(int)std::floor((float)cur.z / (float)CHUNK_SIZE)
-			);
-			BlockType curType = _chunkLoader.getBlock(curChunk, cur);
-			if (curType != CACTUS) break;
-
-			bool wrote = _chunkLoader.setBlockOrQueue(curChunk, cur, AIR, /*byPlayer=*/true);
-			if (wrote)
-			{
-				if (Chunk* c2 = _chunkLoader.getChunk(curChunk))
-				{
-					c2->setAsModified();
-					c2->sendFacesToDisplay();
-				}
-
-				const int lx2 = (cur.x % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-				const int lz2 = (cur.z % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-				ivec2 neighbors2[4];
-				int n2 = 0;
-				if (lx2 == 0)               neighbors2[n2++] = { curChunk.x - 1, curChunk.y };
-				if (lx2 == CHUNK_SIZE - 1)  neighbors2[n2++] = { curChunk.x + 1, curChunk.y };
-				if (lz2 == 0)               neighbors2[n2++] = { curChunk.x,     curChunk.y - 1 };
-				if (lz2 == CHUNK_SIZE - 1)  neighbors2[n2++] = { curChunk.x,     curChunk.y + 1 };
-				for (int i = 0; i < n2; ++i)
-					if (Chunk* nc2 = _chunkLoader.getChunk(neighbors2[i]))
-						nc2->sendFacesToDisplay();
-			}
+		queueCactusColumn(query, hit + glm::ivec3(0, 1, 0), batch);
 
-			cur.y += 1;
-		}
-
-		_chunkLoader.scheduleDisplayUpdate();
-	}
+	_chunkLoader.commitEdits(batch);
 	return true;
 }
 
@@ -362,136 +319,18 @@ bool Raycaster::raycastPlaceOne(const glm::vec3& originWorld,
 		// in front of the hit block (the voxel before entering
 	// the solid block), matching Minecraft behavior.
 
-	if (maxDistance <= 0.0f) return false;
-
-	// Normalize direction
-	glm::vec3 dir = dirWorld;
-	float dlen = glm::length(dir);
-	if (dlen < 1e-8f) return false;
-	dir /= dlen;
-
-	// Nudge origin slightly to avoid self-intersection at boundaries
-	glm::vec3 ro = originWorld + dir * 0.001f;
-
-		// Current voxel and the previous voxel before stepping
-	glm::ivec3 voxel(
-		(int)std::floor(ro.x),
-		(int)std::floor(ro.y),
-		(int)std::floor(ro.z)
-	);
-	glm::ivec3 prev = voxel;
-
-	// Step for each axis
-	glm::ivec3 step(
-		(dir.x > 0.f) ? 1 : (dir.x < 0.f) ? -1 : 0,
-		(dir.y > 0.f) ? 1 : (dir.y < 0.f) ? -1 : 0,
-		(dir.z > 0.f) ? 1 : (dir.z < 0.f) ? -1 : 0
-	);
-
-	const float INF = std::numeric_limits<float>::infinity();
-	glm::vec3 tDelta(
-		(step.x != 0) ? 1.0f / std::abs(dir.x) : INF,
-		(step.y != 0) ? 1.0f / std::abs(dir.y) : INF,
-		(step.z != 0) ? 1.0f / std::abs(dir.z) : INF
-	);
-
-	auto firstBoundaryT = [&](float r, int v, int s, float d) -> float {
-		if (s > 0) return ((float(v) + 1.0f) - r) / d;
-		if (s < 0) return (r - float(v)) / -d;
-		return INF;
-	};
-
-	glm::vec3 tMaxV(
-		firstBoundaryT(ro.x, voxel.x, step.x, dir.x),
-		firstBoundaryT(ro.y, voxel.y, step.y, dir.y),
-		firstBoundaryT(ro.z, voxel.z, step.z, dir.z)
-	);
-
-	float t = 0.0f;
-	const int MAX_STEPS = 512;
-
-	for (int i = 0; i < MAX_STEPS; ++i) {
-			// Step to next voxel and record the previous voxel
-		if (tMaxV.x < tMaxV.y) {
-			if (tMaxV.x < tMaxV.z) { prev = voxel; voxel.x += step.x; t = tMaxV.x; tMaxV.x += tDelta.x; }
-			else                   { prev = voxel; voxel.z += step.z; t = tMaxV.z; tMaxV.z += tDelta.z; }
-		} else {
-			if (tMaxV.y < tMaxV.z) { prev = voxel; voxel.y += step.y; t = tMaxV.y; tMaxV.y += tDelta.y; }
-			else                   { prev = voxel; voxel.z += step.z; t = tMaxV.z; tMaxV.z += tDelta.z; }
-		}
-
-		if (t > maxDistance) return false;
-
-		ivec2 chunkPos(
-			(int)std::floor((float)voxel.x / (float)CHUNK_SIZE),
-			(int)std::floor((float)voxel.z / (float)CHUNK_SIZE)
-		);
-		BlockType b = _chunkLoader.getBlock(chunkPos, voxel);
-
-		// Special case: if we hit a decorative plant (billboard) and the player is placing a non-flower, non-air block,
-		// replace the flower instead of placing above it.
-		if (isFlower(b)) {
-			bool placingNonFlower = (block != AIR && !isFlower(block));
-			if (placingNonFlower) {
-				// Prevent placing a block inside the player's occupied cells (feet/head)
-				{
-					glm::vec3 camW = _camera.getWorldPosition();
-					int px = static_cast<int>(std::floor(camW.x));
-					int pz = static_cast<int>(std::floor(camW.z));
-					int footY = static_cast<int>(std::floor(camW.y - EYE_HEIGHT + EPS));
-					glm::ivec3 feet = { px, footY, pz };
-					glm::ivec3 head = { px, footY + 1, pz };
-					if (voxel == feet || voxel == head) {
-						return false; // would collide with player
-					}
-				}
-
-				ivec2 placeChunk(
-					(int)std::floor((float)voxel.x / (float)CHUNK_SIZE),
-					(int)std::floor((float)voxel.z / (float)CHUNK_SIZE)
-				);
-
-				bool wroteNow = _chunkLoader.setBlockOrQueue(placeChunk, voxel, block, /*byPlayer=*/true);
-				if (wroteNow) {
-					// Rebuild current chunk mesh
-					if (Chunk* c = _chunkLoader.getChunk(placeChunk))
-					{
-						c->setAsModified();
-						c->sendFacesToDisplay();
-					}
-
-					// If at border, also rebuild neighbors that share faces
-					const int lx = (voxel.x % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-					const int lz = (voxel.z % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-
-					ivec2 neighbors[4];
-					int n = 0;
-					if (lx == 0)               neighbors[n++] = { placeChunk.x - 1, placeChunk.y };
-					if (lx == CHUNK_SIZE - 1)  neighbors[n++] = { placeChunk.x + 1, placeChunk.y };
-					if (lz == 0)               neighbors[n++] = { placeChunk.x,     placeChunk.y - 1 };
-					if (lz == CHUNK_SIZE - 1)  neighbors[n++] = { placeChunk.x,     placeChunk.y + 1 };
-
-					for (int i2 = 0; i2 < n; ++i2)
-						if (Chunk* nc = _chunkLoader.getChunk(neighbors[i2]))
-							nc->sendFacesToDisplay();
-
-					// Stage a fresh display snapshot off-thread (coalesced)
-					_chunkLoader.scheduleDisplayUpdate();
-				}
-
-				outPlaced = voxel;
-				return true;
-			}
-			// else: placing a flower or air -> fall through to default behavior (place on prev if empty)
-		}
-
-		if (b == BEDROCK || isSolidDeletable(b)) {
-			// Place into the previous (empty) voxel before entering the hit voxel
-			ivec2 placeChunk(
-				(int)std::floor((float)prev.x / (float)CHUNK_SIZE),
-				(int)std::floor((float)prev.z / (float)CHUNK_SIZE)
-			);
-
+	ChunkCache cache;
+	const RayHit hit = march({originWorld, dirWorld, maxDistance}, cache);
+	if (!hit.hit) return false;
+	const glm::ivec3 voxel = hit.voxel;
+	const glm::ivec3 prev = hit.prev;
+	const BlockType b = hit.block;
+
+	// Special case: if we hit a decorative plant (billboard) and the player is placing a non-flower, non-air block,
+	// replace the flower instead of placing above it.
+	if (isFlower(b)) {
+		bool placingNonFlower = (block != AIR && !isFlower(block));
+		if (placingNonFlower) {
 			// Prevent placing a block inside the player's occupied cells (feet/head)
 			{
 				glm::vec3 camW = _camera.getWorldPosition();
@@ -500,62 +339,61 @@ bool Raycaster::raycastPlaceOne(const glm::vec3& originWorld,
 				int footY = static_cast<int>(std::floor(camW.y - EYE_HEIGHT + EPS));
 				glm::ivec3 feet = { px, footY, pz };
 				glm::ivec3 head = { px, footY + 1, pz };
-				if (prev == feet || prev == head) {
+				if (voxel == feet || voxel == head) {
 					return false; // would collide with player
 				}
 			}
 
-			// Only place if target is empty or replaceable (AIR/WATER).
-			BlockType current = _chunkLoader.getBlock(placeChunk, prev);
-
-			// If placing a flower/plant, use flowerPlaceCondition rules:
-			// - Target cell must be AIR (not water)
-			// - Support below must satisfy flowerPlaceCondition for the block type
-			if (isPlantPlaceable(block)) {
-				if (current != AIR) return false;
-				glm::ivec3 below = prev; below.y -= 1;
-				ivec2 belowChunk(
-					(int)std::floor((float)below.x / (float)CHUNK_SIZE),
-					(int)std::floor((float)below.z / (float)CHUNK_SIZE)
-				);
-				BlockType support = _chunkLoader.getBlock(belowChunk, below);
-				if (!flowerPlaceCondition(support, block)) return false;
-			} else {
-				if (!(current == AIR || current == WATER)) return false;
-			}
+			EditBatch batch;
+			if (!batch.set(voxel, block))
+				return false;
+			_chunkLoader.commitEdits(batch);
 
-			bool wroteNow = _chunkLoader.setBlockOrQueue(placeChunk, prev, block, /*byPlayer=*/true);
-			if (wroteNow) {
-				// Rebuild current chunk mesh
-				if (Chunk* c = _chunkLoader.getChunk(placeChunk))
-				{
-					c->setAsModified();
-					c->sendFacesToDisplay();
-				}
-
-				// If at border, also rebuild neighbors that share faces
-				const int lx = (prev.x % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-				const int lz = (prev.z % CHUNK_SIZE + CHUNK_SIZE) % CHUNK_SIZE;
-
-				ivec2 neighbors[4];
-				int n = 0;
-				if (lx == 0)               neighbors[n++] = { placeChunk.x - 1, placeChunk.y };
-				if (lx == CHUNK_SIZE - 1)  neighbors[n++] = { placeChunk.x + 1, placeChunk.y };
-				if (lz == 0)               neighbors[n++] = { placeChunk.x,     placeChunk.y - 1 };
-				if (lz == CHUNK_SIZE - 1)  neighbors[n++] = { placeChunk.x,     placeChunk.y + 1 };
-
-				for (int i2 = 0; i2 < n; ++i2)
-					if (Chunk* nc = _chunkLoader.getChunk(neighbors[i2]))
-						nc->sendFacesToDisplay();
+			outPlaced = voxel;
+			return true;
+		}
+		// else: placing a flower or air -> fall through to default behavior (place on prev if empty)
+	}
 
-				// Stage a fresh display snapshot off-thread (coalesced)
-				_chunkLoader.scheduleDisplayUpdate();
+	if (b == BEDROCK || isSolidDeletable(b)) {
+		// Prevent placing a block inside the player's occupied cells (feet/head)
+		{
+			glm::vec3 camW = _camera.getWorldPosition();
+			int px = static_cast<int>(std::floor(camW.x));
+			int pz = static_cast<int>(std::floor(camW.z));
+			int footY = static_cast<int>(std::floor(camW.y - EYE_HEIGHT + EPS));
+			glm::ivec3 feet = { px, footY, pz };
+			glm::ivec3 head = { px, footY + 1, pz };
+			if (prev == feet || prev == head) {
+				return false; // would collide with player
 			}
+		}
 
-			// Return the actual placed cell from this first pass
-			outPlaced = prev;
-			return true;
+		// Only place if target is empty or replaceable (AIR/WATER).
+		BlockQuery query(_chunkLoader);
+		BlockType current = query.getBlock(prev);
+
+		// If placing a flower/plant, use flowerPlaceCondition rules:
+		// - Target cell must be AIR (not water)
+		// - Support below must satisfy flowerPlaceCondition for the block type
+		if (isPlantPlaceable(block)) {
+			if (current != AIR) return false;
+			glm::ivec3 below = prev; below.y -= 1;
+			BlockType support = query.getBlock(below);
+			if (!flowerPlaceCondition(support, block)) return false;
+		} else {
+			if (!(current == AIR || current == WATER)) return false;
 		}
+
+		// Place into the previous (empty) voxel before entering the hit voxel
+		EditBatch batch;
+		if (!batch.set(prev, block))
+			return false;
+		_chunkLoader.commitEdits(batch);
+
+		// Return the actual placed cell from this first pass
+		outPlaced = prev;
+		return true;
 	}
 	return false;
 }
@@ -0,0 +1,295 @@
+#include "RegionFile.hpp"
+#include "NoiseBackend.hpp"
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+static inline int floor_div(int a, int b) {
+	int q = a / b, r = a % b;
+	return (r && ((r < 0) != (b < 0))) ? (q - 1) : q;
+}
+
+namespace
+{
+	const char		kMagic[4] = {'F', 'T', 'V', 'R'};
+	const uint32_t	kVersion = 1;
+	const size_t	kSlots = (size_t)REGION_SIZE * REGION_SIZE;
+	const size_t	kVoxels = (size_t)CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+	// magic, version, seed, region x/z, noise backend
+	const size_t	kHeaderSize = 4 + 4 + 8 + 4 + 4 + 4;
+	const size_t	kTableSize = kSlots * 8;
+
+	// Little-endian fields
+	void put32(std::vector<uint8_t> &out, uint32_t v)
+	{
+		for (int i = 0; i < 4; ++i)
+			out.push_back((uint8_t)(v >> (8 * i)));
+	}
+	void put64(std::vector<uint8_t> &out, uint64_t v)
+	{
+		for (int i = 0; i < 8; ++i)
+			out.push_back((uint8_t)(v >> (8 * i)));
+	}
+	void set32(std::vector<uint8_t> &out, size_t at, uint32_t v)
+	{
+		for (int i = 0; i < 4; ++i)
+			out[at + i] = (uint8_t)(v >> (8 * i));
+	}
+	uint32_t get32(const uint8_t *p)
+	{
+		return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+	}
+	uint64_t get64(const uint8_t *p)
+	{
+		return (uint64_t)get32(p) | ((uint64_t)get32(p + 4) << 32);
+	}
+
+	uint64_t fnv1a(uint64_t h, const uint8_t *data, size_t size)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			h ^= data[i];
+			h *= 0x100000001b3ULL;
+		}
+		return h;
+	}
+
+	size_t slotOf(const ivec2 &chunkPos, const ivec2 &region)
+	{
+		const ivec2 local = chunkPos - region * REGION_SIZE;
+		return (size_t)local.y * REGION_SIZE + (size_t)local.x;
+	}
+}
+
+RegionStore::RegionStore(const std::string &dir, uint64_t seed)
+: _dir(dir), _seed(seed)
+{
+}
+
+ivec2 RegionStore::regionOf(const ivec2 &chunkPos)
+{
+	return ivec2(floor_div(chunkPos.x, REGION_SIZE), floor_div(chunkPos.y, REGION_SIZE));
+}
+
+std::string RegionStore::pathFor(const ivec2 &region) const
+{
+	return _dir + "/r." + std::to_string(region.x) + "." + std::to_string(region.y) + ".vox";
+}
+
+const RegionStore::Index &RegionStore::index(const ivec2 &region)
+{
+	auto it = _indexes.find(region);
+	if (it != _indexes.end())
+		return it->second;
+
+	Index &idx = _indexes[region];
+	std::ifstream file(pathFor(region), std::ios::binary);
+	if (!file)
+		return idx;
+	std::vector<uint8_t> head(kHeaderSize + kTableSize);
+	if (!file.read(reinterpret_cast<char *>(head.data()), head.size()))
+		return idx;
+	const uint8_t *p = head.data();
+	if (std::memcmp(p, kMagic, 4) != 0 || get32(p + 4) != kVersion
+		|| get64(p + 8) != _seed
+		|| (int32_t)get32(p + 16) != region.x || (int32_t)get32(p + 20) != region.y
+		|| get32(p + 24) != (uint32_t)NoiseBackend::selected())
+		return idx;
+
+	idx.offsets.resize(kSlots);
+	idx.sizes.resize(kSlots);
+	for (size_t i = 0; i < kSlots; ++i)
+	{
+		idx.offsets[i] = get32(p + kHeaderSize + i * 8);
+		idx.sizes[i] = get32(p + kHeaderSize + i * 8 + 4);
+	}
+	idx.valid = true;
+	return idx;
+}
+
+bool RegionStore::has(const ivec2 &chunkPos)
+{
+	const ivec2 region = regionOf(chunkPos);
+	std::lock_guard<std::mutex> lk(_mutex);
+	const Index &idx = index(region);
+	return idx.valid && idx.sizes[slotOf(chunkPos, region)] != 0;
+}
+
+bool RegionStore::load(const ivec2 &chunkPos, StoredChunk &out)
+{
+	const ivec2 region = regionOf(chunkPos);
+	uint32_t offset = 0, size = 0;
+	{
+		std::lock_guard<std::mutex> lk(_mutex);
+		const Index &idx = index(region);
+		if (!idx.valid)
+			return false;
+		offset = idx.offsets[slotOf(chunkPos, region)];
+		size = idx.sizes[slotOf(chunkPos, region)];
+	}
+	if (size < 4)
+		return false;
+
+	std::ifstream file(pathFor(region), std::ios::binary);
+	std::vector<uint8_t> payload(size);
+	if (!file.seekg(offset) || !file.read(reinterpret_cast<char *>(payload.data()), size))
+		return false;
+
+	const uint8_t *p = payload.data();
+	const uint8_t *end = p + size;
+	const uint32_t count = get32(p);
+	p += 4;
+	out.position = chunkPos;
+	out.subChunks.clear();
+	out.subChunks.reserve(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		if (end - p < 8)
+			return false;
+		const int subY = (int32_t)get32(p);
+		const uint32_t len = get32(p + 4);
+		p += 8;
+		if ((size_t)(end - p) < len)
+			return false;
+		std::vector<uint8_t> blocks(kVoxels);
+		if (!decode(p, len, blocks.data(), blocks.size()))
+			return false;
+		p += len;
+		out.subChunks.emplace_back(subY, std::move(blocks));
+	}
+	return true;
+}
+
+uint64_t RegionStore::write(const ivec2 &region, const std::vector<StoredChunk> &chunks)
+{
+	std::vector<const StoredChunk *> slots(kSlots, nullptr);
+	for (const StoredChunk &chunk : chunks)
+		if (regionOf(chunk.position) == region)
+			slots[slotOf(chunk.position, region)] = &chunk;
+
+	std::vector<uint8_t> data;
+	data.insert(data.end(), kMagic, kMagic + 4);
+	put32(data, kVersion);
+	put64(data, _seed);
+	put32(data, (uint32_t)region.x);
+	put32(data, (uint32_t)region.y);
+	put32(data, (uint32_t)NoiseBackend::selected());
+	data.resize(kHeaderSize + kTableSize, 0);
+
+	uint64_t digest = 0xcbf29ce484222325ULL;
+	std::vector<uint8_t> rle;
+	for (size_t i = 0; i < kSlots; ++i)
+	{
+		if (!slots[i])
+			continue;
+		const size_t start = data.size();
+		put32(data, (uint32_t)slots[i]->subChunks.size());
+		for (const auto &sub : slots[i]->subChunks)
+		{
+			encode(sub.second.data(), std::min(sub.second.size(), kVoxels), rle);
+			put32(data, (uint32_t)sub.first);
+			put32(data, (uint32_t)rle.size());
+			data.insert(data.end(), rle.begin(), rle.end());
+		}
+		set32(data, kHeaderSize + i * 8, (uint32_t)start);
+		set32(data, kHeaderSize + i * 8 + 4, (uint32_t)(data.size() - start));
+
+		uint8_t slot[4] = {(uint8_t)i, (uint8_t)(i >> 8), (uint8_t)(i >> 16), (uint8_t)(i >> 24)};
+		digest = fnv1a(digest, slot, 4);
+		digest = fnv1a(digest, data.data() + start, data.size() - start);
+	}
+
+	// Write aside then rename, readers never see a partial file
+	mkdir(_dir.c_str(), 0755);
+	const std::string path = pathFor(region);
+	const std::string tmp = path + ".tmp";
+	{
+		std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+		if (!file.write(reinterpret_cast<const char *>(data.data()), data.size()))
+		{
+			std::cerr << "RegionStore: cannot write " << tmp << std::endl;
+			return digest;
+		}
+	}
+	if (std::rename(tmp.c_str(), path.c_str()) != 0)
+		std::cerr << "RegionStore: cannot replace " << path << std::endl;
+
+	std::lock_guard<std::mutex> lk(_mutex);
+	_indexes.erase(region);
+	return digest;
+}
+
+void RegionStore::encode(const uint8_t *data, size_t size, std::vector<uint8_t> &out)
+{
+	out.clear();
+	size_t i = 0;
+	while (i < size)
+	{
+		const uint8_t value = data[i];
+		size_t run = 1;
+		while (i + run < size && data[i + run] == value)
+			++run;
+		i += run;
+		for (size_t v = run; ; v >>= 7)
+		{
+			if (v < 0x80)
+			{
+				out.push_back((uint8_t)v);
+				break;
+			}
+			out.push_back((uint8_t)(v & 0x7f) | 0x80);
+		}
+		out.push_back(value);
+	}
+}
+
+bool RegionStore::decode(const uint8_t *data, size_t size, uint8_t *out, size_t outSize)
+{
+	size_t i = 0, o = 0;
+	while (i < size)
+	{
+		size_t run = 0;
+		for (int shift = 0; ; shift += 7)
+		{
+			if (i >= size || shift > 28)
+				return false;
+			const uint8_t byte = data[i++];
+			run |= (size_t)(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				break;
+		}
+		if (i >= size || run > outSize - o)
+			return false;
+		std::fill_n(out + o, run, data[i++]);
+		o += run;
+	}
+	return o == outSize;
+}
+
+bool RegionStore::decodeAt(const uint8_t *data, size_t size, size_t index, uint8_t &out)
+{
+	size_t i = 0, o = 0;
+	while (i < size)
+	{
+		size_t run = 0;
+		for (int shift = 0; ; shift += 7)
+		{
+			if (i >= size || shift > 28)
+				return false;
+			const uint8_t byte = data[i++];
+			run |= (size_t)(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				break;
+		}
+		if (i >= size)
+			return false;
+		if (index < o + run)
+		{
+			out = data[i];
+			return true;
+		}
+		o += run;
+		++i;
+	}
+	return false;
+}
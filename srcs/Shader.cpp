@@ -1,21 +1,229 @@
 #include "ft_vox.hpp"
+#include "define.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
 
-GLuint compileShader(const char* filePath, GLenum shaderType)
+// Linked programs are kept on disk with glGetProgramBinary and loaded back
+// with glProgramBinary. One file per program, named after its source paths;
+// the header key covers the sources and the driver strings, so an edited
+// shader or a driver update recompiles and replaces the file.
+
+namespace
 {
-	std::ifstream shaderFile(filePath);
-	if (!shaderFile.is_open()) {
-		std::cerr << "Error: Shader file could not be opened: " << filePath << std::endl;
-		return 0;
+	typedef std::chrono::steady_clock Clock;
+
+	const char		kMagic[4] = {'F', 'T', 'V', 'P'};
+	const uint32_t	kVersion = 1;
+
+	ShaderCacheStats	g_stats;
+
+	struct CacheHeader {
+		char		magic[4];
+		uint32_t	version;
+		uint64_t	key;
+		uint32_t	format;
+		uint32_t	size;
+		double		compileMs;	// what the miss cost, reported as saved on hits
+	};
+
+	double msSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	uint64_t fnv1a(uint64_t h, const void *data, size_t size)
+	{
+		const unsigned char *p = static_cast<const unsigned char *>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			h ^= p[i];
+			h *= 0x100000001b3ULL;
+		}
+		return h;
+	}
+
+	uint64_t fnv1a(uint64_t h, const std::string &s)
+	{
+		// Length first so ("ab", "c") and ("a", "bc") differ
+		const uint64_t size = s.size();
+		return fnv1a(fnv1a(h, &size, sizeof(size)), s.data(), s.size());
+	}
+
+	bool readSource(const char *filePath, std::string &out)
+	{
+		std::ifstream shaderFile(filePath);
+		if (!shaderFile.is_open()) {
+			std::cerr << "Error: Shader file could not be opened: " << filePath << std::endl;
+			return false;
+		}
+		std::stringstream shaderStream;
+		shaderStream << shaderFile.rdbuf();
+		out = shaderStream.str();
+		return true;
+	}
+
+	GLuint compileSource(const std::string &shaderCode, GLenum shaderType)
+	{
+		const char* shaderSource = shaderCode.c_str();
+
+		GLuint shader = glCreateShader(shaderType);
+		glShaderSource(shader, 1, &shaderSource, NULL);
+		glCompileShader(shader);
+		return shader;
+	}
+
+	// Binaries only load on the driver that wrote them
+	uint64_t driverHash()
+	{
+		static const uint64_t hash = []() {
+			uint64_t h = 0xcbf29ce484222325ULL;
+			const GLenum names[] = {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION};
+			for (GLenum name : names)
+			{
+				const char *value = reinterpret_cast<const char *>(glGetString(name));
+				h = fnv1a(h, std::string(value ? value : ""));
+			}
+			return h;
+		}();
+		return hash;
+	}
+
+	bool cacheEnabled()
+	{
+		static const bool enabled = []() {
+			GLint formats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+			return SHADER_BINARY_CACHE && formats > 0;
+		}();
+		return enabled;
+	}
+
+	std::string cachePath(const std::vector<const char *> &paths)
+	{
+		uint64_t h = 0xcbf29ce484222325ULL;
+		for (const char *path : paths)
+			h = fnv1a(h, std::string(path));
+		char name[64];
+		std::snprintf(name, sizeof(name), "/prog_%016llx.bin", (unsigned long long)h);
+		return std::string(SHADER_CACHE_DIR) + name;
+	}
+
+	// Program from the cache file, 0 when absent, stale or refused by the driver
+	GLuint loadBinary(const std::string &path, uint64_t key, double &compileMs)
+	{
+		std::ifstream file(path, std::ios::binary);
+		CacheHeader header;
+		if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))
+			|| std::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion
+			|| header.key != key || header.size == 0)
+			return 0;
+		std::vector<char> binary(header.size);
+		if (!file.read(binary.data(), binary.size()))
+			return 0;
+
+		GLuint program = glCreateProgram();
+		glProgramBinary(program, header.format, binary.data(), (GLsizei)binary.size());
+		GLint success = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			glDeleteProgram(program);
+			return 0;
+		}
+		compileMs = header.compileMs;
+		return program;
+	}
+
+	void storeBinary(const std::string &path, uint64_t key, GLuint program, double compileMs)
+	{
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
+		std::vector<char> binary(length);
+		GLenum format = 0;
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+		if (length <= 0)
+			return;
+
+		CacheHeader header;
+		std::memcpy(header.magic, kMagic, 4);
+		header.version = kVersion;
+		header.key = key;
+		header.format = format;
+		header.size = (uint32_t)length;
+		header.compileMs = compileMs;
+
+		// Write aside then rename, a crash never leaves a truncated binary
+		mkdir(SHADER_CACHE_DIR, 0755);
+		const std::string tmp = path + ".tmp";
+		{
+			std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+			file.write(binary.data(), length);
+			if (!file)
+			{
+				std::cerr << "Cannot write shader cache " << tmp << std::endl;
+				return;
+			}
+		}
+		if (std::rename(tmp.c_str(), path.c_str()) != 0)
+			std::cerr << "Cannot write shader cache " << path << std::endl;
+	}
+
+	// Cached program for these sources, or build(program) then cache it.
+	// build attaches, links and reports errors; false keeps it out of the cache.
+	template <typename Build>
+	GLuint cachedProgram(const std::vector<const char *> &paths, const std::vector<std::string> &sources, bool readOk, Build build)
+	{
+		const auto start = Clock::now();
+		const bool cacheable = readOk && cacheEnabled();
+		std::string path;
+		uint64_t key = 0;
+		if (cacheable)
+		{
+			path = cachePath(paths);
+			key = driverHash();
+			for (const std::string &source : sources)
+				key = fnv1a(key, source);
+			double recordedMs = 0.0;
+			if (GLuint program = loadBinary(path, key, recordedMs))
+			{
+				const double ms = msSince(start);
+				g_stats.hits++;
+				g_stats.loadMs += ms;
+				g_stats.savedMs += std::max(0.0, recordedMs - ms);
+				return program;
+			}
+		}
+
+		GLuint program = glCreateProgram();
+		if (cacheable)
+			glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		const bool linked = build(program);
+		const double ms = msSince(start);
+		g_stats.misses++;
+		g_stats.compileMs += ms;
+		if (cacheable && linked)
+			storeBinary(path, key, program, ms);
+		return program;
 	}
+}
+
+const ShaderCacheStats &shaderCacheStats()
+{
+	return g_stats;
+}
 
-	std::stringstream shaderStream;
-	shaderStream << shaderFile.rdbuf();
-	std::string shaderCode = shaderStream.str();
-	const char* shaderSource = shaderCode.c_str();
+GLuint compileShader(const char* filePath, GLenum shaderType)
+{
+	std::string shaderCode;
+	if (!readSource(filePath, shaderCode))
+		return 0;
 
-	GLuint shader = glCreateShader(shaderType);
-	glShaderSource(shader, 1, &shaderSource, NULL);
-	glCompileShader(shader);
+	GLuint shader = compileSource(shaderCode, shaderType);
 
 	GLint success;
 	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
@@ -29,60 +237,69 @@ GLuint compileShader(const char* filePath, GLenum shaderType)
 
 GLuint compileComputeShader(const char* src)
 {
-	std::ifstream shaderFile(src);
-	if (!shaderFile.is_open()) {
-		std::cerr << "Error: Shader file could not be opened: " << src << std::endl;
+	std::string shaderCode;
+	if (!readSource(src, shaderCode))
 		return 0;
-	}
 
-	std::stringstream shaderStream;
-	shaderStream << shaderFile.rdbuf();
-	std::string shaderCode = shaderStream.str();
-	const char* shaderSource = shaderCode.c_str();
-
-	GLuint s = glCreateShader(GL_COMPUTE_SHADER);
-	glShaderSource(s, 1, &shaderSource, nullptr);
-	glCompileShader(s);
-	GLint status = GL_FALSE; glGetShaderiv(s, GL_COMPILE_STATUS, &status);
-	if (!status) {
-		GLint len = 0; glGetShaderiv(s, GL_INFO_LOG_LENGTH, &len);
-		std::string log(len, '\0');
-		glGetShaderInfoLog(s, len, nullptr, log.data());
-		std::cerr << "[Compute] compile error:\n" << log << std::endl;
-	}
-	GLuint p = glCreateProgram();
-	glAttachShader(p, s);
-	glLinkProgram(p);
-	glDeleteShader(s);
-	glGetProgramiv(p, GL_LINK_STATUS, &status);
-	if (!status) {
-		GLint len = 0; glGetProgramiv(p, GL_INFO_LOG_LENGTH, &len);
-		std::string log(len, '\0');
-		glGetProgramInfoLog(p, len, nullptr, log.data());
-		std::cerr << "[Compute] link error:\n" << log << std::endl;
-	}
-	return p;
+	return cachedProgram({src}, {shaderCode}, true, [&](GLuint p) {
+		GLuint s = compileSource(shaderCode, GL_COMPUTE_SHADER);
+		GLint status = GL_FALSE; glGetShaderiv(s, GL_COMPILE_STATUS, &status);
+		if (!status) {
+			GLint len = 0; glGetShaderiv(s, GL_INFO_LOG_LENGTH, &len);
+			std::string log(len, '\0');
+			glGetShaderInfoLog(s, len, nullptr, log.data());
+			std::cerr << "[Compute] compile error:\n" << log << std::endl;
+		}
+		glAttachShader(p, s);
+		glLinkProgram(p);
+		glDeleteShader(s);
+		glGetProgramiv(p, GL_LINK_STATUS, &status);
+		if (!status) {
+			GLint len = 0; glGetProgramiv(p, GL_INFO_LOG_LENGTH, &len);
+			std::string log(len, '\0');
+			glGetProgramInfoLog(p, len, nullptr, log.data());
+			std::cerr << "[Compute] link error:\n" << log << std::endl;
+		}
+		return status == GL_TRUE;
+	});
 }
 
 GLuint createShaderProgram(const char* vertexShaderPath, const char* fragmentShaderPath)
 {
-	GLuint vertexShader = compileShader(vertexShaderPath, GL_VERTEX_SHADER);
-	GLuint fragmentShader = compileShader(fragmentShaderPath, GL_FRAGMENT_SHADER);
+	std::string vertexCode, fragmentCode;
+	const bool vertexRead = readSource(vertexShaderPath, vertexCode);
+	const bool fragmentRead = readSource(fragmentShaderPath, fragmentCode);
 
-	GLuint shaderProgram = glCreateProgram();
-	glAttachShader(shaderProgram, vertexShader);
-	glAttachShader(shaderProgram, fragmentShader);
-	glLinkProgram(shaderProgram);
+	return cachedProgram({vertexShaderPath, fragmentShaderPath}, {vertexCode, fragmentCode},
+		vertexRead && fragmentRead, [&](GLuint shaderProgram) {
+		GLuint vertexShader = vertexRead ? compileSource(vertexCode, GL_VERTEX_SHADER) : 0;
+		GLuint fragmentShader = fragmentRead ? compileSource(fragmentCode, GL_FRAGMENT_SHADER) : 0;
 
-	GLint success;
-	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-	if (!success) {
-		char infoLog[512];
-		glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-		std::cerr << "Error: Shader program linking failed\n" << infoLog << std::endl;
-	}
+		GLint success;
+		const GLuint shaders[] = {vertexShader, fragmentShader};
+		for (GLuint shader : shaders) {
+			if (!shader) continue;
+			glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+			if (!success) {
+				char infoLog[512];
+				glGetShaderInfoLog(shader, 512, NULL, infoLog);
+				std::cerr << "Error: Shader compilation failed\n" << infoLog << std::endl;
+			}
+		}
+
+		glAttachShader(shaderProgram, vertexShader);
+		glAttachShader(shaderProgram, fragmentShader);
+		glLinkProgram(shaderProgram);
+
+		glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+		if (!success) {
+			char infoLog[512];
+			glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+			std::cerr << "Error: Shader program linking failed\n" << infoLog << std::endl;
+		}
 
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
-	return shaderProgram;
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		return success == GL_TRUE;
+	});
 }
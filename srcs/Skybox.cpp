@@ -2,9 +2,13 @@
 #include "Skybox.hpp"
 #include "ft_vox.hpp"
 #include "stb_image.h"
+#include "ThreadPool.hpp"
+#include "define.hpp"
 #include <fstream>
 #include <cmath>
 #include <cstring>
+#include <cstdio>
+#include <sys/stat.h>
 
 // (PPM/XPM loaders removed; using PNG equirectangular only)
 
@@ -154,46 +158,212 @@ bool Skybox::loadFromPNG(const std::array<std::string, 6>& faces, bool fixSeams)
 }
 // (XPM loaders removed)
 
-static inline void sampleEquirectBilinear(const unsigned char* src, int w, int h, int ch,
-										float u, float v, unsigned char* outRGBA)
+// Branch-free atan2/acos (max error ~2e-6 rad, far below a texel even for
+// 16k panoramas) so the per-row loops below vectorize
+static inline float fastAtan2(float y, float x)
 {
-	// Wrap u horizontally [0,1), clamp v vertically [0,1]
-	u = u - std::floor(u);
-	v = std::clamp(v, 0.0f, 1.0f);
-	float x = u * (w - 1);
-	float y = v * (h - 1);
-	int x0 = (int)std::floor(x);
-	int y0 = (int)std::floor(y);
-	int x1 = std::min(x0 + 1, w - 1);
-	int y1 = std::min(y0 + 1, h - 1);
-	float tx = x - x0;
-	float ty = y - y0;
-	auto pix = [&](int xi, int yi, int c){ return src[(yi * w + xi) * ch + c]; };
-	for (int c = 0; c < 4; ++c) {
-		int ci = (c < ch) ? c : (ch - 1); // if RGB, duplicate B into A then set A below
-		float p00 = pix(x0, y0, std::min(ci, ch-1));
-		float p10 = pix(x1, y0, std::min(ci, ch-1));
-		float p01 = pix(x0, y1, std::min(ci, ch-1));
-		float p11 = pix(x1, y1, std::min(ci, ch-1));
-		float p0 = p00 * (1 - tx) + p10 * tx;
-		float p1 = p01 * (1 - tx) + p11 * tx;
-		float pr = p0 * (1 - ty) + p1 * ty;
-		outRGBA[c] = (unsigned char)std::clamp(pr, 0.0f, 255.0f);
+	const float ax = std::fabs(x), ay = std::fabs(y);
+	const float mx = std::max(ax, ay), mn = std::min(ax, ay);
+	const float t = mn / std::max(mx, 1e-30f);
+	const float t2 = t * t;
+	float r = t * (0.99997726f + t2 * (-0.33262347f + t2 * (0.19354346f + t2 * (-0.11643287f + t2 * (0.05265332f + t2 * -0.01172120f)))));
+	r = ay > ax ? 1.57079637f - r : r;
+	r = x < 0.0f ? 3.14159274f - r : r;
+	return y < 0.0f ? -r : r;
+}
+
+static inline float fastAcos(float x)
+{
+	const float ax = std::fabs(x);
+	const float r = std::sqrt(1.0f - ax) * (1.5707963050f + ax * (-0.2145988016f + ax * (0.0889789874f + ax * (-0.0501743046f
+		+ ax * (0.0308918810f + ax * (-0.0170881256f + ax * (0.0066700901f + ax * -0.0012624911f)))))));
+	return x < 0.0f ? 3.14159274f - r : r;
+}
+
+namespace
+{
+	// Face texel (a, b) in [-1, 1] maps to direction origin(b) + a * axis
+	struct FaceBasis { float ox, oy, oz, by, bz, kx, kz; };
+	// ox/oy/oz: origin at b = 0, by/bz: origin change per unit b, kx/kz: a axis
+	const FaceBasis kFaces[6] = {
+		{ 1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f, -1.0f}, // +X ( 1, -b, -a)
+		{-1.0f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f}, // -X (-1, -b,  a)
+		{ 0.0f,  1.0f,  0.0f,  0.0f,  1.0f,  1.0f,  0.0f}, // +Y ( a,  1,  b)
+		{ 0.0f, -1.0f,  0.0f,  0.0f, -1.0f,  1.0f,  0.0f}, // -Y ( a, -1, -b)
+		{ 0.0f,  0.0f,  1.0f, -1.0f,  0.0f,  1.0f,  0.0f}, // +Z ( a, -b,  1)
+		{ 0.0f,  0.0f, -1.0f, -1.0f,  0.0f, -1.0f,  0.0f}, // -Z (-a, -b, -1)
+	};
+
+	const size_t kBandRows = 16;
+
+	// Shared by the pool tasks of one conversion. Bands are claimed from an
+	// atomic counter and the caller claims too, so the conversion finishes
+	// even when every pool worker is busy (or is the caller itself).
+	struct EquirectJob {
+		const unsigned char	*src = nullptr;
+		int					w = 0, h = 0, ch = 0;
+		int					faceSize = 0;
+		unsigned char		*faces[6] = {};
+		size_t				bandsPerFace = 0;
+		size_t				bands = 0;
+		std::atomic_size_t	next{0};
+		size_t				done = 0;
+		std::mutex			mutex;
+		std::condition_variable	cv;
+	};
+
+	void convertRows(const EquirectJob &job, int f, int rowBegin, int rowEnd)
+	{
+		const FaceBasis &basis = kFaces[f];
+		const int n = job.faceSize;
+		std::vector<float> u(n), v(n);
+		for (int y = rowBegin; y < rowEnd; ++y)
+		{
+			const float b = 2.0f * ((y + 0.5f) / n) - 1.0f;
+			const float ox = basis.ox, oy = basis.oy + b * basis.by, oz = basis.oz + b * basis.bz;
+			// Direction to panorama coordinates, whole row at once
+			for (int x = 0; x < n; ++x)
+			{
+				const float a = 2.0f * ((x + 0.5f) / n) - 1.0f;
+				const float dx = ox + a * basis.kx, dy = oy, dz = oz + a * basis.kz;
+				const float inv = 1.0f / std::sqrt(dx * dx + dy * dy + dz * dz);
+				u[x] = (fastAtan2(dz, dx) + 3.14159274f) * (1.0f / 6.28318548f);
+				v[x] = fastAcos(std::min(std::max(dy * inv, -1.0f), 1.0f)) * (1.0f / 3.14159274f);
+			}
+			// Bilinear fetch: wrap u horizontally, clamp v vertically
+			unsigned char *out = job.faces[f] + (size_t)y * n * 4;
+			for (int x = 0; x < n; ++x)
+			{
+				const float uu = u[x] - std::floor(u[x]);
+				const float fx = uu * (job.w - 1);
+				const float fy = std::clamp(v[x], 0.0f, 1.0f) * (job.h - 1);
+				const int x0 = (int)fx, y0 = (int)fy;
+				const int x1 = std::min(x0 + 1, job.w - 1), y1 = std::min(y0 + 1, job.h - 1);
+				const float tx = fx - x0, ty = fy - y0;
+				const unsigned char *p00 = job.src + ((size_t)y0 * job.w + x0) * job.ch;
+				const unsigned char *p10 = job.src + ((size_t)y0 * job.w + x1) * job.ch;
+				const unsigned char *p01 = job.src + ((size_t)y1 * job.w + x0) * job.ch;
+				const unsigned char *p11 = job.src + ((size_t)y1 * job.w + x1) * job.ch;
+				for (int c = 0; c < 3; ++c)
+				{
+					const float p0 = p00[c] * (1 - tx) + p10[c] * tx;
+					const float p1 = p01[c] * (1 - tx) + p11[c] * tx;
+					out[x * 4 + c] = (unsigned char)std::clamp(p0 * (1 - ty) + p1 * ty, 0.0f, 255.0f);
+				}
+				out[x * 4 + 3] = 255;
+			}
+		}
+	}
+
+	// Claim and convert bands until none is left
+	void drainBands(EquirectJob &job)
+	{
+		size_t converted = 0;
+		for (size_t i = job.next++; i < job.bands; i = job.next++)
+		{
+			const int f = (int)(i / job.bandsPerFace);
+			const int y0 = (int)((i % job.bandsPerFace) * kBandRows);
+			convertRows(job, f, y0, std::min(job.faceSize, y0 + (int)kBandRows));
+			++converted;
+		}
+		if (!converted)
+			return;
+		std::lock_guard<std::mutex> lk(job.mutex);
+		job.done += converted;
+		if (job.done == job.bands)
+			job.cv.notify_all();
+	}
+
+	uint64_t fnv1a(const unsigned char *data, size_t size)
+	{
+		uint64_t h = 0xcbf29ce484222325ULL;
+		for (size_t i = 0; i < size; ++i)
+		{
+			h ^= data[i];
+			h *= 0x100000001b3ULL;
+		}
+		return h;
+	}
+
+	const char		kCacheMagic[4] = {'F', 'T', 'V', 'C'};
+	const uint32_t	kCacheVersion = 1;
+
+	std::string cachePath(uint64_t sourceHash, int faceSize)
+	{
+		char name[64];
+		std::snprintf(name, sizeof(name), "/sky_%016llx_%d.cube", (unsigned long long)sourceHash, faceSize);
+		return std::string(SKYBOX_CACHE_DIR) + name;
+	}
+
+	// Raw cubemap: magic, version, source hash, face size, then 6 RGBA faces
+	bool readCache(const std::string &path, uint64_t sourceHash, int faceSize, Skybox::CubeFaces &out)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+		char magic[4];
+		uint32_t version = 0, size = 0;
+		uint64_t hash = 0;
+		file.read(magic, 4);
+		file.read(reinterpret_cast<char *>(&version), sizeof(version));
+		file.read(reinterpret_cast<char *>(&hash), sizeof(hash));
+		file.read(reinterpret_cast<char *>(&size), sizeof(size));
+		if (!file || std::memcmp(magic, kCacheMagic, 4) != 0 || version != kCacheVersion
+			|| hash != sourceHash || (int)size != faceSize)
+			return false;
+		const size_t faceBytes = (size_t)faceSize * faceSize * 4;
+		for (int f = 0; f < 6; ++f)
+		{
+			out.faces[f].resize(faceBytes);
+			if (!file.read(reinterpret_cast<char *>(out.faces[f].data()), faceBytes))
+				return false;
+		}
+		out.size = faceSize;
+		return true;
+	}
+
+	void writeCache(const std::string &path, uint64_t sourceHash, const Skybox::CubeFaces &faces)
+	{
+		mkdir(SKYBOX_CACHE_DIR, 0755);
+		// Write aside then rename, a crash never leaves a truncated cache
+		const std::string tmp = path + ".tmp";
+		{
+			std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+			const uint32_t size = (uint32_t)faces.size;
+			file.write(kCacheMagic, 4);
+			file.write(reinterpret_cast<const char *>(&kCacheVersion), sizeof(kCacheVersion));
+			file.write(reinterpret_cast<const char *>(&sourceHash), sizeof(sourceHash));
+			file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+			for (int f = 0; f < 6; ++f)
+				file.write(reinterpret_cast<const char *>(faces.faces[f].data()), faces.faces[f].size());
+			if (!file)
+			{
+				std::cerr << "[Skybox] Cannot write cache " << tmp << std::endl;
+				return;
+			}
+		}
+		if (std::rename(tmp.c_str(), path.c_str()) != 0)
+			std::cerr << "[Skybox] Cannot write cache " << path << std::endl;
 	}
-	outRGBA[3] = 255;
 }
 
-bool Skybox::loadFromEquirectPNG(const char* filename, int faceSize)
+bool Skybox::loadFromEquirectPNG(const char* filename, int faceSize, ThreadPool *pool)
 {
-	int w=0,h=0,n=0;
-	stbi_uc* data = stbi_load(filename, &w, &h, &n, 0);
-	if (!data) {
+	CubeFaces faces;
+	return decodeEquirectPNG(filename, faceSize, faces, pool) && uploadFaces(faces);
+}
+
+bool Skybox::decodeEquirectPNG(const char* filename, int faceSize, CubeFaces &out, ThreadPool *pool)
+{
+	std::ifstream file(filename, std::ios::binary);
+	std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if (bytes.empty()) {
 		std::cerr << "[Skybox] Failed to load PNG: " << filename << std::endl;
 		return false;
 	}
-	if (w <= 0 || h <= 0 || (n != 3 && n != 4)) {
-		std::cerr << "[Skybox] Unsupported PNG format: " << filename << std::endl;
-		stbi_image_free(data);
+	int w=0,h=0,n=0;
+	if (!stbi_info_from_memory(bytes.data(), (int)bytes.size(), &w, &h, &n)) {
+		std::cerr << "[Skybox] Failed to load PNG: " << filename << std::endl;
 		return false;
 	}
 	if (faceSize <= 0) {
@@ -201,51 +371,54 @@ bool Skybox::loadFromEquirectPNG(const char* filename, int faceSize)
 		faceSize = std::max(16, std::min(w / 4, h / 2));
 	}
 
-	if (!textureID) glGenTextures(1, &textureID);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+	// Same source bytes and face size: the faces from a previous run
+	const uint64_t hash = fnv1a(bytes.data(), bytes.size());
+	const std::string cache = cachePath(hash, faceSize);
+	if (readCache(cache, hash, faceSize, out))
+		return true;
 
-	auto faceDir = [&](int face, float a, float b){
-		// a,b in [-1,1]
-		glm::vec3 d(0.0f);
-		switch (face) {
-			case 0: d = glm::normalize(glm::vec3( 1.0f,   -b,   -a)); break; // +X
-			case 1: d = glm::normalize(glm::vec3(-1.0f,   -b,    a)); break; // -X
-			case 2: d = glm::normalize(glm::vec3(  a,  1.0f,    b)); break; // +Y
-			case 3: d = glm::normalize(glm::vec3(  a, -1.0f,   -b)); break; // -Y
-			case 4: d = glm::normalize(glm::vec3(  a,   -b,  1.0f)); break; // +Z
-			case 5: d = glm::normalize(glm::vec3( -a,   -b, -1.0f)); break; // -Z
-		}
-		return d;
-	};
-
-	std::vector<unsigned char> face(faceSize * faceSize * 4);
-	for (int f = 0; f < 6; ++f) {
-		for (int y = 0; y < faceSize; ++y) {
-			for (int x = 0; x < faceSize; ++x) {
-				float a = 2.0f * ((x + 0.5f) / faceSize) - 1.0f;
-				float b = 2.0f * ((y + 0.5f) / faceSize) - 1.0f;
-				glm::vec3 d = faceDir(f, a, b);
-				// Equirectangular mapping
-				float u = (std::atan2(d.z, d.x) + (float)M_PI) / (2.0f * (float)M_PI);
-				float v = std::acos(std::clamp(d.y, -1.0f, 1.0f)) / (float)M_PI;
-				sampleEquirectBilinear(data, w, h, n, u, v, &face[(y * faceSize + x) * 4]);
-			}
-		}
-		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + f, 0, GL_RGBA, faceSize, faceSize, 0,
-						GL_RGBA, GL_UNSIGNED_BYTE, face.data());
+	stbi_uc* data = stbi_load_from_memory(bytes.data(), (int)bytes.size(), &w, &h, &n, 0);
+	if (!data) {
+		std::cerr << "[Skybox] Failed to load PNG: " << filename << std::endl;
+		return false;
+	}
+	if (w <= 0 || h <= 0 || (n != 3 && n != 4)) {
+		std::cerr << "[Skybox] Unsupported PNG format: " << filename << std::endl;
+		stbi_image_free(data);
+		return false;
 	}
 
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-	glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	out.size = faceSize;
+	auto job = std::make_shared<EquirectJob>();
+	job->src = data;
+	job->w = w;
+	job->h = h;
+	job->ch = n;
+	job->faceSize = faceSize;
+	for (int f = 0; f < 6; ++f)
+	{
+		out.faces[f].resize((size_t)faceSize * faceSize * 4);
+		job->faces[f] = out.faces[f].data();
+	}
+	job->bandsPerFace = ((size_t)faceSize + kBandRows - 1) / kBandRows;
+	job->bands = job->bandsPerFace * 6;
 
+	// Helpers hold the job alive: one starting after the caller returned
+	// finds no band left and touches nothing else
+	if (pool)
+	{
+		const size_t helpers = std::min<size_t>(job->bands, std::max(1u, std::thread::hardware_concurrency())) - 1;
+		for (size_t i = 0; i < helpers; ++i)
+			pool->enqueue([job]() { drainBands(*job); });
+	}
+	drainBands(*job);
+	{
+		std::unique_lock<std::mutex> lk(job->mutex);
+		job->cv.wait(lk, [&]() { return job->done == job->bands; });
+	}
 	stbi_image_free(data);
-	// std::cerr << "[Skybox] Built cubemap from equirect PNG: " << filename
-	// 			<< " faceSize=" << faceSize << std::endl;
+
+	writeCache(cache, hash, out);
 	return true;
 }
 
@@ -270,6 +443,12 @@ bool Skybox::loadFromEquirectPNG(const char* filename, int faceSize)
 // }
 
 bool Skybox::loadFromSinglePNG(const char* filename, bool fixSeams)
+{
+	CubeFaces faces;
+	return decodeSinglePNG(filename, fixSeams, faces) && uploadFaces(faces);
+}
+
+bool Skybox::decodeSinglePNG(const char* filename, bool fixSeams, CubeFaces &out)
 {
 	int W=0,H=0,N=0;
 	stbi_uc* data = stbi_load(filename, &W, &H, &N, 0);
@@ -316,8 +495,8 @@ bool Skybox::loadFromSinglePNG(const char* filename, bool fixSeams)
 		return false;
 	}
 
-	std::vector<unsigned char> facesRGBA[6];
-	auto up = GL_TEXTURE_CUBE_MAP_POSITIVE_X;
+	std::vector<unsigned char> *facesRGBA = out.faces;
+	out.size = face;
 
 	if (layout==HCROSS)
 	{
@@ -432,10 +611,17 @@ bool Skybox::loadFromSinglePNG(const char* filename, bool fixSeams)
 		avgCols(facesRGBA[3], facesRGBA[0], false);
 	}
 
+	return true;
+}
+
+bool Skybox::uploadFaces(const CubeFaces &faces)
+{
+	if (faces.size <= 0)
+		return false;
 	if (!textureID) glGenTextures(1, &textureID);
 	glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
 	for (int i=0;i<6;++i) {
-		glTexImage2D(up + i, 0, GL_RGBA, face, face, 0, GL_RGBA, GL_UNSIGNED_BYTE, facesRGBA[i].data());
+		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, faces.size, faces.size, 0, GL_RGBA, GL_UNSIGNED_BYTE, faces.faces[i].data());
 	}
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -444,6 +630,5 @@ bool Skybox::loadFromSinglePNG(const char* filename, bool fixSeams)
 	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 	glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-	// std::cerr << "[Skybox] Built cubemap from single PNG: " << filename << " faceSize="<<face<<" layout="<<layout << std::endl;
-return true;
+	return true;
 }
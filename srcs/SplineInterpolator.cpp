@@ -61,11 +61,49 @@ void SplineInterpolator::setupData()
 		b[j] = (points[j + 1].y - points[j].y) / h[j] - h[j] * (c[j + 1] + 2.0 * c[j]) / 3.0;
 		d[j] = (c[j + 1] - c[j]) / (3.0 * h[j]);
 	}
+	bakeTable();
 }
 
-
+void SplineInterpolator::bakeTable()
+{
+	tableMin = points.front().x;
+	tableMax = points.back().x;
+	tableScale = SPLINE_LUT_SIZE / (tableMax - tableMin);
+	table.resize(SPLINE_LUT_SIZE + 1);
+	for (int i = 0; i <= SPLINE_LUT_SIZE; ++i)
+		table[i] = evaluate(tableMin + (tableMax - tableMin) * i / SPLINE_LUT_SIZE);
+}
 
 double SplineInterpolator::interpolate(double x) const {
+	if (table.empty() || !(x >= tableMin && x <= tableMax))
+		return 0.0;
+	const double t = (x - tableMin) * tableScale;
+	const int i = std::min(static_cast<int>(t), SPLINE_LUT_SIZE - 1);
+	const double f = t - i;
+	return table[i] + (table[i + 1] - table[i]) * f;
+}
+
+// Same as the scalar lookup without branches in the loop body, so the
+// compiler can vectorise it (the gathers stay scalar)
+void SplineInterpolator::interpolate(const double *xs, double *out, size_t count) const {
+	if (table.empty())
+	{
+		std::fill_n(out, count, 0.0);
+		return;
+	}
+	const double *lut = table.data();
+	const double mn = tableMin, mx = tableMax, scale = tableScale;
+	for (size_t k = 0; k < count; ++k)
+	{
+		const bool inside = xs[k] >= mn && xs[k] <= mx;
+		const double t = ((inside ? xs[k] : mn) - mn) * scale;
+		const int i = std::min(static_cast<int>(t), SPLINE_LUT_SIZE - 1);
+		const double f = t - i;
+		out[k] = inside ? lut[i] + (lut[i + 1] - lut[i]) * f : 0.0;
+	}
+}
+
+double SplineInterpolator::evaluate(double x) const {
 	if (x < points.front().x || x > points.back().x)
 		return 0.0;
 
@@ -9,6 +9,9 @@
 #include <unistd.h>
 #endif
 
+// Flower instance layout: vec4 (xyz pos, rot), vec2 (scale, heightScale), int typeId
+static const GLsizei kFlowerStride = (GLsizei)(sizeof(float) * 6 + sizeof(int));
+
 static glm::mat4 makeObliqueProjection(const glm::mat4 &proj,
 									   const glm::mat4 &view,
 									   const glm::vec4 &planeWorld)
@@ -41,37 +44,6 @@ float mapExpo(float x, float in_min, float in_max, float out_min, float out_max)
 	return out_min * std::pow(out_max / out_min, t); // exponential interpolation
 }
 
-bool isTransparent(char block)
-{
-	// Treat CACTUS like LOG for face-visibility decisions so ground caps render
-	// under the inset mesh (prevents a visible ring gap around the base).
-	return block == AIR || block == WATER || block == LOG || block == CACTUS || block == LEAF || block == FLOWER_POPPY || block == FLOWER_DANDELION || block == FLOWER_CYAN || block == FLOWER_SHORT_GRASS || block == FLOWER_DEAD_BUSH;
-}
-
-// Display logs only if sides
-bool faceDisplayCondition(char blockToDisplay, char neighborBlock, Direction dir)
-{
-	// For leaves: always show faces, but if neighbor is also a leaf, only
-	// emit the face for positive-axis directions to avoid z-fighting between
-	// coincident quads (keep one of the two faces).
-	if (blockToDisplay == LEAF)
-	{
-		if (neighborBlock == LEAF)
-		{
-			return (dir == EAST || dir == UP || dir == SOUTH);
-		}
-		return true; // non-leaf neighbor: show the face regardless
-	}
-
-	// Apply the same neighboring-face rule used for logs to cactuses:
-	// always render side faces even when adjacent to the same block type.
-	const bool isLogOrCactus = (blockToDisplay == LOG || blockToDisplay == CACTUS);
-	if (isLogOrCactus && dir <= EAST)
-		return true;
-
-	return (isTransparent(neighborBlock) && blockToDisplay != neighborBlock);
-}
-
 static inline void glResetActiveTextureTo0()
 {
 	glActiveTexture(GL_TEXTURE0);
@@ -91,6 +63,127 @@ static inline void glCleanupTextureState()
 	glUnbindCommonTextures();
 }
 
+static const std::vector<std::pair<TextureType, std::string>> kBlockTextures = {
+	{T_DIRT, "textures/dirt.ppm"},
+	{T_COBBLE, "textures/cobble.ppm"},
+	{T_STONE, "textures/stone.ppm"},
+	{T_GRASS_SIDE, "textures/grass_block_side.ppm"},
+	{T_GRASS_TOP, "textures/grass_block_top_colored.ppm"},
+	{T_SAND, "textures/sand.ppm"},
+	{T_WATER, "textures/water.ppm"},
+	{T_SNOW, "textures/snow.ppm"},
+	{T_BEDROCK, "textures/bedrock.ppm"},
+	{T_LOG_SIDE, "textures/log_side.ppm"},
+	{T_LOG_TOP, "textures/log_top.ppm"},
+	{T_LEAF, "textures/leave.png"},
+	{T_CACTUS_SIDE, "textures/cactus_side.ppm"},
+	{T_CACTUS_TOP,  "textures/cactus_top.ppm"},
+};
+
+static double msSince(std::chrono::steady_clock::time_point t)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t).count();
+}
+
+// Result of a startup job; adds the time the GL thread spent blocked on it
+template <typename T>
+static T awaitStartupJob(std::future<T> &job, double &waitedMs)
+{
+	const auto t0 = std::chrono::steady_clock::now();
+	T value = job.get();
+	waitedMs += msSince(t0);
+	return value;
+}
+
+// Decode one flower sprite to RGBA. Sprites without alpha get their
+// background (majority corner color) carved out by an edge flood-fill.
+static bool decodeFlowerImage(const std::string &file, DecodedImage &img)
+{
+	int w = 0, h = 0, ch = 0;
+	unsigned char *data = stbi_load(file.c_str(), &w, &h, &ch, 4);
+	if (!data)
+		return false;
+	bool anyTransparent = false;
+	for (int i = 0; i < w * h; ++i) if (data[4 * i + 3] < 255) { anyTransparent = true; break; }
+	if (!anyTransparent && w > 1 && h > 1)
+	{
+		auto getPx = [&](int x, int y) -> glm::ivec3 { unsigned char* p = data + 4*(y*w + x); return {p[0],p[1],p[2]}; };
+		glm::ivec3 corners[4] = {getPx(0,0), getPx(w-1,0), getPx(0,h-1), getPx(w-1,h-1)};
+		glm::ivec3 key = corners[0];
+		int best = 1;
+		for (int i = 0; i < 4; ++i) {
+			int cnt = 0; for (int j = 0; j < 4; ++j) if (glm::all(glm::equal(corners[i], corners[j]))) cnt++;
+			if (cnt > best) { best = cnt; key = corners[i]; }
+		}
+		auto nearKey = [&](unsigned char r, unsigned char g, unsigned char b){
+			int dr = int(r) - key.r; int dg = int(g) - key.g; int db = int(b) - key.b;
+			return (abs(dr) + abs(dg) + abs(db)) <= 96; // generous threshold
+		};
+		std::vector<uint8_t> mark(w*h, 0);
+		std::deque<std::pair<int,int>> q;
+		auto push = [&](int x,int y){ if(x<0||y<0||x>=w||y>=h) return; int i=y*w+x; if(mark[i]) return; unsigned char* p=data+4*i; if(nearKey(p[0],p[1],p[2])){ mark[i]=1; q.emplace_back(x,y);} };
+		for(int x=0;x<w;x++){ push(x,0); push(x,h-1);} for(int y=0;y<h;y++){ push(0,y); push(w-1,y);}
+		const int dx[8]={-1,0,1,-1,1,-1,0,1}; const int dy[8]={-1,-1,-1,0,0,1,1,1};
+		while(!q.empty()){
+			auto [x,y]=q.front(); q.pop_front();
+			for(int k=0;k<8;k++){ int nx=x+dx[k], ny=y+dy[k]; if(nx<0||ny<0||nx>=w||ny>=h) continue; int idx=ny*w+nx; if(mark[idx]) continue; unsigned char* p=data+4*idx; if(nearKey(p[0],p[1],p[2])){ mark[idx]=1; q.emplace_back(nx,ny);} }
+		}
+		for(int i=0;i<w*h;i++) if(mark[i]){ unsigned char* p=data+4*i; p[0]=p[1]=p[2]=0; p[3]=0; }
+	}
+	img.width = w;
+	img.height = h;
+	img.pixels.assign(data, data + (size_t)w * h * 4);
+	stbi_image_free(data);
+	return true;
+}
+
+// Flower layers at the first layer's size (nearest resize), transparent
+// texels zeroed to avoid fringes. A layer that fails to load stays empty.
+static std::vector<DecodedImage> decodeFlowerTextures(const std::vector<std::string> &files)
+{
+	std::vector<DecodedImage> layers(files.size());
+	for (size_t layer = 0; layer < files.size(); ++layer)
+	{
+		DecodedImage &img = layers[layer];
+		if (!decodeFlowerImage(files[layer], img))
+		{
+			if (layer == 0)
+				break;
+			continue;
+		}
+		const int w = layers[0].width, h = layers[0].height;
+		if (img.width != w || img.height != h)
+		{
+			std::vector<unsigned char> resized((size_t)w * h * 4);
+			for (int y = 0; y < h; ++y)
+			{
+				for (int x = 0; x < w; ++x)
+				{
+					int sx = x * img.width / w;
+					int sy = y * img.height / h;
+					const unsigned char *sp = img.pixels.data() + 4 * (sy * img.width + sx);
+					unsigned char *dp = resized.data() + 4 * (y * w + x);
+					dp[0] = sp[0];
+					dp[1] = sp[1];
+					dp[2] = sp[2];
+					dp[3] = sp[3];
+				}
+			}
+			img.pixels.swap(resized);
+			img.width = w;
+			img.height = h;
+		}
+		for (int i = 0; i < w * h; ++i)
+		{
+			if (img.pixels[4 * i + 3] == 0)
+			{
+				img.pixels[4 * i + 0] = img.pixels[4 * i + 1] = img.pixels[4 * i + 2] = 0;
+			}
+		}
+	}
+	return layers;
+}
+
 void StoneEngine::updateFboWindowSize(PostProcessShader &shader)
 {
 	float texelX = 1.0f / windowWidth;
@@ -104,20 +197,28 @@ void StoneEngine::updateFboWindowSize(PostProcessShader &shader)
 StoneEngine::StoneEngine(int seed, ThreadPool &pool) : camera(),
 													   _pool(pool),
 													   noise_gen(seed),
+													   _farTerrain(seed, pool),
 													   _chunkMgr(seed, &_isRunning, camera, chronoHelper, pool),
 													   _player(camera, _chunkMgr)
 {
+	_startupBegin = _startupLastMark = std::chrono::steady_clock::now();
 	initData();
+	startStartupJobs();
 	initGLFW();
+	markStartup("window + GL context");
 	initGLEW();
+	markStartup("GLEW");
 	initTextures();
+	markStartup("block textures upload");
 	initRenderShaders();
+	markStartup("shaders, skybox, flowers");
 	initShadowMapping();
 	initDebugTextBox();
 	initHelpTextBox();
 	initFboShaders();
 	reshapeAction(windowWidth, windowHeight);
 	_chunkMgr.initGLBuffer();
+	markStartup("framebuffers, UI, chunk buffers");
 
 	// Show a splash while the first mesh arrives
 	_splashDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(LOADING_SPLASH_MS);
@@ -125,6 +226,9 @@ StoneEngine::StoneEngine(int seed, ThreadPool &pool) : camera(),
 
 StoneEngine::~StoneEngine()
 {
+	// run() never reached: the spawn thread may still be generating
+	if (_spawnThread.joinable())
+		_spawnThread.join();
 	// Ensure the GL context is current during teardown
 	if (_window) glfwMakeContextCurrent(_window);
 	// Drain any in-flight GPU work before deleting GL objects
@@ -134,6 +238,7 @@ StoneEngine::~StoneEngine()
 
 	// Teardown GL resources owned by helper classes while context is valid
 	_skybox.shutdownGL();
+	_farTerrain.shutdownGL();
 	_textureManager.shutdownGL();
 	debugBox.shutdownGL();
 	helpBox.shutdownGL();
@@ -178,6 +283,9 @@ StoneEngine::~StoneEngine()
 		glDeleteBuffers(1, &flowerVBO);
 	if (flowerInstanceVBO)
 		glDeleteBuffers(1, &flowerInstanceVBO);
+	_chunkMgr.getMemoryGovernor().sub(MEM_FLOWERS, (size_t)_flowerInstanceCap * kFlowerStride);
+	if (flowerIndirectBuffer)
+		glDeleteBuffers(1, &flowerIndirectBuffer);
 	if (flowerTexture)
 		glDeleteTextures(1, &flowerTexture);
 
@@ -227,8 +335,10 @@ void StoneEngine::run()
 {
 	_isRunning = true;
 
-	// Set spawn point chunk and player pos
-	_chunkMgr.initSpawn();
+	// Spawn ring and player position, started with the startup jobs
+	if (_spawnThread.joinable())
+		_spawnThread.join();
+	markStartup("wait for spawn ring");
 
 	// Run the orchestrator on a dedicated thread so it doesn't consume a pool worker
 	std::thread chunkThread(&StoneEngine::updateChunkWorker, this);
@@ -304,43 +414,112 @@ void StoneEngine::initData()
 	_temperature = 0.0;
 }
 
+// Everything here needs no GL context: decoding runs on the pool and the
+// spawn ring on its own thread while the window and context are created.
+// The init* methods then only wait for and upload the results.
+void StoneEngine::startStartupJobs()
+{
+	_blockTexturesJob = _pool.enqueue([]() {
+		return TextureManager::loadTextureArrayData(kBlockTextures);
+	});
+	_waterNormalJob = _pool.enqueue([]() {
+		DecodedImage img;
+		int channels = 0;
+		unsigned char *data = stbi_load("textures/water_normal.jpg", &img.width, &img.height, &channels, 3);
+		if (data)
+		{
+			img.pixels.assign(data, data + (size_t)img.width * img.height * 3);
+			stbi_image_free(data);
+		}
+		return img;
+	});
+	_skyboxJob = _pool.enqueue([this]() {
+		Skybox::CubeFaces faces;
+		std::ifstream f(SKYBOX_SINGLE_PNG, std::ios::binary);
+		if (f.is_open())
+			Skybox::decodeSinglePNG(SKYBOX_SINGLE_PNG, /*fixSeams=*/true, faces);
+		else if (std::ifstream(SKYBOX_EQUIRECT_PNG, std::ios::binary).is_open())
+			Skybox::decodeEquirectPNG(SKYBOX_EQUIRECT_PNG, 0, faces, &_pool);
+		return faces;
+	});
+
+	const std::vector<std::string> fileList = {
+		"textures/flowers/poppy.png",
+		"textures/flowers/dandelion.png",
+		"textures/flowers/cyan_flower.png",
+		"textures/flowers/short_grass.png",
+		"textures/flowers/dead_bush.png"};
+	// Keep only files that exist
+	_flowerFiles.clear();
+	for (const auto &f : fileList)
+	{
+		std::ifstream s(f, std::ios::binary);
+		if (s.good())
+			_flowerFiles.push_back(f);
+	}
+	if (_flowerFiles.empty())
+	{
+		std::cerr << "No flower textures found in textures/flowers" << std::endl;
+	}
+	_flowerJob = _pool.enqueue(decodeFlowerTextures, _flowerFiles);
+
+	// Not a pool task: chunk generation itself waits on pool jobs.
+	// Chunk loading stops when _isRunning is false, so raise it now.
+	_isRunning = true;
+	_spawnThread = std::thread([this]() {
+		_chunkMgr.initSpawn();
+		_spawnReadyMs = msSince(_startupBegin);
+	});
+}
+
+void StoneEngine::markStartup(const char *step)
+{
+	const auto now = std::chrono::steady_clock::now();
+	_startupSteps.emplace_back(step, std::chrono::duration<double, std::milli>(now - _startupLastMark).count());
+	_startupLastMark = now;
+}
+
+void StoneEngine::reportStartup()
+{
+	_startupReported = true;
+	const int ring = 2 * SPAWN_RING_RADIUS + 1;
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(1) << "[Startup] GL thread:" << std::endl;
+	for (const auto &step : _startupSteps)
+		out << "  " << std::left << std::setw(34) << step.first << std::right << std::setw(8) << step.second << " ms" << std::endl;
+	const ShaderCacheStats &shaders = shaderCacheStats();
+	const int programs = shaders.hits + shaders.misses;
+	out << "  " << std::left << std::setw(34) << "(of which waiting on decodes)" << std::right << std::setw(8) << _startupWaitMs << " ms" << std::endl
+		<< "[Startup] shader cache: " << shaders.hits << "/" << programs << " programs from binaries ("
+		<< (programs ? 100.0 * shaders.hits / programs : 0.0) << "%), " << shaders.loadMs << " ms loading, "
+		<< shaders.compileMs << " ms compiling, ~" << shaders.savedMs << " ms saved" << std::endl
+		<< "[Startup] from launch:" << std::endl
+		<< "  " << std::left << std::setw(34) << "spawn ring resident" << std::right << std::setw(8) << _spawnReadyMs.load()
+		<< " ms (" << ring * ring << " chunks)" << std::endl
+		<< "  " << std::left << std::setw(34) << "first frame" << std::right << std::setw(8) << _firstFrameMs << " ms" << std::endl
+		<< "  " << std::left << std::setw(34) << "first world frame" << std::right << std::setw(8) << msSince(_startupBegin) << " ms" << std::endl;
+	std::cout << out.str();
+}
+
 void StoneEngine::initTextures()
 {
 	glEnable(GL_TEXTURE_2D);
-	_textureManager.loadTexturesArray({
-		{T_DIRT, "textures/dirt.ppm"},
-		{T_COBBLE, "textures/cobble.ppm"},
-		{T_STONE, "textures/stone.ppm"},
-		{T_GRASS_SIDE, "textures/grass_block_side.ppm"},
-		{T_GRASS_TOP, "textures/grass_block_top_colored.ppm"},
-		{T_SAND, "textures/sand.ppm"},
-		{T_WATER, "textures/water.ppm"},
-		{T_SNOW, "textures/snow.ppm"},
-		{T_BEDROCK, "textures/bedrock.ppm"},
-		{T_LOG_SIDE, "textures/log_side.ppm"},
-		{T_LOG_TOP, "textures/log_top.ppm"},
-		{T_LEAF, "textures/leave.png"},
-		{T_CACTUS_SIDE, "textures/cactus_side.ppm"},
-		{T_CACTUS_TOP,  "textures/cactus_top.ppm"},
-	});
+	_textureManager.uploadTextureArray(*awaitStartupJob(_blockTexturesJob, _startupWaitMs));
 
 	glGenTextures(1, &waterNormalMap);
 	glBindTexture(GL_TEXTURE_2D, waterNormalMap);
 
-	int width, height, nrChannels;
-	unsigned char *data = stbi_load("textures/water_normal.jpg", &width, &height, &nrChannels, 0);
-
-	if (data)
+	const DecodedImage waterNormal = awaitStartupJob(_waterNormalJob, _startupWaitMs);
+	if (!waterNormal.pixels.empty())
 	{
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0,
-					 GL_RGB, GL_UNSIGNED_BYTE, data);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, waterNormal.width, waterNormal.height, 0,
+					 GL_RGB, GL_UNSIGNED_BYTE, waterNormal.pixels.data());
 		glGenerateMipmap(GL_TEXTURE_2D);
 	}
 	else
 	{
 		std::cerr << "Failed to load water normal map!" << std::endl;
 	}
-	stbi_image_free(data);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
@@ -531,6 +710,8 @@ void StoneEngine::initRenderShaders()
 	initWireframeResources();
 	initSkybox();
 	initFlowerResources();
+	if (FAR_TERRAIN)
+		_farTerrain.initGL();
 }
 
 void StoneEngine::initShadowMapping()
@@ -560,21 +741,24 @@ void StoneEngine::rebuildShadowResources(int effectiveRender)
 
 	glGenFramebuffers(1, &shadowFBO);
 	glGenTextures(1, &shadowMap);
-	glBindTexture(GL_TEXTURE_2D, shadowMap);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24,
-			   shadowMapSize, shadowMapSize, 0,
+	glBindTexture(GL_TEXTURE_2D_ARRAY, shadowMap);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24,
+			   shadowMapSize, shadowMapSize, SHADOW_CASCADES, 0,
 			   GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 	float borderColor[4] = {1.0f, 1.0f, 1.0f, 1.0f};
-	glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, borderColor);
+	glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, borderColor);
+	// New storage: every cascade is drawn again
+	for (ShadowCascade &c : _cascades)
+		c.valid = false;
 
 	glBindFramebuffer(GL_FRAMEBUFFER, shadowFBO);
-	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, shadowMap, 0);
+	glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, shadowMap, 0, 0);
 	glDrawBuffer(GL_NONE);
 	glReadBuffer(GL_NONE);
 	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
@@ -592,16 +776,8 @@ void StoneEngine::setShadowResolution(int newSize)
 
 void StoneEngine::initSkybox()
 {
-	// std::cerr << "[Skybox] Init starting..." << std::endl;
-	// First: single-file PNG (cross/strip/grid)
-	{
-		std::ifstream f(SKYBOX_SINGLE_PNG, std::ios::binary);
-		if (f.is_open())
-		{
-			_hasSkybox = _skybox.loadFromSinglePNG(SKYBOX_SINGLE_PNG, /*fixSeams=*/true);
-			// if (_hasSkybox) std::cerr << "[Skybox] Using single-file PNG: " << SKYBOX_SINGLE_PNG << std::endl;
-		}
-	}
+	// Single-file PNG (cross/strip/grid) or equirect panorama, decoded by startStartupJobs
+	_hasSkybox = _skybox.uploadFaces(awaitStartupJob(_skyboxJob, _startupWaitMs));
 	if (!_hasSkybox)
 	{
 		std::cerr << "[Skybox] No skybox loaded (PNG)." << std::endl;
@@ -770,11 +946,19 @@ void StoneEngine::initDebugTextBox()
 	debugBox.addLine("FPS: ", Textbox::DOUBLE, &fps);
 	debugBox.addLine("Triangles: ", Textbox::INT, &drawnTriangles);
 	debugBox.addLine("Chunk Memory: ", Textbox::SIZE_T, _chunkMgr.getMemorySizePtr());
+	debugBox.addLine("Mesh Memory: ", Textbox::SIZE_T, _chunkMgr.getMemoryGovernor().getUsagePtr(MEM_MESHES));
+	debugBox.addLine("Noise Memory: ", Textbox::SIZE_T, _chunkMgr.getMemoryGovernor().getUsagePtr(MEM_NOISE));
+	debugBox.addLine("GPU Memory: ", Textbox::SIZE_T, _chunkMgr.getMemoryGovernor().getUsagePtr(MEM_GPU));
+	debugBox.addLine("Total Memory: ", Textbox::SIZE_T, _chunkMgr.getMemoryGovernor().getTotalPtr());
 	debugBox.addLine("RenderDistance: ", Textbox::INT, _chunkMgr.getRenderDistancePtr());
 	debugBox.addLine("CurrentRender: ", Textbox::INT, _chunkMgr.getCurrentRenderPtr());
 	debugBox.addLine("Chunks Cached: ", Textbox::INT, _chunkMgr.getCachedChunksCountPtr());
 	debugBox.addLine("Chunks Displayed: ", Textbox::INT, _chunkMgr.getDisplayedChunksCountPtr());
 	debugBox.addLine("Chunks Modified: ", Textbox::INT, _chunkMgr.getModifiedChunksCountPtr());
+	debugBox.addLine("Chunks Prefetched: ", Textbox::INT, _chunkMgr.getPrefetchedChunksCountPtr());
+	debugBox.addLine("Prefetch Cancelled: ", Textbox::INT, _chunkMgr.getPrefetchCancelledCountPtr());
+	debugBox.addLine("Chunks Refining: ", Textbox::INT, _chunkMgr.getRefinePendingPtr());
+	debugBox.addLine("Hole Frames: ", Textbox::INT, _chunkMgr.getHoleFramesPtr());
 	debugBox.addLine("x: ", Textbox::FLOAT, &camPos->x);
 	debugBox.addLine("y: ", Textbox::FLOAT, yPos);
 	debugBox.addLine("z: ", Textbox::FLOAT, &camPos->z);
@@ -892,12 +1076,28 @@ void StoneEngine::activateRenderShader()
 	// Pass rotation-only view to terrain shader (camera-relative positions in VS)
 	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, value_ptr(viewRot));
 	glUniform3fv(glGetUniformLocation(shaderProgram, "lightColor"), 1, value_ptr(vec3(1.0f, 0.95f, 0.95f)));
-	glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "lightSpaceMatrix"), 1, GL_FALSE, glm::value_ptr(lightSpaceMatrix));
-	glUniform1f(glGetUniformLocation(shaderProgram, "shadowTexelWorld"), _shadowTexelWorld);
-	glUniform1f(glGetUniformLocation(shaderProgram, "shadowNear"), _shadowNear);
-	glUniform1f(glGetUniformLocation(shaderProgram, "shadowFar"), _shadowFar);
 	glUniform1f(glGetUniformLocation(shaderProgram, "shadowBiasSlope"), _shadowBiasSlope);
 	glUniform1f(glGetUniformLocation(shaderProgram, "shadowBiasConstant"), _shadowBiasConstant);
+	{
+		// Per cascade: light matrix, texel size, depth range and trusted XZ
+		// footprint (zero radius until first drawn)
+		glm::mat4	matrices[SHADOW_CASCADES];
+		float		texels[SHADOW_CASCADES];
+		float		ranges[SHADOW_CASCADES];
+		glm::vec4	footprints[SHADOW_CASCADES];
+		for (int i = 0; i < SHADOW_CASCADES; ++i) {
+			const ShadowCascade &c = _cascades[i];
+			matrices[i]   = c.lightSpace;
+			texels[i]     = c.texelWorld;
+			ranges[i]     = c.farPlane - c.nearPlane;
+			footprints[i] = glm::vec4(c.center, c.valid ? c.radius : 0.0f);
+		}
+		glUniform1i(glGetUniformLocation(shaderProgram, "cascadeCount"), SHADOW_CASCADES);
+		glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "cascadeMatrix"), SHADOW_CASCADES, GL_FALSE, glm::value_ptr(matrices[0]));
+		glUniform1fv(glGetUniformLocation(shaderProgram, "cascadeTexelWorld"), SHADOW_CASCADES, texels);
+		glUniform1fv(glGetUniformLocation(shaderProgram, "cascadeDepthRange"), SHADOW_CASCADES, ranges);
+		glUniform4fv(glGetUniformLocation(shaderProgram, "cascadeFootprint"), SHADOW_CASCADES, glm::value_ptr(footprints[0]));
+	}
 
 	// Pass camera world position explicitly for camera-relative rendering
 	vec3 camWorld = camera.getWorldPosition();
@@ -908,7 +1108,7 @@ void StoneEngine::activateRenderShader()
 	glUniform3fv(glGetUniformLocation(shaderProgram, "sunDir"), 1, glm::value_ptr(sunDir));
 
 	glActiveTexture(GL_TEXTURE4);
-	glBindTexture(GL_TEXTURE_2D, shadowMap);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, shadowMap);
 	glUniform1i(glGetUniformLocation(shaderProgram, "shadowMap"), 4);
 
 	glActiveTexture(GL_TEXTURE0);
@@ -921,98 +1121,66 @@ void StoneEngine::activateRenderShader()
 	glFrontFace(GL_CCW);
 }
 
+static_assert(SHADOW_CASCADES >= 1 && SHADOW_CASCADES <= 4, "terrain.frag samples up to 4 cascades");
+
 void StoneEngine::renderShadowMap()
 {
 	if (!shadowShaderProgram) return;
 	if (shadowMap == 0 || shadowFBO == 0)
 		rebuildShadowResources(RENDER_DISTANCE);
 
-	// ---------- Cached state: stabilize + avoid needless rebuilds ----------
-	static bool      inited = false;
-	static glm::vec3 cachedCenter(0.0f);
-	static glm::vec3 prevSunDir(0.0f);
-	static float     lastFov = -1.0f;
-	static int       freezeFrames = 0;
-
-	if (lastFov < 0.0f) lastFov = _fov;
-	if (std::abs(_fov - lastFov) > 0.25f) {
-		freezeFrames = 2;           // debounce FOV zoom changes
-		lastFov = _fov;
-	}
-	if (freezeFrames > 0) { --freezeFrames; return; }
-
-	// ---------- Sun dir depends only on time ----------
-	glm::vec3 sunDir = glm::normalize(computeSunDirection(timeValue));
-
-	// ---------- Grid-locked center near player (X/Z only) ----------
-	const float GRID = float(CHUNK_SIZE) * 4.0f;  // snap every 4 chunks (tweak 2..8)
-	glm::vec3 cam   = camera.getWorldPosition();
-	glm::vec3 center(
-		std::round(cam.x / GRID) * GRID,
-		float(OCEAN_HEIGHT) + 32.0f,               // fixed Y anchor to avoid vertical jitter
-		std::round(cam.z / GRID) * GRID
-	);
-
-	// ---------- Resolve world extent and quantize to texel steps ----------
-	const float worldExtentRaw  = std::max<float>(128.0f, float(RENDER_DISTANCE * CHUNK_SIZE));
-	const float halfWorldRaw    = worldExtentRaw;
-	const float texelWorldRaw   = (2.0f * halfWorldRaw) / float(shadowMapSize);
-	const float N               = 8.0f;                         // change extent only in N-texel steps
-	const float step            = std::max(texelWorldRaw * N, 1.0f);
-	const float halfWorld       = step * std::ceil(halfWorldRaw / step);
-
-	// ---------- Place light & build stable matrices (single cascade) ----------
-	const float shadowDist = std::max(halfWorld * 1.25f, 300.0f);
-	glm::vec3  up(0.0f, 0.0f, 1.0f);                             // Z-up
-	glm::vec3  lightPos = center + sunDir * shadowDist;
-	glm::mat4  lightView = glm::lookAt(lightPos, center, up);
-
-	_shadowNear = 1.0f;
-	_shadowFar  = shadowDist + halfWorld;
-
-	glm::mat4 lightProj = glm::ortho(-halfWorld, halfWorld,
-									 -halfWorld, halfWorld,
-									 _shadowNear, _shadowFar);
-
-	// Texel snapping: snap the projected center to the shadow map pixel grid
-	{
-		glm::mat4 VP = lightProj * lightView;
-		glm::vec4 origin = VP * glm::vec4(center, 1.0f);
-		origin *= float(shadowMapSize) * 0.5f;                   // NDC->texel space
-		glm::vec2 rounded = glm::floor(glm::vec2(origin) + 0.5f);
-		glm::vec2 offset  = (rounded - glm::vec2(origin)) * (2.0f / float(shadowMapSize));
-		lightProj[3][0] += offset.x;
-		lightProj[3][1] += offset.y;
+	const glm::vec3 sunDir = glm::normalize(computeSunDirection(timeValue));
+	const glm::vec3 cam = camera.getWorldPosition();
+	// Outer cascade spans the near radius, each inner one half the previous
+	const float outer = std::max<float>(128.0f, float(std::min(RENDER_DISTANCE, SHADOW_NEAR_RADIUS) * CHUNK_SIZE));
+	++_shadowFrame;
+
+	// Stale: the camera crossed the cascade's snap grid or the sun turned.
+	// Lost: the camera is about to leave what the cascade covers.
+	float		half[SHADOW_CASCADES];
+	glm::vec3	centers[SHADOW_CASCADES];
+	bool		stale[SHADOW_CASCADES];
+	bool		lost[SHADOW_CASCADES];
+	for (int i = 0; i < SHADOW_CASCADES; ++i) {
+		half[i] = std::max(32.0f, outer / float(1 << (SHADOW_CASCADES - 1 - i)));
+		const float grid = half[i] / 4.0f;
+		centers[i] = glm::vec3(
+			std::round(cam.x / grid) * grid,
+			float(OCEAN_HEIGHT) + 32.0f,               // fixed Y anchor to avoid vertical jitter
+			std::round(cam.z / grid) * grid
+		);
+		const ShadowCascade &c = _cascades[i];
+		const float cosDelta = glm::clamp(glm::dot(c.sunDir, sunDir), -1.0f, 1.0f);
+		stale[i] = !c.valid || centers[i].x != c.center.x || centers[i].z != c.center.z
+			|| glm::degrees(std::acos(cosDelta)) >= SHADOW_SUN_EPS_DEG;
+		lost[i] = !c.valid
+			|| std::max(std::abs(cam.x - c.center.x), std::abs(cam.z - c.center.z)) > half[i] / 2.0f;
+	}
+
+	// Cascade 0 follows the camera. The outer ones take turns, one per
+	// SHADOW_CASCADE_INTERVAL frames, unless the camera is leaving them.
+	bool draw[SHADOW_CASCADES];
+	bool any = false;
+	const int outerCount = SHADOW_CASCADES - 1;
+	int turn = -1;
+	if (outerCount > 0 && _shadowFrame % SHADOW_CASCADE_INTERVAL == 0)
+		for (int k = 0; k < outerCount && turn < 0; ++k) {
+			const int i = 1 + (_shadowCursor + k) % std::max(1, outerCount);
+			if (stale[i]) {
+				turn = i;
+				_shadowCursor = i % std::max(1, outerCount);
+			}
+		}
+	for (int i = 0; i < SHADOW_CASCADES; ++i) {
+		draw[i] = i == 0 ? stale[i] : (i == turn || lost[i]);
+		any = any || draw[i];
 	}
-
-	glm::mat4 newLightSpace = lightProj * lightView;
-	const float newTexelWorld = (2.0f * halfWorld) / float(shadowMapSize);
-
-	// ---------- Early-out: only update if center or sun changed enough ----------
-	bool centerMoved = !inited || center.x != cachedCenter.x || center.z != cachedCenter.z;
-	float cosDelta   = inited ? glm::clamp(glm::dot(glm::normalize(prevSunDir), sunDir), -1.0f, 1.0f) : 1.0f;
-	float degDelta   = glm::degrees(std::acos(cosDelta));
-	const float SUN_ANGLE_EPS = 0.25f;  // update only if sun rotated > 0.25°
-
-	if (inited && !centerMoved && degDelta < SUN_ANGLE_EPS) {
-		// Reuse previous shadow map contents without rebuilding this frame.
+	if (!any)
 		return;
-	}
-
-	// Commit stabilized parameters
-	inited             = true;
-	cachedCenter       = center;
-	prevSunDir         = sunDir;
-	_shadowCenter      = center;
-	lightSpaceMatrix   = newLightSpace;
-	_shadowTexelWorld  = newTexelWorld;
 
-	// ---------- Render the single shadow map ----------
 	glUseProgram(shadowShaderProgram);
-	glUniformMatrix4fv(glGetUniformLocation(shadowShaderProgram, "lightSpaceMatrix"), 1, GL_FALSE, glm::value_ptr(lightSpaceMatrix));
 	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 	glEnable(GL_DEPTH_TEST);
-	glEnable(GL_POLYGON_OFFSET_FILL);
 	glPolygonOffset(3.0f, 6.0f);
 
 	glActiveTexture(GL_TEXTURE0);
@@ -1021,30 +1189,71 @@ void StoneEngine::renderShadowMap()
 
 	// Shadow pass must NOT depend on screen-space occlusion
 	_chunkMgr.setOcclusionSource(0, 0, 0, glm::mat4(1.0f), glm::mat4(1.0f), glm::vec3(0.0f));
-	_chunkMgr.setRendererSyncMode(true);
 
 	glViewport(0, 0, shadowMapSize, shadowMapSize);
 	glBindFramebuffer(GL_FRAMEBUFFER, shadowFBO);
+	for (int i = 0; i < SHADOW_CASCADES; ++i)
+		if (draw[i])
+			renderShadowCascade(i, centers[i], half[i], sunDir);
+
+	// ---------- Restore state ----------
+	glDisable(GL_POLYGON_OFFSET_FILL);
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, windowWidth, windowHeight);
+	glUseProgram(0);
+}
+
+void StoneEngine::renderShadowCascade(int index, const glm::vec3 &center, float halfExtent, const glm::vec3 &sunDir)
+{
+	// ---------- Place light & build stable matrices ----------
+	const float shadowDist = std::max(halfExtent * 1.25f, 300.0f);
+	glm::vec3  up(0.0f, 0.0f, 1.0f);                             // Z-up
+	glm::vec3  lightPos = center + sunDir * shadowDist;
+	glm::mat4  lightView = glm::lookAt(lightPos, center, up);
+	const float nearPlane = 1.0f;
+	const float farPlane  = shadowDist + halfExtent;
+	glm::mat4 lightProj = glm::ortho(-halfExtent, halfExtent,
+									 -halfExtent, halfExtent,
+									 nearPlane, farPlane);
+
+	// Texel snapping: snap the projected center to the shadow map pixel grid
+	{
+		glm::mat4 VP = lightProj * lightView;
+		glm::vec4 origin = VP * glm::vec4(center, 1.0f);
+		origin *= float(shadowMapSize) * 0.5f;                   // NDC->texel space
+		glm::vec2 rounded = glm::floor(glm::vec2(origin) + 0.5f);
+		glm::vec2 offset  = (rounded - glm::vec2(origin)) * (2.0f / float(shadowMapSize));
+		lightProj[3][0] += offset.x;
+		lightProj[3][1] += offset.y;
+	}
+
+	ShadowCascade &c = _cascades[index];
+	c.lightSpace = lightProj * lightView;
+	c.center     = center;
+	c.sunDir     = sunDir;
+	// Terrain away from the anchor height projects off the layer first
+	c.radius     = halfExtent - std::min(halfExtent * 0.25f, float(CHUNK_SIZE));
+	c.texelWorld = (2.0f * halfExtent) / float(shadowMapSize);
+	c.nearPlane  = nearPlane;
+	c.farPlane   = farPlane;
+	c.valid      = true;
+
+	glUniformMatrix4fv(glGetUniformLocation(shadowShaderProgram, "lightSpaceMatrix"), 1, GL_FALSE, glm::value_ptr(c.lightSpace));
+	glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, shadowMap, 0, index);
 	glClear(GL_DEPTH_BUFFER_BIT);
 
+	// Culls into this cascade's own draw lists
 	_chunkMgr.setViewProj(lightView, lightProj);
 
 	// Solid geometry: cull FRONT faces in shadow pass as well
 	glEnable(GL_CULL_FACE);
 	glCullFace(GL_FRONT);
 	glFrontFace(GL_CCW);
-	_chunkMgr.renderSolidBlocks();
+	glEnable(GL_POLYGON_OFFSET_FILL);
+	_chunkMgr.renderSolidBlocksForCascade(index);
 	glDisable(GL_POLYGON_OFFSET_FILL);
 	_chunkMgr.renderTransparentBlocksNoCullForShadow();
-
-	_chunkMgr.setRendererSyncMode(false);
-
-	// ---------- Restore state ----------
-	glDisable(GL_POLYGON_OFFSET_FILL);
-	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glViewport(0, 0, windowWidth, windowHeight);
-	glUseProgram(0);
 }
 
 void StoneEngine::renderChunkGrid()
@@ -1253,6 +1462,15 @@ void StoneEngine::activateTransparentShader()
 	}
 }
 
+static inline uint32_t flowerCellHash(int x, int y, int z)
+{
+	uint32_t h = (uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u ^ (uint32_t)z * 83492791u;
+	h ^= h >> 16; h *= 0x7feb352du;
+	h ^= h >> 15; h *= 0x846ca68bu;
+	h ^= h >> 16;
+	return h;
+}
+
 void StoneEngine::initFlowerResources()
 {
 	// Create shader
@@ -1343,154 +1561,30 @@ void StoneEngine::initFlowerResources()
 	glEnableVertexAttribArray(1);
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)(3 * sizeof(float)));
 
-	// Instance buffer: vec4 (xyz pos, rot), vec2 (scale, heightScale), int typeId
-	glGenBuffers(1, &flowerInstanceVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, flowerInstanceVBO);
-	glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
-
-	GLsizei fStride = (GLsizei)(sizeof(float) * 6 + sizeof(int));
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, fStride, (void *)0);
-	glVertexAttribDivisor(2, 1);
-	glEnableVertexAttribArray(3);
-	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, fStride, (void *)(4 * sizeof(float)));
-	glVertexAttribDivisor(3, 1);
-	glEnableVertexAttribArray(4);
-	glVertexAttribIPointer(4, 1, GL_INT, fStride, (void *)(6 * sizeof(float)));
-	glVertexAttribDivisor(4, 1);
-
 	glBindVertexArray(0);
 
-	// Load flower texture from PNG with alpha (STB)
+	// Persistent instance buffer, subchunks own slot ranges inside it
+	_flowerInstanceCap = 0;
+	_flowerInstanceTop = 0;
+	_flowerFreeRanges.clear();
+	_flowerSlots.clear();
+	growFlowerInstanceBuffer(FLOWER_INSTANCE_INITIAL);
+	glGenBuffers(1, &flowerIndirectBuffer);
+
+	// Flower texture array, decoded by startStartupJobs
 	glGenTextures(1, &flowerTexture);
 	glBindTexture(GL_TEXTURE_2D_ARRAY, flowerTexture);
-	std::vector<std::string> fileList = {
-		"textures/flowers/poppy.png",
-		"textures/flowers/dandelion.png",
-		"textures/flowers/cyan_flower.png",
-		"textures/flowers/short_grass.png",
-		"textures/flowers/dead_bush.png"};
-	// Keep only files that exist
-	std::vector<std::string> files;
-	for (const auto &f : fileList)
-	{
-		std::ifstream s(f, std::ios::binary);
-		if (s.good())
-			files.push_back(f);
-	}
-	if (files.empty())
-	{
-		std::cerr << "No flower textures found in textures/flowers" << std::endl;
-	}
+	const std::vector<DecodedImage> layers = awaitStartupJob(_flowerJob, _startupWaitMs);
+	const std::vector<std::string> &files = _flowerFiles;
 	const int nfiles = (int)files.size();
-	int w = 0, h = 0, ch = 0;
-	unsigned char *data = (nfiles > 0) ? stbi_load(files[0].c_str(), &w, &h, &ch, 4) : nullptr;
-	if (data)
+	if (!layers.empty() && !layers[0].pixels.empty())
 	{
-		// Fallback: if no alpha present, carve background by edge flood-fill
-		bool anyTransparent0 = false;
-		for (int i = 0; i < w * h; ++i) if (data[4 * i + 3] < 255) { anyTransparent0 = true; break; }
-		if (!anyTransparent0 && w > 1 && h > 1)
-		{
-			auto getPx = [&](int x, int y) -> glm::ivec3 { unsigned char* p = data + 4*(y*w + x); return {p[0],p[1],p[2]}; };
-			glm::ivec3 corners[4] = {getPx(0,0), getPx(w-1,0), getPx(0,h-1), getPx(w-1,h-1)};
-			glm::ivec3 key = corners[0];
-			int best = 1;
-			for (int i = 0; i < 4; ++i) {
-				int cnt = 0; for (int j = 0; j < 4; ++j) if (glm::all(glm::equal(corners[i], corners[j]))) cnt++;
-				if (cnt > best) { best = cnt; key = corners[i]; }
-			}
-			auto nearKey = [&](unsigned char r, unsigned char g, unsigned char b){
-				int dr = int(r) - key.r; int dg = int(g) - key.g; int db = int(b) - key.b;
-				return (abs(dr) + abs(dg) + abs(db)) <= 96; // generous threshold
-			};
-			std::vector<uint8_t> mark(w*h, 0);
-			std::deque<std::pair<int,int>> q;
-			auto push = [&](int x,int y){ if(x<0||y<0||x>=w||y>=h) return; int i=y*w+x; if(mark[i]) return; unsigned char* p=data+4*i; if(nearKey(p[0],p[1],p[2])){ mark[i]=1; q.emplace_back(x,y);} };
-			for(int x=0;x<w;x++){ push(x,0); push(x,h-1);} for(int y=0;y<h;y++){ push(0,y); push(w-1,y);} 
-			const int dx[8]={-1,0,1,-1,1,-1,0,1}; const int dy[8]={-1,-1,-1,0,0,1,1,1};
-			while(!q.empty()){
-				auto [x,y]=q.front(); q.pop_front();
-				for(int k=0;k<8;k++){ int nx=x+dx[k], ny=y+dy[k]; if(nx<0||ny<0||nx>=w||ny>=h) continue; int idx=ny*w+nx; if(mark[idx]) continue; unsigned char* p=data+4*idx; if(nearKey(p[0],p[1],p[2])){ mark[idx]=1; q.emplace_back(nx,ny);} }
-			}
-			for(int i=0;i<w*h;i++) if(mark[i]){ unsigned char* p=data+4*i; p[0]=p[1]=p[2]=0; p[3]=0; }
-		}
-		// Zero RGB where fully transparent to avoid fringes
-		for (int i = 0; i < w * h; ++i)
-		{
-			if (data[4 * i + 3] == 0)
-			{
-				data[4 * i + 0] = data[4 * i + 1] = data[4 * i + 2] = 0;
-			}
-		}
+		const int w = layers[0].width, h = layers[0].height;
 		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, w, h, nfiles, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE, data);
-		stbi_image_free(data);
-		for (int layer = 1; layer < nfiles; ++layer)
+		for (int layer = 0; layer < nfiles; ++layer)
 		{
-			int ww = 0, hh = 0, cc = 0;
-			unsigned char *d = stbi_load(files[layer].c_str(), &ww, &hh, &cc, 4);
-			if (!d)
-				continue;
-			// Fallback: add alpha via border flood-fill if needed
-			bool anyTransparent = false;
-			for (int i = 0; i < ww * hh; ++i) if (d[4 * i + 3] < 255) { anyTransparent = true; break; }
-			if (!anyTransparent && ww > 1 && hh > 1)
-			{
-				auto getPx = [&](int x, int y) -> glm::ivec3 { unsigned char* p = d + 4*(y*ww + x); return {p[0],p[1],p[2]}; };
-				glm::ivec3 corners[4] = {getPx(0,0), getPx(ww-1,0), getPx(0,hh-1), getPx(ww-1,hh-1)};
-				glm::ivec3 key = corners[0];
-				int best = 1; for(int i2=0;i2<4;i2++){ int cnt=0; for(int j=0;j<4;j++) if(glm::all(glm::equal(corners[i2], corners[j]))) cnt++; if(cnt>best){best=cnt; key=corners[i2];}}
-				auto nearKey = [&](unsigned char r, unsigned char g, unsigned char b){ int dr=int(r)-key.r; int dg=int(g)-key.g; int db=int(b)-key.b; return (abs(dr)+abs(dg)+abs(db))<=96; };
-				std::vector<uint8_t> mark(ww*hh,0);
-				std::deque<std::pair<int,int>> q;
-				auto push=[&](int x,int y){ if(x<0||y<0||x>=ww||y>=hh) return; int i=y*ww+x; if(mark[i]) return; unsigned char* p=d+4*i; if(nearKey(p[0],p[1],p[2])){ mark[i]=1; q.emplace_back(x,y);} };
-				for(int x=0;x<ww;x++){ push(x,0); push(x,hh-1);} for(int y=0;y<hh;y++){ push(0,y); push(ww-1,y);} 
-				const int dx[8]={-1,0,1,-1,1,-1,0,1}; const int dy[8]={-1,-1,-1,0,0,1,1,1};
-				while(!q.empty()){
-					auto [x,y]=q.front(); q.pop_front();
-					for(int k=0;k<8;k++){ int nx=x+dx[k], ny=y+dy[k]; if(nx<0||ny<0||nx>=ww||ny>=hh) continue; int idx=ny*ww+nx; if(mark[idx]) continue; unsigned char* p=d+4*idx; if(nearKey(p[0],p[1],p[2])){ mark[idx]=1; q.emplace_back(nx,ny);} }
-				}
-				for(int i2=0;i2<ww*hh;i2++) if(mark[i2]){ unsigned char* p=d+4*i2; p[0]=p[1]=p[2]=0; p[3]=0; }
-			}
-			if (ww != w || hh != h)
-			{
-				std::vector<unsigned char> resized(w * h * 4);
-				for (int y = 0; y < h; ++y)
-				{
-					for (int x = 0; x < w; ++x)
-					{
-						int sx = x * ww / w;
-						int sy = y * hh / h;
-						unsigned char *sp = d + 4 * (sy * ww + sx);
-						unsigned char *dp = resized.data() + 4 * (y * w + x);
-						dp[0] = sp[0];
-						dp[1] = sp[1];
-						dp[2] = sp[2];
-						dp[3] = sp[3];
-					}
-				}
-				for (int i = 0; i < w * h; ++i)
-				{
-					if (resized[4 * i + 3] == 0)
-					{
-						resized[4 * i + 0] = resized[4 * i + 1] = resized[4 * i + 2] = 0;
-					}
-				}
-				glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE, resized.data());
-			}
-			else
-			{
-				for (int i = 0; i < w * h; ++i)
-				{
-					if (d[4 * i + 3] == 0)
-					{
-						d[4 * i + 0] = d[4 * i + 1] = d[4 * i + 2] = 0;
-					}
-				}
-				glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE, d);
-			}
-			stbi_image_free(d);
+			if (!layers[layer].pixels.empty())
+				glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, w, h, 1, GL_RGBA, GL_UNSIGNED_BYTE, layers[layer].pixels.data());
 		}
 		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -1520,102 +1614,213 @@ void StoneEngine::initFlowerResources()
 	{
 		std::cerr << "Failed to load flower texture array" << std::endl;
 	}
-
-	// Start empty; instances can be added at runtime
-	flowerInstanceCount = 0;
+}
+void StoneEngine::bindFlowerInstanceAttribs()
+{
+	glBindVertexArray(flowerVAO);
 	glBindBuffer(GL_ARRAY_BUFFER, flowerInstanceVBO);
-	glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, kFlowerStride, (void *)0);
+	glVertexAttribDivisor(2, 1);
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, kFlowerStride, (void *)(4 * sizeof(float)));
+	glVertexAttribDivisor(3, 1);
+	glEnableVertexAttribArray(4);
+	glVertexAttribIPointer(4, 1, GL_INT, kFlowerStride, (void *)(6 * sizeof(float)));
+	glVertexAttribDivisor(4, 1);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
-void StoneEngine::rebuildVisibleFlowersVBO()
+
+void StoneEngine::growFlowerInstanceBuffer(GLuint minCapacity)
+{
+	GLuint newCap = std::max<GLuint>(_flowerInstanceCap * 2, FLOWER_INSTANCE_INITIAL);
+	while (newCap < minCapacity)
+		newCap *= 2;
+
+	GLuint newVBO = 0;
+	glGenBuffers(1, &newVBO);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, newVBO);
+	glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)newCap * kFlowerStride, nullptr, GL_DYNAMIC_DRAW);
+	// Slots keep their offsets: copy the used range over on the GPU
+	if (flowerInstanceVBO && _flowerInstanceTop > 0)
+	{
+		glBindBuffer(GL_COPY_READ_BUFFER, flowerInstanceVBO);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)_flowerInstanceTop * kFlowerStride);
+		glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	if (flowerInstanceVBO)
+		glDeleteBuffers(1, &flowerInstanceVBO);
+	_chunkMgr.getMemoryGovernor().adjust(MEM_FLOWERS, (size_t)_flowerInstanceCap * kFlowerStride, (size_t)newCap * kFlowerStride);
+	flowerInstanceVBO = newVBO;
+	_flowerInstanceCap = newCap;
+	bindFlowerInstanceAttribs();
+}
+
+GLuint StoneEngine::allocFlowerRange(GLuint count)
 {
+	// First fit among released ranges
+	for (size_t i = 0; i < _flowerFreeRanges.size(); ++i)
 	{
-		std::vector<std::tuple<glm::ivec2, int, glm::ivec3, BlockType>> discovered;
-		_chunkMgr.fetchAndClearDiscoveredFlowers(discovered);
-		if (!discovered.empty())
+		auto &r = _flowerFreeRanges[i];
+		if (r.second < count)
+			continue;
+		GLuint first = r.first;
+		r.first += count;
+		r.second -= count;
+		if (r.second == 0)
+			_flowerFreeRanges.erase(_flowerFreeRanges.begin() + i);
+		return first;
+	}
+	if (_flowerInstanceTop + count > _flowerInstanceCap)
+		growFlowerInstanceBuffer(_flowerInstanceTop + count);
+	GLuint first = _flowerInstanceTop;
+	_flowerInstanceTop += count;
+	return first;
+}
+
+void StoneEngine::freeFlowerRange(GLuint first, GLuint count)
+{
+	if (count == 0)
+		return;
+	auto it = std::lower_bound(_flowerFreeRanges.begin(), _flowerFreeRanges.end(), std::make_pair(first, (GLuint)0));
+	size_t idx = (size_t)(it - _flowerFreeRanges.begin());
+	_flowerFreeRanges.insert(it, std::make_pair(first, count));
+	// Coalesce with the following then the preceding range
+	if (idx + 1 < _flowerFreeRanges.size()
+		&& _flowerFreeRanges[idx].first + _flowerFreeRanges[idx].second == _flowerFreeRanges[idx + 1].first)
+	{
+		_flowerFreeRanges[idx].second += _flowerFreeRanges[idx + 1].second;
+		_flowerFreeRanges.erase(_flowerFreeRanges.begin() + idx + 1);
+	}
+	if (idx > 0
+		&& _flowerFreeRanges[idx - 1].first + _flowerFreeRanges[idx - 1].second == _flowerFreeRanges[idx].first)
+	{
+		_flowerFreeRanges[idx - 1].second += _flowerFreeRanges[idx].second;
+		_flowerFreeRanges.erase(_flowerFreeRanges.begin() + idx);
+	}
+	// A free range ending at the top just lowers the top
+	if (!_flowerFreeRanges.empty())
+	{
+		const auto &last = _flowerFreeRanges.back();
+		if (last.first + last.second == _flowerInstanceTop)
 		{
-			static std::mt19937 rng{std::random_device{}()};
-			std::uniform_real_distribution<float> rotD(-0.26f, 0.26f);
-			std::uniform_real_distribution<float> scaD(0.95f, 1.05f);
-			for (auto &t : discovered)
-			{
-				const glm::ivec2 cpos = std::get<0>(t);
-				const int subY = std::get<1>(t);
-				const glm::ivec3 cell = std::get<2>(t);
-				const BlockType bt = std::get<3>(t);
-				int typeId = (_layerPoppy >= 0) ? _layerPoppy : 0;
-				if (bt == FLOWER_POPPY && _layerPoppy >= 0)
-					typeId = _layerPoppy;
-				else if (bt == FLOWER_DANDELION && _layerDandelion >= 0)
-					typeId = _layerDandelion;
-				else if (bt == FLOWER_CYAN && _layerCyan >= 0)
-					typeId = _layerCyan;
-				else if (bt == FLOWER_SHORT_GRASS && flowerShortGrassLayer >= 0)
-					typeId = flowerShortGrassLayer;
-				else if (bt == FLOWER_DEAD_BUSH && _layerDeadBush >= 0)
-					typeId = _layerDeadBush;
-				glm::vec3 center(cell.x + 0.5f, cell.y + 0.0f, cell.z + 0.5f);
-				// Poppy can appear slightly above ground; nudge it down a bit
-				if (bt == FLOWER_POPPY)
-					center.y -= 0.1f;
-				FlowerInstance inst{center, rotD(rng), scaD(rng), 1.0f, typeId};
-				_flowersBySub[cpos][subY].push_back(inst);
-			}
+			_flowerInstanceTop = last.first;
+			_flowerFreeRanges.pop_back();
 		}
 	}
-	std::vector<glm::ivec2> chunks;
-	_chunkMgr.getDisplayedChunksSnapshot(chunks);
-	std::unordered_map<glm::ivec2, std::unordered_set<int>, ivec2_hash> visibleSub;
-	_chunkMgr.getDisplayedSubchunksSnapshot(visibleSub);
+}
+
+int StoneEngine::flowerLayerFor(char type) const
+{
+	int layer = -1;
+	switch (type)
+	{
+		case FLOWER_POPPY:			layer = _layerPoppy; break;
+		case FLOWER_DANDELION:		layer = _layerDandelion; break;
+		case FLOWER_CYAN:			layer = _layerCyan; break;
+		case FLOWER_SHORT_GRASS:	layer = flowerShortGrassLayer; break;
+		case FLOWER_DEAD_BUSH:		layer = _layerDeadBush; break;
+		default: break;
+	}
+	if (layer < 0)
+		layer = (_layerPoppy >= 0) ? _layerPoppy : 0;
+	return layer;
+}
 
-	// Prune cached flower instances for chunks that are no longer displayed
-	// to avoid unbounded memory growth when roaming far.
-	if (!chunks.empty())
+void StoneEngine::applyFlowerUpdates()
+{
+	_flowerUpdates.clear();
+	_chunkMgr.fetchFlowerUpdates(_flowerUpdates);
+	for (const auto &u : _flowerUpdates)
 	{
-		std::unordered_set<glm::ivec2, ivec2_hash> keep;
-		keep.reserve(chunks.size());
-		for (const auto &c : chunks) keep.insert(c);
-		for (auto it = _flowersBySub.begin(); it != _flowersBySub.end(); )
+		auto &subs = _flowerSlots[u.cpos];
+		auto it = subs.find(u.subY);
+		const GLuint count = (GLuint)u.cells.size();
+		// Drop the slot when the list is empty or no longer fits in it
+		if (it != subs.end() && (count == 0 || it->second.capacity < count))
+		{
+			freeFlowerRange(it->second.first, it->second.capacity);
+			subs.erase(it);
+			it = subs.end();
+		}
+		if (count == 0)
 		{
-			if (keep.find(it->first) == keep.end()) it = _flowersBySub.erase(it);
-			else ++it;
+			if (subs.empty())
+				_flowerSlots.erase(u.cpos);
+			continue;
 		}
+		if (it == subs.end())
+		{
+			GLuint cap = (count + FLOWER_SLOT_GRANULARITY - 1) / FLOWER_SLOT_GRANULARITY * FLOWER_SLOT_GRANULARITY;
+			it = subs.emplace(u.subY, FlowerSlot{allocFlowerRange(cap), 0, cap}).first;
+		}
+		it->second.count = count;
+
+		// Rotation/scale jitter is hashed from the cell so a restaged subchunk looks the same
+		_flowerScratch.resize((size_t)count * kFlowerStride);
+		unsigned char *ptr = _flowerScratch.data();
+		const glm::ivec3 base(u.cpos.x * CHUNK_SIZE, u.subY * CHUNK_SIZE, u.cpos.y * CHUNK_SIZE);
+		for (uint32_t packed : u.cells)
+		{
+			const glm::ivec3 cell = base + glm::ivec3(packed & 31u, (packed >> 5) & 31u, (packed >> 10) & 31u);
+			const char type = (char)((packed >> 15) & 0xFFu);
+			const uint32_t h = flowerCellHash(cell.x, cell.y, cell.z);
+			const float rot = -0.26f + 0.52f * (float)(h & 0xFFFFu) / 65535.0f;
+			const float scale = 0.95f + 0.10f * (float)(h >> 16) / 65535.0f;
+			glm::vec3 center(cell.x + 0.5f, cell.y + 0.0f, cell.z + 0.5f);
+			// Poppy can appear slightly above ground; nudge it down a bit
+			if (type == FLOWER_POPPY)
+				center.y -= 0.1f;
+			float tmp[6] = {center.x, center.y, center.z, rot, scale, 1.0f};
+			const int typeId = flowerLayerFor(type);
+			memcpy(ptr, tmp, sizeof(tmp));
+			ptr += sizeof(tmp);
+			memcpy(ptr, &typeId, sizeof(int));
+			ptr += sizeof(int);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, flowerInstanceVBO);
+		glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)it->second.first * kFlowerStride,
+						(GLsizeiptr)_flowerScratch.size(), _flowerScratch.data());
 	}
-	_visibleFlowers.clear();
-	for (const auto &c : chunks)
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+GLsizei StoneEngine::buildFlowerDraws(const glm::mat4 &viewFull)
+{
+	_flowerCmds.clear();
+	if (_flowerSlots.empty())
+		return 0;
+	std::unordered_map<glm::ivec2, std::unordered_set<int>, ivec2_hash> visibleSub;
+	_chunkMgr.getDisplayedSubchunksSnapshot(visibleSub);
+	const Frustum frustum = Frustum::fromVP(projectionMatrix * viewFull);
+
+	for (const auto &kv : _flowerSlots)
 	{
-		auto it = _flowersBySub.find(c);
-		if (it == _flowersBySub.end())
-			continue;
-		auto visIt = visibleSub.find(c);
-		// Only render flowers for sublayers that are actually displayed.
-		// If there is no snapshot yet for this chunk, skip for now to avoid
-		// flowers appearing before terrain meshes.
-		if (visIt == visibleSub.end() || visIt->second.empty())
+		// Only render flowers for sublayers that are actually displayed,
+		// so plants never appear before their terrain mesh.
+		auto visIt = visibleSub.find(kv.first);
+		if (visIt == visibleSub.end())
 			continue;
-		const auto &allowed = visIt->second;
-		for (auto &kv : it->second)
+		for (const auto &sub : kv.second)
 		{
-			int subY = kv.first;
-			if (allowed.find(subY) == allowed.end())
+			if (visIt->second.find(sub.first) == visIt->second.end())
 				continue;
-			auto &vec = kv.second;
-			_visibleFlowers.insert(_visibleFlowers.end(), vec.begin(), vec.end());
+			// Plants stand on the top layer and can poke one block above it
+			glm::vec3 mn(kv.first.x * CHUNK_SIZE, sub.first * CHUNK_SIZE, kv.first.y * CHUNK_SIZE);
+			glm::vec3 mx = mn + glm::vec3(CHUNK_SIZE, CHUNK_SIZE + 1, CHUNK_SIZE);
+			if (!frustum.aabbVisible(mn, mx))
+				continue;
+			_flowerCmds.push_back(DrawArraysIndirectCommand{12, sub.second.count, 0, sub.second.first});
 		}
 	}
-	flowerInstanceCount = (GLsizei)_visibleFlowers.size();
-	std::vector<unsigned char> buffer;
-	buffer.resize(_visibleFlowers.size() * (sizeof(float) * 6 + sizeof(int)));
-	unsigned char *ptr = buffer.data();
-	for (const auto &f : _visibleFlowers)
-	{
-		float tmp[6] = {f.pos.x, f.pos.y, f.pos.z, f.rot, f.scale, f.heightScale};
-		memcpy(ptr, tmp, sizeof(tmp));
-		ptr += sizeof(tmp);
-		memcpy(ptr, &f.typeId, sizeof(int));
-		ptr += sizeof(int);
-	}
-	glBindBuffer(GL_ARRAY_BUFFER, flowerInstanceVBO);
-	glBufferData(GL_ARRAY_BUFFER, buffer.size(), buffer.data(), GL_DYNAMIC_DRAW);
+	if (_flowerCmds.empty())
+		return 0;
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, flowerIndirectBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, _flowerCmds.size() * sizeof(DrawArraysIndirectCommand), _flowerCmds.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	return (GLsizei)_flowerCmds.size();
 }
 
 void StoneEngine::renderFlowers()
@@ -1624,11 +1829,7 @@ void StoneEngine::renderFlowers()
 		return; // skip in wireframe mode
 	if (!flowerProgram || flowerVAO == 0)
 		return;
-	rebuildVisibleFlowersVBO();
-	if (flowerInstanceCount == 0)
-		return;
-
-	glUseProgram(flowerProgram);
+	applyFlowerUpdates();
 
 	// Build rotation-only view (same convention as terrain/water)
 	float radY = camera.getAngles().y * (M_PI / 180.0f);
@@ -1636,6 +1837,11 @@ void StoneEngine::renderFlowers()
 	glm::mat4 viewRot(1.0f);
 	viewRot = glm::rotate(viewRot, radY, glm::vec3(-1.0f, 0.0f, 0.0f));
 	viewRot = glm::rotate(viewRot, radX, glm::vec3(0.0f, -1.0f, 0.0f));
+	GLsizei drawCount = buildFlowerDraws(glm::translate(viewRot, glm::vec3(camera.getPosition())));
+	if (drawCount == 0)
+		return;
+
+	glUseProgram(flowerProgram);
 
 	glUniformMatrix4fv(glGetUniformLocation(flowerProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projectionMatrix));
 	glUniformMatrix4fv(glGetUniformLocation(flowerProgram, "view"), 1, GL_FALSE, glm::value_ptr(viewRot));
@@ -1657,7 +1863,9 @@ void StoneEngine::renderFlowers()
 	glDisable(GL_CULL_FACE);
 
 	glBindVertexArray(flowerVAO);
-	glDrawArraysInstanced(GL_TRIANGLES, 0, 12, flowerInstanceCount);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, flowerIndirectBuffer);
+	glMultiDrawArraysIndirect(GL_TRIANGLES, nullptr, drawCount, 0);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
 	glBindVertexArray(0);
 	glEnable(GL_CULL_FACE);
 	glActiveTexture(GL_TEXTURE0);
@@ -1665,36 +1873,6 @@ void StoneEngine::renderFlowers()
 	glCleanupTextureState();
 }
 
-void StoneEngine::addFlower(glm::vec3 pos, int typeId, float rotJitter, float scale, float heightScale)
-{
-	FlowerInstance inst{pos, rotJitter, scale, heightScale, typeId};
-	// Compute owning chunk and subchunk layer
-	glm::ivec2 cpos(
-		(int)std::floor(pos.x / (float)CHUNK_SIZE),
-		(int)std::floor(pos.z / (float)CHUNK_SIZE));
-	int subY = (int)std::floor(pos.y / (float)CHUNK_SIZE);
-	_flowersBySub[cpos][subY].push_back(inst);
-}
-
-void StoneEngine::removeFlowerAtCell(const glm::ivec3 &cell)
-{
-	glm::ivec2 cpos(
-		(int)std::floor(cell.x / (float)CHUNK_SIZE),
-		(int)std::floor(cell.z / (float)CHUNK_SIZE));
-	int subY = (int)std::floor(cell.y / (float)CHUNK_SIZE);
-	auto itC = _flowersBySub.find(cpos);
-	if (itC == _flowersBySub.end())
-		return;
-	auto itS = itC->second.find(subY);
-	if (itS == itC->second.end())
-		return;
-	glm::vec3 center(cell.x + 0.5f, cell.y + 0.0f, cell.z + 0.5f);
-	auto &vec = itS->second;
-	vec.erase(std::remove_if(vec.begin(), vec.end(), [&](const FlowerInstance &f)
-							 { return (fabs(f.pos.x - center.x) < 0.51f && fabs(f.pos.z - center.z) < 0.51f && fabs(f.pos.y - center.y) < 0.51f); }),
-			  vec.end());
-}
-
 void StoneEngine::blitColor(FBODatas &src, FBODatas &dst)
 {
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, src.fbo);
@@ -1740,6 +1918,7 @@ void StoneEngine::display()
 	prepareRenderPipeline();
 
 	renderSkybox();		  // -> msaaFBO
+	renderFarTerrain();	  // -> msaaFBO (heightfield past the voxel radius)
 	renderSolidObjects(); // -> msaaFBO
 
 	// Cutout flowers pass (after opaque, before water/transparents)
@@ -1829,6 +2008,8 @@ void StoneEngine::renderLoadingScreen()
 	_loadingBox.initData(_window, windowWidth / 2 - 90, windowHeight / 2 - 18, windowWidth, windowHeight);
 	_loadingBox.render();
 	glfwSwapBuffers(_window);
+	if (_firstFrameMs < 0.0)
+		_firstFrameMs = msSince(_startupBegin);
 }
 
 void StoneEngine::postProcessSkyboxComposite()
@@ -2217,7 +2398,7 @@ void StoneEngine::renderPlanarReflection()
 	glEnable(GL_DEPTH_TEST);
 	glDepthMask(GL_TRUE);
 	glDisable(GL_CULL_FACE);
-	_chunkMgr.renderTransparentBlocks();
+	_chunkMgr.renderTransparentBlocks(TRANSP_VIEW_MIRROR);
 	_chunkMgr.setViewProj(prevView, projectionMatrix);
 
 	// 2) Add the sun sprite to the planar reflection so it can reflect in water
@@ -2271,6 +2452,33 @@ void StoneEngine::prepareRenderPipeline()
 	glDepthMask(GL_TRUE);
 	glMatrixMode(GL_MODELVIEW);
 }
+
+void StoneEngine::renderFarTerrain()
+{
+	if (!FAR_TERRAIN || showTriangleMesh)
+		return;
+
+	vec3 camWorld = camera.getWorldPosition();
+	_farTerrain.update(camWorld);
+
+	float radY = camera.getAngles().y * (M_PI / 180.0f);
+	float radX = camera.getAngles().x * (M_PI / 180.0f);
+	glm::mat4 viewRot(1.0f);
+	viewRot = glm::rotate(viewRot, radY, glm::vec3(-1.0f, 0.0f, 0.0f));
+	viewRot = glm::rotate(viewRot, radX, glm::vec3(0.0f, -1.0f, 0.0f));
+
+	// Voxels own the loaded square (minus one chunk so the seam overlaps)
+	int render = RENDER_DISTANCE;
+	if (auto current = _chunkMgr.getCurrentRenderPtr(); current && *current > 0)
+		render = *current;
+	float innerRadius = std::max(0.0f, (render / 2) * (float)CHUNK_SIZE - (float)CHUNK_SIZE);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, msaaFBO.fbo);
+	_farTerrain.render(viewRot, projectionMatrix, camWorld, computeSunDirection(timeValue),
+					   showLight ? (int)timeValue : 52000, innerRadius);
+	glCleanupTextureState();
+}
+
 void StoneEngine::renderSolidObjects()
 {
 	activateRenderShader();
@@ -2501,6 +2709,7 @@ void StoneEngine::renderOverlayAndUI()
 	glUseProgram(0);
 
 	// Refresh UI-visible counters from worker-thread atomics
+	_chunkMgr.sampleVisibleHoles();
 	_chunkMgr.snapshotDebugCounters();
 
 	glDisable(GL_CULL_FACE);
@@ -2534,6 +2743,12 @@ void StoneEngine::finalizeFrame()
 	glDisable(GL_BLEND);
 	calculateFps();
 	glfwSwapBuffers(_window);
+	if (!_startupReported)
+	{
+		if (_firstFrameMs < 0.0)
+			_firstFrameMs = msSince(_startupBegin);
+		reportStartup();
+	}
 }
 
 void StoneEngine::loadFirstChunks()
@@ -2726,6 +2941,8 @@ void StoneEngine::update()
 		_occlDisableFrames = std::max(_occlDisableFrames, 2);
 	_player.updatePlayerDirection();
 	_player.updateMovement();
+	// Feeds the chunk prefetcher's path prediction
+	camera.updateVelocity(std::chrono::duration<float>(delta).count());
 	updateBiomeData();
 	display();
 }
@@ -2769,37 +2986,13 @@ void StoneEngine::mouseButtonAction(int button, int action, int mods)
 		glm::vec3 origin = camera.getWorldPosition();
 		glm::vec3 dir = camera.getDirection();
 
-		// Pre-fetch the block about to be deleted
-		glm::ivec3 peek;
-		BlockType toDelete = _chunkMgr.raycastHitFetch(origin, dir, 5.0f, peek);
-		// If deleting dirt/grass/sand, prefetch above cell type for flower instance cleanup
-		glm::ivec3 abovePeek = {peek.x, peek.y + 1, peek.z};
-		BlockType aboveBefore = AIR;
-		if (toDelete == DIRT || toDelete == GRASS || toDelete == SAND)
-		{
-			glm::ivec2 aboveChunkPos(
-				(int)std::floor((float)abovePeek.x / (float)CHUNK_SIZE),
-				(int)std::floor((float)abovePeek.z / (float)CHUNK_SIZE));
-			aboveBefore = _chunkMgr.getBlock(aboveChunkPos, abovePeek);
-		}
-		// Delete the first solid block within 5 blocks of reach
+		// Delete the first solid block within 5 blocks of reach.
+		// Flower instances follow the remesh of the edited subchunk.
 		bool deleted = _chunkMgr.raycastDeleteOne(origin, dir, 5.0f);
 		if (deleted)
 		{
 			// Disable occlusion briefly to prevent one-frame pop after edit
 			_occlDisableFrames = std::max(_occlDisableFrames, 2);
-			if (toDelete == FLOWER_POPPY || toDelete == FLOWER_DANDELION || toDelete == FLOWER_CYAN || toDelete == FLOWER_SHORT_GRASS || toDelete == FLOWER_DEAD_BUSH)
-			{
-				removeFlowerAtCell(peek);
-			}
-			// If the broken block is dirt/grass/sand and there was a flower above, remove its instance as well
-			if ((toDelete == DIRT || toDelete == GRASS || toDelete == SAND) &&
-				(aboveBefore == FLOWER_POPPY || aboveBefore == FLOWER_DANDELION ||
-				 aboveBefore == FLOWER_CYAN  || aboveBefore == FLOWER_SHORT_GRASS ||
-				 aboveBefore == FLOWER_DEAD_BUSH))
-			{
-				removeFlowerAtCell(abovePeek);
-			}
 		}
 	}
 	else if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS && _player.getSelectedBlock() != AIR)
@@ -2814,34 +3007,6 @@ void StoneEngine::mouseButtonAction(int button, int action, int mods)
 		if (placed)
 		{
 			_occlDisableFrames = std::max(_occlDisableFrames, 2);
-			// If a non-flower block was placed, ensure any existing flower instance at that cell is removed
-			if (!(selectedBlock == FLOWER_POPPY || selectedBlock == FLOWER_DANDELION ||
-				  selectedBlock == FLOWER_CYAN  || selectedBlock == FLOWER_SHORT_GRASS))
-			{
-				removeFlowerAtCell(placedAt);
-			}
-			// If placing a flower, spawn a render instance too
-			int typeId = -1;
-			if (selectedBlock == FLOWER_POPPY)
-				typeId = (_layerPoppy >= 0) ? _layerPoppy : 0;
-			else if (selectedBlock == FLOWER_DANDELION)
-				typeId = (_layerDandelion >= 0) ? _layerDandelion : 0;
-			else if (selectedBlock == FLOWER_CYAN)
-				typeId = (_layerCyan >= 0) ? _layerCyan : 0;
-			else if (selectedBlock == FLOWER_SHORT_GRASS)
-				typeId = (flowerShortGrassLayer >= 0) ? flowerShortGrassLayer : 0;
-			else if (selectedBlock == FLOWER_DEAD_BUSH)
-				typeId = (_layerDeadBush >= 0) ? _layerDeadBush : 0;
-			if (typeId >= 0)
-			{
-				static std::mt19937 rng{std::random_device{}()};
-				std::uniform_real_distribution<float> rotD(-0.26f, 0.26f);
-				std::uniform_real_distribution<float> scaD(0.95f, 1.05f);
-				glm::vec3 center = glm::vec3(placedAt.x + 0.5f, placedAt.y + 0.0f, placedAt.z + 0.5f);
-				if (selectedBlock == FLOWER_POPPY)
-					center.y -= 0.05f;
-				addFlower(center, typeId, rotD(rng), scaD(rng), 1.0f);
-			}
 		}
 		_player.setPlacing(true);
 
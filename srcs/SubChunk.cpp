@@ -1,4 +1,34 @@
 #include "SubChunk.hpp"
+#include "RegionFile.hpp"
+
+namespace
+{
+	// Voxels are stored x, then z, then y. The cold copy walks y-columns:
+	// a column is a handful of runs (stone, dirt, grass, air)
+	void toColumns(const uint8_t *blocks, int n, uint8_t *out)
+	{
+		const size_t plane = static_cast<size_t>(n) * static_cast<size_t>(n);
+		for (int z = 0; z < n; ++z)
+			for (int x = 0; x < n; ++x)
+			{
+				const uint8_t *src = blocks + static_cast<size_t>(x) + static_cast<size_t>(z) * n;
+				for (int y = 0; y < n; ++y)
+					*out++ = src[y * plane];
+			}
+	}
+
+	void fromColumns(const uint8_t *columns, int n, uint8_t *blocks)
+	{
+		const size_t plane = static_cast<size_t>(n) * static_cast<size_t>(n);
+		for (int z = 0; z < n; ++z)
+			for (int x = 0; x < n; ++x)
+			{
+				uint8_t *dst = blocks + static_cast<size_t>(x) + static_cast<size_t>(z) * n;
+				for (int y = 0; y < n; ++y)
+					dst[y * plane] = *columns++;
+			}
+	}
+}
 
 SubChunk::SubChunk(ivec3 position,
 	PerlinMap *perlinMap,
@@ -23,6 +53,7 @@ SubChunk::SubChunk(ivec3 position,
 	_blocks = std::make_unique<uint8_t[]>(size);
 	std::fill_n(_blocks.get(), size, 0);
 	_memorySize = sizeof(*this) + size;
+	_chunkLoader.getMemoryGovernor().add(MEM_VOXELS, _memorySize);
 	_isFullyLoaded = false;
 }
 
@@ -30,6 +61,97 @@ size_t SubChunk::getMemorySize() {
 	return _memorySize;
 }
 
+size_t SubChunk::freezeBlocks()
+{
+	std::lock_guard<std::mutex> lk(_dataMutex);
+	if (!_isFullyLoaded || _chunkSize <= 0 || !_blocks)
+		return 0;
+	const size_t size = static_cast<size_t>(_chunkSize) * _chunkSize * _chunkSize;
+	std::vector<uint8_t> columns(size);
+	toColumns(_blocks.get(), _chunkSize, columns.data());
+	std::vector<uint8_t> packed;
+	RegionStore::encode(columns.data(), size, packed);
+	// Noisy content (caves, leaves) may not shrink: keep it hot
+	if (packed.size() >= size / 2)
+		return 0;
+	packed.shrink_to_fit();
+	_frozenBlocks.swap(packed);
+	_blocks.reset();
+	const size_t frozenSize = sizeof(*this) + _frozenBlocks.capacity();
+	const size_t saved = _memorySize - frozenSize;
+	_chunkLoader.getMemoryGovernor().adjust(MEM_VOXELS, _memorySize, frozenSize);
+	_memorySize = frozenSize;
+	return saved;
+}
+
+void SubChunk::thawBlocks()
+{
+	std::lock_guard<std::mutex> lk(_dataMutex);
+	thawLocked();
+}
+
+bool SubChunk::isFrozen()
+{
+	std::lock_guard<std::mutex> lk(_dataMutex);
+	return !_blocks && !_frozenBlocks.empty();
+}
+
+bool SubChunk::inflateLocked(uint8_t *out)
+{
+	const size_t size = static_cast<size_t>(_chunkSize) * _chunkSize * _chunkSize;
+	std::vector<uint8_t> columns(size);
+	if (!RegionStore::decode(_frozenBlocks.data(), _frozenBlocks.size(), columns.data(), size))
+	{
+		std::cerr << "SubChunk: cannot inflate cold voxels at " << _position.x << " " << _position.y
+			<< " " << _position.z << std::endl;
+		return false;
+	}
+	fromColumns(columns.data(), _chunkSize, out);
+	return true;
+}
+
+void SubChunk::thawLocked()
+{
+	if (_blocks || _frozenBlocks.empty())
+		return;
+	const size_t size = static_cast<size_t>(_chunkSize) * _chunkSize * _chunkSize;
+	std::unique_ptr<uint8_t[]> blocks(new uint8_t[size]);
+	// Corrupt cold copy: keep it and leave _blocks null, the access fails
+	if (!inflateLocked(blocks.get()))
+		return;
+	_blocks.swap(blocks);
+	std::vector<uint8_t>().swap(_frozenBlocks);
+	_chunkLoader.getMemoryGovernor().adjust(MEM_VOXELS, _memorySize, sizeof(*this) + size);
+	_memorySize = sizeof(*this) + size;
+}
+
+const uint8_t *SubChunk::readableLocked(std::vector<uint8_t> &scratch)
+{
+	if (_blocks || _frozenBlocks.empty())
+		return _blocks.get();
+	scratch.resize(static_cast<size_t>(_chunkSize) * _chunkSize * _chunkSize);
+	return inflateLocked(scratch.data()) ? scratch.data() : nullptr;
+}
+
+size_t SubChunk::getMeshMemorySize() {
+	size_t bytes = (_vertexData.capacity() + _transparentVertexData.capacity()) * sizeof(int);
+	for (int i = 0; i < 6; i++)
+		bytes += (_faces[i].capacity() + _transparentFaces[i].capacity()) * sizeof(Face);
+	return bytes;
+}
+
+void SubChunk::releaseMeshData() {
+	// Swap with empties: clear() keeps the capacity around
+	for (int i = 0; i < 6; i++)
+	{
+		std::vector<Face>().swap(_faces[i]);
+		std::vector<Face>().swap(_transparentFaces[i]);
+	}
+	std::vector<int>().swap(_vertexData);
+	std::vector<int>().swap(_transparentVertexData);
+	_hasSentFaces = false;
+}
+
 void SubChunk::loadHeight(int prevResolution)
 {
 	(void)prevResolution;
@@ -195,11 +317,11 @@ void SubChunk::loadPlaine(int x, int z, size_t ground)
 	double f  = 0.0;
 	double rC = 0.33, yC = 0.33, bC = 0.34;
 
-	if (_grassMap && *_grassMap)           g  = (*_grassMap)[idx];
-	if (_flowerMask && *_flowerMask)       f  = (*_flowerMask)[idx];
-	if (_flowerR && *_flowerR)             rC = (*_flowerR)[idx];
-	if (_flowerY && *_flowerY)             yC = (*_flowerY)[idx];
-	if (_flowerB && *_flowerB)             bC = (*_flowerB)[idx];
+	if (_grassMap && *_grassMap)           g  = PerlinMap::fromUnorm8((*_grassMap)[idx]);
+	if (_flowerMask && *_flowerMask)       f  = PerlinMap::fromUnorm8((*_flowerMask)[idx]);
+	if (_flowerR && *_flowerR)             rC = PerlinMap::fromUnorm8((*_flowerR)[idx]);
+	if (_flowerY && *_flowerY)             yC = PerlinMap::fromUnorm8((*_flowerY)[idx]);
+	if (_flowerB && *_flowerB)             bC = PerlinMap::fromUnorm8((*_flowerB)[idx]);
 
 	// --- deterministic RNG draws ---
 	double j0 = rand01(WX, WZ, 1); // grass gate
@@ -269,7 +391,7 @@ void SubChunk::loadPlainsRare(int x, int z, size_t ground)
 	const int WZ = z + _position.z * CHUNK_SIZE;
 	int idx = z * CHUNK_SIZE + x;
 	double g  = 0.5;
-	if (_grassMap && *_grassMap) g = (*_grassMap)[idx];
+	if (_grassMap && *_grassMap) g = PerlinMap::fromUnorm8((*_grassMap)[idx]);
 
 	// Only rare short grass, modulated very slightly by g
 	double j0 = rand01(WX, WZ, 11);
@@ -320,11 +442,11 @@ void SubChunk::loadPlainsPatches(int x, int z, size_t ground)
 	double g  = 0.5; // grass noise (fine scale)
 	double f  = 0.0; // low-frequency flower/patch mask
 	double rC = 0.33, yC = 0.33, bC = 0.34; // flower color weights
-	if (_grassMap && *_grassMap)     g  = (*_grassMap)[idx];
-	if (_flowerMask && *_flowerMask) f  = (*_flowerMask)[idx];
-	if (_flowerR && *_flowerR)       rC = (*_flowerR)[idx];
-	if (_flowerY && *_flowerY)       yC = (*_flowerY)[idx];
-	if (_flowerB && *_flowerB)       bC = (*_flowerB)[idx];
+	if (_grassMap && *_grassMap)     g  = PerlinMap::fromUnorm8((*_grassMap)[idx]);
+	if (_flowerMask && *_flowerMask) f  = PerlinMap::fromUnorm8((*_flowerMask)[idx]);
+	if (_flowerR && *_flowerR)       rC = PerlinMap::fromUnorm8((*_flowerR)[idx]);
+	if (_flowerY && *_flowerY)       yC = PerlinMap::fromUnorm8((*_flowerY)[idx]);
+	if (_flowerB && *_flowerB)       bC = PerlinMap::fromUnorm8((*_flowerB)[idx]);
 
 	// Only place if above is empty
 	if (getBlock({x, y + 1, z}) != AIR)
@@ -511,7 +633,8 @@ void SubChunk::loadForest(int x, int z, size_t ground)
 
 	if (getBlock({x, yLocal, z}) != GRASS) return;
 
-	const double treeP = (*_treeMap)[z * CHUNK_SIZE + x];
+	if (!_treeMap || !*_treeMap) return;
+	const double treeP = PerlinMap::fromUnorm16((*_treeMap)[z * CHUNK_SIZE + x]);
 	if (treeP <= 0.64) return; // base density gate
 
 	// Softer spacing: enforce a small local-maximum radius with tolerance
@@ -520,7 +643,7 @@ void SubChunk::loadForest(int x, int z, size_t ground)
 	{
 		const int radius = 2;
 		const double tol = 0.02; // allow near-equal neighbors
-		const double* tmap = *_treeMap;
+		const uint16_t* tmap = *_treeMap;
 		for (int dz = -radius; dz <= radius; ++dz) {
 			int nz = z + dz;
 			if (nz < 0 || nz >= CHUNK_SIZE) continue;
@@ -528,7 +651,7 @@ void SubChunk::loadForest(int x, int z, size_t ground)
 				int nx = x + dx;
 				if (nx < 0 || nx >= CHUNK_SIZE) continue;
 				if (dx == 0 && dz == 0) continue;
-				if (tmap[nz * CHUNK_SIZE + nx] > treeP + tol)
+				if (PerlinMap::fromUnorm16(tmap[nz * CHUNK_SIZE + nx]) > treeP + tol)
 					return; // a clearly stronger neighbor nearby -> skip here
 			}
 		}
@@ -551,12 +674,13 @@ void SubChunk::loadTree(int x, int z)
 	// only plant on grass
 	if (getBlock({x, yLocal, z}) != GRASS) return ;
 
-	const double treeP = (*_treeMap)[z * CHUNK_SIZE + x];
+	if (!_treeMap || !*_treeMap) return ;
+	const double treeP = PerlinMap::fromUnorm16((*_treeMap)[z * CHUNK_SIZE + x]);
 	if (treeP <= 0.85) return ;
 
 	// Poisson-like spacing: only plant if local maximum within radius
 	const int radius = 4;
-	const double* tmap = *_treeMap;
+	const uint16_t* tmap = *_treeMap;
 	for (int dz = -radius; dz <= radius; ++dz) {
 		int nz = z + dz;
 		if (nz < 0 || nz >= CHUNK_SIZE) continue;
@@ -564,7 +688,7 @@ void SubChunk::loadTree(int x, int z)
 			int nx = x + dx;
 			if (nx < 0 || nx >= CHUNK_SIZE) continue;
 			if (dx == 0 && dz == 0) continue;
-			if (tmap[nz * CHUNK_SIZE + nx] > treeP) return; // not a local maximum
+			if (PerlinMap::fromUnorm16(tmap[nz * CHUNK_SIZE + nx]) > treeP) return; // not a local maximum
 		}
 	}
 
@@ -572,6 +696,23 @@ void SubChunk::loadTree(int x, int z)
 	plantTree(x, yLocal + 1, z, treeP);
 }
 
+void SubChunk::loadStored(const uint8_t *blocks)
+{
+	std::lock_guard<std::mutex> lk(_dataMutex);
+	thawLocked();
+	if (_resolution != 1 || !_blocks)
+		return;
+	const size_t size = static_cast<size_t>(_chunkSize) * _chunkSize * _chunkSize;
+	_occupiedCount = 0;
+	for (size_t i = 0; i < size; ++i)
+	{
+		_blocks[i] = blocks[i];
+		_occupiedCount += isOccupied(blocks[i]);
+	}
+	++_blocksVersion;
+	_isFullyLoaded = true;
+}
+
 void SubChunk::markLoaded(bool loaded) {
 	_isFullyLoaded = loaded;
 }
@@ -584,7 +725,7 @@ void SubChunk::loadBiome(int prevResolution)
 	{
 		for (int z = 0; z < CHUNK_SIZE ; z += _resolution)
 		{
-			Biome biome = (*_biomeMap)[z * CHUNK_SIZE + x];
+			Biome biome = (Biome)(*_biomeMap)[z * CHUNK_SIZE + x];
 			double surfaceLevel = (*_heightMap)[z * CHUNK_SIZE + x];
 			surfaceLevel = surfaceLevel - (int(surfaceLevel) % _resolution);
 			int adjustOceanHeight = OCEAN_HEIGHT - (OCEAN_HEIGHT % _resolution);
@@ -678,6 +819,7 @@ void SubChunk::loadBiome(int prevResolution)
 SubChunk::~SubChunk()
 {
 	_loaded = false;
+	_chunkLoader.getMemoryGovernor().sub(MEM_VOXELS, _memorySize);
 }
 
 void SubChunk::setBlock(int x, int y, int z, char block)
@@ -709,6 +851,7 @@ void SubChunk::setBlock(int x, int y, int z, char block)
 		// Write guarded to avoid races with LOD changes
 		{
 			std::lock_guard<std::mutex> lk(_dataMutex);
+			thawLocked();
 			if (_chunkSize <= 0 || !_blocks)
 				return;
 
@@ -729,6 +872,7 @@ void SubChunk::setBlock(int x, int y, int z, char block)
 				const size_t idx = static_cast<size_t>(lx)
 					+ static_cast<size_t>(lz) * static_cast<size_t>(_chunkSize)
 					+ static_cast<size_t>(ly) * plane;
+				trackWrite(_blocks[idx], (uint8_t)block);
 				_blocks[idx] = block;
 			}
 		}
@@ -745,6 +889,7 @@ void SubChunk::setBlockLocal(int x, int y, int z, char block)
 	// Direct write for pre-localized coordinates. Used by ChunkLoader to
 	// avoid re-dispatching and recursion when the target subchunk is known.
 	std::lock_guard<std::mutex> lk(_dataMutex);
+	thawLocked();
 	if (_chunkSize <= 0 || !_blocks)
 		return;
 
@@ -758,16 +903,67 @@ void SubChunk::setBlockLocal(int x, int y, int z, char block)
 	const size_t idx = static_cast<size_t>(lx)
 		+ static_cast<size_t>(lz) * static_cast<size_t>(_chunkSize)
 		+ static_cast<size_t>(ly) * plane;
+	trackWrite(_blocks[idx], (uint8_t)block);
 	_blocks[idx] = block;
 }
 
+void SubChunk::setBlocksLocal(const uint32_t *cells, size_t count)
+{
+	std::lock_guard<std::mutex> lk(_dataMutex);
+	thawLocked();
+	if (_chunkSize <= 0 || !_blocks)
+		return;
+
+	const size_t plane = static_cast<size_t>(_chunkSize) * static_cast<size_t>(_chunkSize);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const uint32_t c = cells[i];
+		const int lx = (int)(c & 31u) / _resolution;
+		const int ly = (int)((c >> 5) & 31u) / _resolution;
+		const int lz = (int)((c >> 10) & 31u) / _resolution;
+		const size_t idx = static_cast<size_t>(lx)
+			+ static_cast<size_t>(lz) * static_cast<size_t>(_chunkSize)
+			+ static_cast<size_t>(ly) * plane;
+		trackWrite(_blocks[idx], (uint8_t)(c >> 15));
+		_blocks[idx] = (uint8_t)(c >> 15);
+	}
+}
+
+size_t SubChunk::editRegion(const ivec3 &lmin, const ivec3 &lmax, const std::function<char(const ivec3 &, char)> &fn)
+{
+	std::lock_guard<std::mutex> lk(_dataMutex);
+	thawLocked();
+	if (_chunkSize <= 0 || !_blocks || _resolution != 1)
+		return 0;
+
+	const size_t plane = static_cast<size_t>(_chunkSize) * static_cast<size_t>(_chunkSize);
+	size_t changed = 0;
+	for (int y = lmin.y; y <= lmax.y; ++y)
+	for (int z = lmin.z; z <= lmax.z; ++z)
+	for (int x = lmin.x; x <= lmax.x; ++x)
+	{
+		const size_t idx = static_cast<size_t>(x)
+			+ static_cast<size_t>(z) * static_cast<size_t>(_chunkSize)
+			+ static_cast<size_t>(y) * plane;
+		const char current = (char)_blocks[idx];
+		const char next = fn(ivec3(x, y, z), current);
+		if (next != current)
+		{
+			trackWrite(_blocks[idx], (uint8_t)next);
+			_blocks[idx] = (uint8_t)next;
+			++changed;
+		}
+	}
+	return changed;
+}
+
 
 char SubChunk::getBlock(ivec3 position)
 {
 	// Guard concurrent mutations of _blocks / _chunkSize
 	std::lock_guard<std::mutex> lk(_dataMutex);
 
-	if (_chunkSize <= 0 || !_blocks)
+	if (_chunkSize <= 0 || (!_blocks && _frozenBlocks.empty()))
 		return AIR;
 
 	int x = position.x;
@@ -788,6 +984,15 @@ char SubChunk::getBlock(ivec3 position)
 	const size_t maxSize = plane * static_cast<size_t>(_chunkSize);
 	if (idx >= maxSize)
 		return AIR;
+	if (!_blocks)
+	{
+		// Cold: read the cell from its column run, the array stays packed
+		const size_t column = (static_cast<size_t>(z) * static_cast<size_t>(_chunkSize) + static_cast<size_t>(x))
+			* static_cast<size_t>(_chunkSize) + static_cast<size_t>(y);
+		uint8_t block = AIR;
+		RegionStore::decodeAt(_frozenBlocks.data(), _frozenBlocks.size(), column, block);
+		return block;
+	}
 	return _blocks[idx];
 }
 
@@ -897,6 +1102,22 @@ void SubChunk::addEastFace(BlockType current, ivec3 position, TextureType textur
 	addFace(position, EAST, texture, isTransparent);
 }
 
+uint8_t SubChunk::faceSkyLight(const ivec3 &position, Direction dir)
+{
+	static const ivec3 step[6] = {
+		ivec3(0, 0, -1), ivec3(0, 0, 1), ivec3(-1, 0, 0), ivec3(1, 0, 0), ivec3(0, -1, 0), ivec3(0, 1, 0)};
+	ivec3 p = position + step[dir] * _resolution;
+	Chunk *chunk = &_chunk;
+	if (p.z < 0)					{ chunk = _chunk.getNorthChunk(); p.z += CHUNK_SIZE; }
+	else if (p.z >= CHUNK_SIZE)	{ chunk = _chunk.getSouthChunk(); p.z -= CHUNK_SIZE; }
+	else if (p.x < 0)				{ chunk = _chunk.getWestChunk(); p.x += CHUNK_SIZE; }
+	else if (p.x >= CHUNK_SIZE)	{ chunk = _chunk.getEastChunk(); p.x -= CHUNK_SIZE; }
+	// Missing neighbors are open sky, as for face culling
+	if (!chunk)
+		return SKYLIGHT_MAX;
+	return chunk->getSkyLight(p.x, _position.y * CHUNK_SIZE + p.y, p.z);
+}
+
 void SubChunk::addBlock(BlockType block, ivec3 position, TextureType down, TextureType up, TextureType north, TextureType south, TextureType east, TextureType west, bool isTransparent = false)
 {
 	addUpFace(block, position, up, isTransparent);
@@ -947,6 +1168,11 @@ void SubChunk::updateResolution(int resolution, PerlinMap *perlinMap)
 	_heightMap = &perlinMap->heightMap;
 	_biomeMap  = &perlinMap->biomeMap;
 	_treeMap   = &perlinMap->treeMap;
+	_grassMap   = &perlinMap->grassMap;
+	_flowerMask = &perlinMap->flowerMask;
+	_flowerR    = &perlinMap->flowerR;
+	_flowerY    = &perlinMap->flowerY;
+	_flowerB    = &perlinMap->flowerB;
 
 	// Prepare fresh storage for new LOD, then atomically publish shape + buffer
 	int newChunkSize = CHUNK_SIZE / std::max(1, resolution);
@@ -957,6 +1183,10 @@ void SubChunk::updateResolution(int resolution, PerlinMap *perlinMap)
 		_resolution = std::max(1, resolution);
 		_chunkSize = newChunkSize;
 		_blocks.swap(fresh);
+		std::vector<uint8_t>().swap(_frozenBlocks);
+		_occupiedCount = 0;
+		++_blocksVersion;
+		_chunkLoader.getMemoryGovernor().adjust(MEM_VOXELS, _memorySize, sizeof(*this) + newSize);
 		_memorySize = sizeof(*this) + newSize;
 	}
 
@@ -970,15 +1200,20 @@ void SubChunk::sendFacesToDisplay()
 {
 	if (!_isFullyLoaded)
 		return ;
+	// Meshing reads every cell and its neighbours: inflate once instead of
+	// walking the packed runs per cell (a meshed subchunk is about to be drawn)
+	thawBlocks();
 	clearFaces();
 
+	std::vector<uint32_t> plants;
 	for (int x = 0; x < CHUNK_SIZE; x += _resolution)
 	{
 		for (int y = 0; y < CHUNK_SIZE; y += _resolution)
 		{
 			for (int z = 0; z < CHUNK_SIZE; z += _resolution)
 			{
-				switch (getBlock({x, y, z}))
+				char block = getBlock({x, y, z});
+				switch (block)
 				{
 					case 0:
 						break;
@@ -1023,16 +1258,41 @@ void SubChunk::sendFacesToDisplay()
 						// addWestFace( LEAF, ivec3(x, y, z), T_LEAF, true);
 						// addEastFace( LEAF, ivec3(x, y, z), T_LEAF, true);
 						// break;
+					case FLOWER_POPPY:
+					case FLOWER_DANDELION:
+					case FLOWER_CYAN:
+					case FLOWER_SHORT_GRASS:
+					case FLOWER_DEAD_BUSH:
+						// Plants are instanced by the renderer, only at full resolution
+						if (_resolution == 1)
+							plants.push_back(packPlant(x, y, z, block));
+						break;
 					default :
 						break;
 				}
 			}
 		}
 	}
+	{
+		std::lock_guard<std::mutex> lk(_dataMutex);
+		_plants.swap(plants);
+	}
 	processFaces(false);
 	processFaces(true);
 }
 
+std::vector<uint32_t> SubChunk::getPlants()
+{
+	std::lock_guard<std::mutex> lk(_dataMutex);
+	return _plants;
+}
+
+uint32_t SubChunk::getBlocksVersion()
+{
+	std::lock_guard<std::mutex> lk(_dataMutex);
+	return _blocksVersion;
+}
+
 void SubChunk::addTextureVertex(Face face, std::vector<int> *vertexData)
 {
 	int x = face.position.x;
@@ -1058,10 +1318,13 @@ void SubChunk::addTextureVertex(Face face, std::vector<int> *vertexData)
 	// Repacked (direction moved to per-draw metadata)
 	// bits 15..19: lengthX (5)
 	// bits 20..24: lengthY (5)
-	// bits 25..31: textureID (7)
+	// bits 25..28: textureID (4)
+	// bits 29..31: skylight (level / 2)
+	static_assert(N_TEXTURES <= 16, "texture IDs are packed on 4 bits");
 	newVertex |= (lengthX & 0x1F) << 15;
 	newVertex |= (lengthY & 0x1F) << 20;
-	newVertex |= (textureID & 0x7F) << 25;
+	newVertex |= (textureID & 0xF) << 25;
+	newVertex |= (int)((uint32_t)((face.light >> 1) & 0x7) << 29);
 	vertexData->push_back(newVertex);
 }
 
@@ -1123,30 +1386,116 @@ std::vector<int> &SubChunk::getTransparentVertices()
 	return _transparentVertexData;
 }
 
-# define IS_TRANSPARENT true
-# define IS_SOLID false
+// Representative viewer per class: faceDisplayCondition only tells opaque
+// blocks, water, leaves and logs/cactus apart on lateral faces
+static const char kBorderViewers[] = { STONE, WATER, LEAF, LOG };
+static const int kBorderClasses = sizeof(kBorderViewers) / sizeof(kBorderViewers[0]);
+
+static inline int borderViewerClass(char block)
+{
+	if (block == WATER) return 1;
+	if (block == LEAF) return 2;
+	if (block == LOG || block == CACTUS) return 3;
+	return 0;
+}
+
+static inline Direction oppositeSide(Direction dir)
+{
+	switch (dir) {
+		case NORTH: return SOUTH;
+		case SOUTH: return NORTH;
+		case WEST:	return EAST;
+		case EAST:	return WEST;
+		case DOWN:	return UP;
+		case UP:	return DOWN;
+	}
+	return dir;
+}
+
+// Halve a row of `width` bits, OR-ing each pair
+static inline uint32_t foldBits(uint32_t bits, int width)
+{
+	uint32_t out = 0;
+	for (int i = 0; i < width / 2; ++i)
+		if ((bits >> (2 * i)) & 3u)
+			out |= 1u << i;
+	return out;
+}
+
+void SubChunk::buildBorderPlanes(Direction side, const uint8_t *blocks)
+{
+	// Caller holds _dataMutex
+	BorderPlanes &bp = _borders[side];
+	const int n = _chunkSize;
+	const size_t perClass = 2 * static_cast<size_t>(n);
+	const size_t plane = static_cast<size_t>(n) * static_cast<size_t>(n);
+	const bool alongX = (side == NORTH || side == SOUTH);
+	const int layer = (side == NORTH || side == WEST) ? 0 : n - 1;
+	const Direction facing = oppositeSide(side);
+
+	bp.rows.assign(perClass * kBorderClasses, 0);
+	for (int v = 0; v < n; ++v)
+		for (int u = 0; u < n; ++u)
+		{
+			const int x = alongX ? u : layer;
+			const int z = alongX ? layer : u;
+			const char block = (char)blocks[static_cast<size_t>(x) + static_cast<size_t>(z) * static_cast<size_t>(n) + static_cast<size_t>(v) * plane];
+			for (int c = 0; c < kBorderClasses; ++c)
+				if (faceDisplayCondition(kBorderViewers[c], block, facing))
+					bp.rows[c * perClass + v] |= 1u << u;
+		}
+	// Level k starts at row 2n - 2(n >> k)
+	for (int c = 0; c < kBorderClasses; ++c)
+	{
+		size_t src = c * perClass;
+		for (int m = n; m > 1; m >>= 1)
+		{
+			const size_t dst = src + m;
+			for (int r = 0; r < m / 2; ++r)
+				bp.rows[dst + r] = foldBits(bp.rows[src + 2 * r] | bp.rows[src + 2 * r + 1], m);
+			src = dst;
+		}
+	}
+	bp.version = _blocksVersion;
+	bp.built = true;
+}
+
+bool SubChunk::borderShowsFace(Direction side, int u, int v, int viewerResolution, char viewerBlock)
+{
+	std::lock_guard<std::mutex> lk(_dataMutex);
+	if (_chunkSize <= 0 || side > EAST)
+		return true;
+
+	BorderPlanes &bp = _borders[side];
+	if (!bp.built || bp.version != _blocksVersion)
+	{
+		std::vector<uint8_t> scratch;
+		const uint8_t *blocks = readableLocked(scratch);
+		if (!blocks)
+			return true;
+		buildBorderPlanes(side, blocks);
+	}
+
+	// Coarser viewer: the pyramid level whose cell matches its footprint.
+	// Finer viewer: the cell of ours that contains it.
+	int level = 0;
+	int cell = _resolution;
+	while (cell < viewerResolution && (_chunkSize >> level) > 1)
+	{
+		++level;
+		cell *= 2;
+	}
+	const size_t n = static_cast<size_t>(_chunkSize);
+	const size_t row = static_cast<size_t>(borderViewerClass(viewerBlock)) * 2 * n
+		+ (2 * n - 2 * (n >> level))
+		+ static_cast<size_t>(v / cell);
+	return (bp.rows[row] >> (u / cell)) & 1u;
+}
 
 bool SubChunk::isNeighborTransparent(ivec3 position, Direction dir, char viewerBlock, int viewerResolution) {
-	if (viewerResolution == _resolution)
+	if (viewerResolution == _resolution || dir > EAST)
 		return (faceDisplayCondition(viewerBlock, getBlock(position), dir));
-	if (viewerResolution < _resolution)
-		return (IS_SOLID);
-	position /= _resolution;
-	position *= _resolution;
-	int res2 = _resolution * 2;
-	for (int x = 0; x < res2; x += _resolution) {
-		for (int y = 0; y < res2; y += _resolution) {
-			for (int z = 0; z < res2; z += _resolution) {
-				if (faceDisplayCondition(viewerBlock, getBlock(ivec3(position.x + x, position.y + y, position.z + z)), dir))
-					return IS_TRANSPARENT;
-				if (dir == NORTH || dir == SOUTH)
-					break ;
-				}
-				if (dir == UP || dir == DOWN)
-					break ;
-			}
-		if (dir == EAST || dir == WEST)
-			break ;
-	}
-	return IS_SOLID;
+	// LOD border: only lateral faces cross chunks, read the published layer
+	const int u = (dir == NORTH || dir == SOUTH) ? position.x : position.z;
+	return borderShowsFace(oppositeSide(dir), u, position.y, viewerResolution, viewerBlock);
 }
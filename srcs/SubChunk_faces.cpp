@@ -1,8 +1,41 @@
 #include "SubChunk.hpp"
 
+bool isTransparent(char block)
+{
+	// Treat CACTUS like LOG for face-visibility decisions so ground caps render
+	// under the inset mesh (prevents a visible ring gap around the base).
+	return block == AIR || block == WATER || block == LOG || block == CACTUS || block == LEAF || block == FLOWER_POPPY || block == FLOWER_DANDELION || block == FLOWER_CYAN || block == FLOWER_SHORT_GRASS || block == FLOWER_DEAD_BUSH;
+}
+
+// Display logs only if sides
+bool faceDisplayCondition(char blockToDisplay, char neighborBlock, Direction dir)
+{
+	// For leaves: always show faces, but if neighbor is also a leaf, only
+	// emit the face for positive-axis directions to avoid z-fighting between
+	// coincident quads (keep one of the two faces).
+	if (blockToDisplay == LEAF)
+	{
+		if (neighborBlock == LEAF)
+		{
+			return (dir == EAST || dir == UP || dir == SOUTH);
+		}
+		return true; // non-leaf neighbor: show the face regardless
+	}
+
+	// Apply the same neighboring-face rule used for logs to cactuses:
+	// always render side faces even when adjacent to the same block type.
+	const bool isLogOrCactus = (blockToDisplay == LOG || blockToDisplay == CACTUS);
+	if (isLogOrCactus && dir <= EAST)
+		return true;
+
+	return (isTransparent(neighborBlock) && blockToDisplay != neighborBlock);
+}
+
 bool compareUpFaces(const SubChunk::Face& a, const SubChunk::Face& b) {
 	if (a.texture != b.texture)
 		return (a.texture > b.texture);
+	if (a.light != b.light)
+		return a.light < b.light;
 	if (a.position.y != b.position.y)
 		return a.position.y < b.position.y;
 	if (a.position.x != b.position.x)
@@ -13,6 +46,8 @@ bool compareUpFaces(const SubChunk::Face& a, const SubChunk::Face& b) {
 bool compareUpStep2Faces(const SubChunk::Face& a, const SubChunk::Face& b) {
 	if (a.texture != b.texture)
 		return (a.texture < b.texture);
+	if (a.light != b.light)
+		return a.light < b.light;
 	if (a.position.y != b.position.y)
 		return a.position.y < b.position.y;
 	if (a.position.z != b.position.z)
@@ -23,6 +58,8 @@ bool compareUpStep2Faces(const SubChunk::Face& a, const SubChunk::Face& b) {
 bool compareNorthFaces(const SubChunk::Face& a, const SubChunk::Face& b) {
 	if (a.texture != b.texture)
 		return (a.texture < b.texture);
+	if (a.light != b.light)
+		return a.light < b.light;
 	if (a.position.z != b.position.z)
 		return a.position.z < b.position.z;
 	if (a.position.y != b.position.y)
@@ -33,6 +70,8 @@ bool compareNorthFaces(const SubChunk::Face& a, const SubChunk::Face& b) {
 bool compareNorthStep2Faces(const SubChunk::Face& a, const SubChunk::Face& b) {
 	if (a.texture != b.texture)
 		return (a.texture < b.texture);
+	if (a.light != b.light)
+		return a.light < b.light;
 	if (a.position.z != b.position.z)
 		return a.position.z < b.position.z;
 	if (a.position.x != b.position.x)
@@ -43,6 +82,8 @@ bool compareNorthStep2Faces(const SubChunk::Face& a, const SubChunk::Face& b) {
 bool compareEastFaces(const SubChunk::Face& a, const SubChunk::Face& b) {
 	if (a.texture != b.texture)
 		return (a.texture < b.texture);
+	if (a.light != b.light)
+		return a.light < b.light;
 	if (a.position.x != b.position.x)
 		return a.position.x < b.position.x;
 	if (a.position.z != b.position.z)
@@ -53,6 +94,8 @@ bool compareEastFaces(const SubChunk::Face& a, const SubChunk::Face& b) {
 bool compareEastStep2Faces(const SubChunk::Face& a, const SubChunk::Face& b) {
 	if (a.texture != b.texture)
 		return (a.texture < b.texture);
+	if (a.light != b.light)
+		return a.light < b.light;
 	if (a.position.x != b.position.x)
 		return a.position.x < b.position.x;
 	if (a.position.y != b.position.y)
@@ -75,7 +118,7 @@ void SubChunk::processUpVertex(std::vector<Face> *faces, std::vector<int> *verte
 	for (Face face : faces[UP])
 	{
 		// Prevent merging of UP faces for logs and cactus (top caps never touch)
-		if (isFirst || newFace.size.y > 31 || newFace.texture != face.texture || face.position.x != newFace.position.x || face.position.y != newFace.position.y || lastFace.position.z != face.position.z - _resolution || face.texture == T_LOG_TOP || face.texture == T_CACTUS_TOP)
+		if (isFirst || newFace.size.y > 31 || newFace.texture != face.texture || newFace.light != face.light || face.position.x != newFace.position.x || face.position.y != newFace.position.y || lastFace.position.z != face.position.z - _resolution || face.texture == T_LOG_TOP || face.texture == T_CACTUS_TOP)
 		{
 			if (isFirst == false)
 				mergedFacesZ.push_back(newFace);
@@ -91,7 +134,7 @@ void SubChunk::processUpVertex(std::vector<Face> *faces, std::vector<int> *verte
 	for (Face face : mergedFacesZ)
 	{
 		// Prevent merging of UP faces for logs and cactus (top caps never touch)
-		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.position.y != newFace.position.y || face.position.z != newFace.position.z || lastFace.position.x != face.position.x - _resolution || newFace.size.y != face.size.y || face.texture == T_LOG_TOP || face.texture == T_CACTUS_TOP)
+		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.y != newFace.position.y || face.position.z != newFace.position.z || lastFace.position.x != face.position.x - _resolution || newFace.size.y != face.size.y || face.texture == T_LOG_TOP || face.texture == T_CACTUS_TOP)
 		{
 			if (!isFirst)
 				mergedFaces.push_back(newFace);
@@ -122,7 +165,7 @@ void SubChunk::processDownVertex(std::vector<Face> *faces, std::vector<int> *ver
 	for (Face face : faces[DOWN])
 	{
 		// Prevent merging of DOWN faces for logs and cactus (bottom caps never touch)
-		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.position.x != newFace.position.x || face.position.y != newFace.position.y || lastFace.position.z != face.position.z - _resolution || face.texture == T_LOG_TOP || face.texture == T_CACTUS_TOP)
+		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.x != newFace.position.x || face.position.y != newFace.position.y || lastFace.position.z != face.position.z - _resolution || face.texture == T_LOG_TOP || face.texture == T_CACTUS_TOP)
 		{
 			if (!isFirst)
 				mergedFacesZ.push_back(newFace);
@@ -139,7 +182,7 @@ void SubChunk::processDownVertex(std::vector<Face> *faces, std::vector<int> *ver
 	for (Face face : mergedFacesZ)
 	{
 		// Prevent merging of DOWN faces for logs and cactus (bottom caps never touch)
-		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.position.y != newFace.position.y || face.position.z != newFace.position.z || lastFace.position.x != face.position.x - _resolution || newFace.size.y != face.size.y || face.texture == T_LOG_TOP || face.texture == T_CACTUS_TOP)
+		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.y != newFace.position.y || face.position.z != newFace.position.z || lastFace.position.x != face.position.x - _resolution || newFace.size.y != face.size.y || face.texture == T_LOG_TOP || face.texture == T_CACTUS_TOP)
 		{
 			if (!isFirst)
 				mergedFaces.push_back(newFace);
@@ -171,7 +214,7 @@ void SubChunk::processNorthVertex(std::vector<Face> *faces, std::vector<int> *ve
 	{
 		// Disable horizontal (X-axis) merging for log/cactus side faces to avoid elongated quads
 		// when multiple blocks sit side-by-side. Vertical (Y) merging remains
-		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.position.y != newFace.position.y || face.position.z != newFace.position.z || lastFace.position.x != face.position.x - _resolution || face.texture == T_LOG_SIDE || face.texture == T_CACTUS_SIDE)
+		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.y != newFace.position.y || face.position.z != newFace.position.z || lastFace.position.x != face.position.x - _resolution || face.texture == T_LOG_SIDE || face.texture == T_CACTUS_SIDE)
 		{
 			if (!isFirst)
 				mergedFacesZ.push_back(newFace);
@@ -187,7 +230,7 @@ void SubChunk::processNorthVertex(std::vector<Face> *faces, std::vector<int> *ve
 	isFirst = true;
 	for (Face face : mergedFacesZ)
 	{
-		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.position.x != newFace.position.x || face.position.z != newFace.position.z || lastFace.position.y != face.position.y - _resolution || newFace.size.x != face.size.x)
+		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.x != newFace.position.x || face.position.z != newFace.position.z || lastFace.position.y != face.position.y - _resolution || newFace.size.x != face.size.x)
 		{
 			if (!isFirst)
 				mergedFaces.push_back(newFace);
@@ -218,7 +261,7 @@ void SubChunk::processSouthVertex(std::vector<Face> *faces, std::vector<int> *ve
 	for (Face face : faces[SOUTH])
 	{
 		// Disable horizontal (X-axis) merging for log/cactus side faces for SOUTH-facing quads
-		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.position.y != newFace.position.y || face.position.z != newFace.position.z || lastFace.position.x != face.position.x - _resolution || face.texture == T_LOG_SIDE || face.texture == T_CACTUS_SIDE)
+		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.y != newFace.position.y || face.position.z != newFace.position.z || lastFace.position.x != face.position.x - _resolution || face.texture == T_LOG_SIDE || face.texture == T_CACTUS_SIDE)
 		{
 			if (!isFirst)
 				mergedFacesZ.push_back(newFace);
@@ -234,7 +277,7 @@ void SubChunk::processSouthVertex(std::vector<Face> *faces, std::vector<int> *ve
 	isFirst = true;
 	for (Face face : mergedFacesZ)
 	{
-		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.position.x != newFace.position.x || face.position.z != newFace.position.z || lastFace.position.y != face.position.y - _resolution || newFace.size.x != face.size.x)
+		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.x != newFace.position.x || face.position.z != newFace.position.z || lastFace.position.y != face.position.y - _resolution || newFace.size.x != face.size.x)
 		{
 			if (!isFirst)
 				mergedFaces.push_back(newFace);
@@ -264,7 +307,7 @@ void SubChunk::processEastVertex(std::vector<Face> *faces, std::vector<int> *ver
 	Face newFace;
 	for (Face face : faces[EAST])
 	{
-		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.position.z != newFace.position.z || face.position.x != newFace.position.x || lastFace.position.y != face.position.y - _resolution)
+		if (isFirst || newFace.size.x > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.z != newFace.position.z || face.position.x != newFace.position.x || lastFace.position.y != face.position.y - _resolution)
 		{
 			if (!isFirst)
 				mergedFacesZ.push_back(newFace);
@@ -280,7 +323,7 @@ void SubChunk::processEastVertex(std::vector<Face> *faces, std::vector<int> *ver
 	for (Face face : mergedFacesZ)
 	{
 		// Disable horizontal (Z-axis) merging for log/cactus side faces to avoid elongated quads
-		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.position.x != newFace.position.x || face.position.y != newFace.position.y || lastFace.position.z != face.position.z - _resolution || newFace.size.x != face.size.x || face.texture == T_LOG_SIDE || face.texture == T_CACTUS_SIDE)
+		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.x != newFace.position.x || face.position.y != newFace.position.y || lastFace.position.z != face.position.z - _resolution || newFace.size.x != face.size.x || face.texture == T_LOG_SIDE || face.texture == T_CACTUS_SIDE)
 		{
 			if (!isFirst)
 				mergedFaces.push_back(newFace);
@@ -310,7 +353,7 @@ void SubChunk::processWestVertex(std::vector<Face> *faces, std::vector<int> *ver
 	Face newFace;
 	for (Face face : faces[WEST])
 	{
-		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.position.z != newFace.position.z || face.position.x != newFace.position.x || lastFace.position.y != face.position.y - _resolution)
+		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.z != newFace.position.z || face.position.x != newFace.position.x || lastFace.position.y != face.position.y - _resolution)
 		{
 			if (!isFirst)
 				mergedFacesZ.push_back(newFace);
@@ -326,7 +369,7 @@ void SubChunk::processWestVertex(std::vector<Face> *faces, std::vector<int> *ver
 	for (Face face : mergedFacesZ)
 	{
 		// Disable horizontal (Z-axis) merging for log/cactus side faces on WEST-facing quads
-		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.position.x != newFace.position.x || face.position.y != newFace.position.y || lastFace.position.z != face.position.z - _resolution || newFace.size.x != face.size.x || face.texture == T_LOG_SIDE || face.texture == T_CACTUS_SIDE)
+		if (isFirst || newFace.size.y > 31 || face.texture != newFace.texture || face.light != newFace.light || face.position.x != newFace.position.x || face.position.y != newFace.position.y || lastFace.position.z != face.position.z - _resolution || newFace.size.x != face.size.x || face.texture == T_LOG_SIDE || face.texture == T_CACTUS_SIDE)
 		{
 			if (!isFirst)
 				mergedFaces.push_back(newFace);
@@ -351,6 +394,7 @@ void SubChunk::addFace(ivec3 position, Direction dir, TextureType texture, bool
 	// newFace.size = ivec2(1, 1);
 	newFace.direction = dir;
 	newFace.texture = texture;
+	newFace.light = faceSkyLight(position, dir);
 	if (isTransparent)
 		_transparentFaces[dir].push_back(newFace);
 	else
@@ -1,5 +1,170 @@
 #include "TextureManager.hpp"
+#include "define.hpp"
 #include "stb_image.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+	// log2(TEXTURE_SIZE) + 1 levels, down to 1x1
+	int mipLevelCount()
+	{
+		int levels = 1;
+		for (int s = TEXTURE_SIZE; s > 1; s >>= 1)
+			++levels;
+		return levels;
+	}
+
+	uint64_t fnv1a(uint64_t h, const unsigned char *data, size_t size)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			h ^= data[i];
+			h *= 0x100000001b3ULL;
+		}
+		return h;
+	}
+
+	// Every file decodeTextures reads, in a fixed order
+	std::vector<std::string> sourceFiles(const std::vector<std::pair<TextureType, std::string>> &data)
+	{
+		std::vector<std::string> files;
+		for (const auto &entry : data)
+			files.push_back(entry.second);
+		files.push_back("textures/full_leaves.ppm");
+		return files;
+	}
+
+	// Content hash per source, 0 for a missing file (decoded as the fallback)
+	std::vector<uint64_t> hashSources(const std::vector<std::string> &files)
+	{
+		std::vector<uint64_t> hashes;
+		for (const std::string &file : files)
+		{
+			std::ifstream in(file, std::ios::binary);
+			std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+			hashes.push_back(in ? fnv1a(0xcbf29ce484222325ULL, bytes.data(), bytes.size()) : 0);
+		}
+		return hashes;
+	}
+
+	const char		kCacheMagic[4] = {'F', 'T', 'V', 'T'};
+	const uint32_t	kCacheVersion = 1;
+	const char		*kCacheFile = TEXTURE_CACHE_DIR "/blocks.texarray";
+
+	// Cache layout: magic, version, texture size, layers, levels, source
+	// count, one hash per source, then the mip chain as TextureArrayData
+	size_t headerBytes(size_t sources)
+	{
+		return 4 + 5 * sizeof(uint32_t) + sources * sizeof(uint64_t);
+	}
+
+	size_t chainBytes(int levels)
+	{
+		size_t total = 0;
+		for (int l = 0; l < levels; ++l)
+			total += TextureArrayData::levelBytes(l);
+		return total;
+	}
+
+	std::unique_ptr<TextureArrayData> mapCache(const std::vector<uint64_t> &hashes)
+	{
+		const int fd = open(kCacheFile, O_RDONLY);
+		if (fd < 0)
+			return nullptr;
+		struct stat st;
+		const int levels = mipLevelCount();
+		const size_t header = headerBytes(hashes.size());
+		const size_t expected = header + chainBytes(levels);
+		void *map = MAP_FAILED;
+		if (fstat(fd, &st) == 0 && (size_t)st.st_size == expected)
+			map = mmap(nullptr, expected, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (map == MAP_FAILED)
+			return nullptr;
+
+		const unsigned char *p = static_cast<const unsigned char *>(map);
+		uint32_t fields[5];
+		std::memcpy(fields, p + 4, sizeof(fields));
+		bool valid = std::memcmp(p, kCacheMagic, 4) == 0 && fields[0] == kCacheVersion
+			&& fields[1] == TEXTURE_SIZE && fields[2] == N_TEXTURES && fields[3] == (uint32_t)levels
+			&& fields[4] == hashes.size();
+		for (size_t i = 0; valid && i < hashes.size(); ++i)
+		{
+			uint64_t stored;
+			std::memcpy(&stored, p + 4 + sizeof(fields) + i * sizeof(uint64_t), sizeof(stored));
+			valid = stored == hashes[i];
+		}
+		if (!valid)
+		{
+			munmap(map, expected);
+			return nullptr;
+		}
+		return std::unique_ptr<TextureArrayData>(new TextureArrayData(map, expected, header, levels));
+	}
+
+	void writeCache(const std::vector<uint64_t> &hashes, const TextureArrayData &array)
+	{
+		mkdir(TEXTURE_CACHE_DIR, 0755);
+		// Write aside then rename, a crash never leaves a truncated cache
+		const std::string path = kCacheFile;
+		const std::string tmp = path + ".tmp";
+		{
+			std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+			const uint32_t fields[5] = {kCacheVersion, TEXTURE_SIZE, N_TEXTURES, (uint32_t)array.levels(), (uint32_t)hashes.size()};
+			file.write(kCacheMagic, 4);
+			file.write(reinterpret_cast<const char *>(fields), sizeof(fields));
+			file.write(reinterpret_cast<const char *>(hashes.data()), hashes.size() * sizeof(uint64_t));
+			for (int l = 0; l < array.levels(); ++l)
+				file.write(reinterpret_cast<const char *>(array.level(l)), TextureArrayData::levelBytes(l));
+			if (!file)
+			{
+				std::cerr << "Cannot write texture cache " << tmp << std::endl;
+				return;
+			}
+		}
+		if (std::rename(tmp.c_str(), path.c_str()) != 0)
+			std::cerr << "Cannot write texture cache " << path << std::endl;
+	}
+}
+
+TextureArrayData::TextureArrayData(std::vector<unsigned char> &&pixels, int levels)
+: _owned(std::move(pixels)), _pixels(_owned.data()), _levels(levels)
+{
+}
+
+TextureArrayData::TextureArrayData(void *mapped, size_t mappedSize, size_t pixelOffset, int levels)
+: _mapped(mapped), _mappedSize(mappedSize), _pixels(static_cast<const unsigned char *>(mapped) + pixelOffset), _levels(levels)
+{
+}
+
+TextureArrayData::~TextureArrayData()
+{
+	if (_mapped)
+		munmap(_mapped, _mappedSize);
+}
+
+bool TextureArrayData::isMapped() const { return _mapped != nullptr; }
+int TextureArrayData::levels() const { return _levels; }
+int TextureArrayData::levelSize(int level) { return std::max(1, TEXTURE_SIZE >> level); }
+
+size_t TextureArrayData::levelBytes(int level)
+{
+	const size_t s = (size_t)levelSize(level);
+	return s * s * 4 * N_TEXTURES;
+}
+
+const unsigned char *TextureArrayData::level(int level) const
+{
+	const unsigned char *p = _pixels;
+	for (int l = 0; l < level; ++l)
+		p += levelBytes(l);
+	return p;
+}
 
 // Load the PPM texture file
 unsigned char* loadTexturePPM(const std::string& filename, int& width, int& height) {
@@ -40,26 +205,51 @@ unsigned char* loadTexturePPM(const std::string& filename, int& width, int& heig
 }
 
 void TextureManager::loadTexturesArray(std::vector<std::pair<TextureType, std::string>> data) {
-	glGenTextures(1, &_textureArrayID);
-	glBindTexture(GL_TEXTURE_2D_ARRAY, _textureArrayID);
+	uploadTextureArray(*loadTextureArrayData(data));
+}
 
-	// Set texture parameters
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_LOD_BIAS, 0.0f);
+std::unique_ptr<TextureArrayData> TextureManager::loadTextureArrayData(const std::vector<std::pair<TextureType, std::string>> &data) {
+	const std::vector<uint64_t> hashes = hashSources(sourceFiles(data));
+	if (std::unique_ptr<TextureArrayData> cached = mapCache(hashes))
+		return cached;
 
-	// Set Anisotropic Filtering (only if supported)
-	GLfloat maxAniso = 0.0f;
-	glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAniso);
-	if (maxAniso > 1.0f) {
-		glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY_EXT, maxAniso);
+	// Level 0 from the sources, then 2x2 box-filtered levels (as glGenerateMipmap)
+	const int levels = mipLevelCount();
+	std::vector<unsigned char> chain(chainBytes(levels));
+	const std::vector<std::vector<unsigned char>> layers = decodeTextures(data);
+	const size_t layerBytes = (size_t)TEXTURE_SIZE * TEXTURE_SIZE * 4;
+	for (int i = 0; i < N_TEXTURES; ++i)
+		if (i < (int)layers.size() && layers[i].size() >= layerBytes)
+			std::memcpy(chain.data() + i * layerBytes, layers[i].data(), layerBytes);
+	unsigned char *src = chain.data();
+	for (int l = 1; l < levels; ++l) {
+		unsigned char *dst = src + TextureArrayData::levelBytes(l - 1);
+		const int ss = TextureArrayData::levelSize(l - 1);
+		const int ds = TextureArrayData::levelSize(l);
+		for (int i = 0; i < N_TEXTURES; ++i) {
+			const unsigned char *sl = src + (size_t)i * ss * ss * 4;
+			unsigned char *dl = dst + (size_t)i * ds * ds * 4;
+			for (int y = 0; y < ds; ++y)
+				for (int x = 0; x < ds; ++x)
+					for (int c = 0; c < 4; ++c) {
+						const int x0 = std::min(2 * x, ss - 1), x1 = std::min(2 * x + 1, ss - 1);
+						const int y0 = std::min(2 * y, ss - 1), y1 = std::min(2 * y + 1, ss - 1);
+						const int sum = sl[(y0 * ss + x0) * 4 + c] + sl[(y0 * ss + x1) * 4 + c]
+							+ sl[(y1 * ss + x0) * 4 + c] + sl[(y1 * ss + x1) * 4 + c];
+						dl[(y * ds + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+					}
+		}
+		src = dst;
 	}
 
-	// Allocate storage for the texture array
-	int width = TEXTURE_SIZE, height = TEXTURE_SIZE;
-	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, N_TEXTURES, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	std::unique_ptr<TextureArrayData> array(new TextureArrayData(std::move(chain), levels));
+	writeCache(hashes, *array);
+	return array;
+}
+
+// CPU only (no GL): safe to run on a worker while the context is created
+std::vector<std::vector<unsigned char>> TextureManager::decodeTextures(const std::vector<std::pair<TextureType, std::string>> &data) {
+	std::vector<std::vector<unsigned char>> layers(N_TEXTURES);
 
 	// Helper: load PPM or PNG/JPG via STB and ensure RGBA 16x16
 	auto loadTextureGeneric = [&](const std::string& filename)->std::unique_ptr<unsigned char[]> {
@@ -104,7 +294,7 @@ void TextureManager::loadTexturesArray(std::vector<std::pair<TextureType, std::s
 		return out;
 	};
 
-	// Load and upload textures
+	// Decode every layer to TEXTURE_SIZE x TEXTURE_SIZE RGBA
 	for (int i = 0; i < N_TEXTURES; i++) {
 		if (data.empty()) continue;
 
@@ -124,7 +314,7 @@ void TextureManager::loadTexturesArray(std::vector<std::pair<TextureType, std::s
 				if (a == 0) { r = g = b = 0; }
 				out[4*pix+0]=r; out[4*pix+1]=g; out[4*pix+2]=b; out[4*pix+3]=a;
 			}
-			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0,0,i, TEXTURE_SIZE, TEXTURE_SIZE, 1, GL_RGBA, GL_UNSIGNED_BYTE, out.data());
+			layers[i].swap(out);
 			continue;
 		}
 
@@ -137,14 +327,42 @@ void TextureManager::loadTexturesArray(std::vector<std::pair<TextureType, std::s
 				unsigned char* p = fallback.data()+4*(y*TEXTURE_SIZE+x);
 				p[0]=a?255:0; p[1]=0; p[2]=a?255:0; p[3]=255;
 			}
-			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0,0,i, TEXTURE_SIZE, TEXTURE_SIZE, 1, GL_RGBA, GL_UNSIGNED_BYTE, fallback.data());
+			layers[i].swap(fallback);
 		} else {
-			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, TEXTURE_SIZE, TEXTURE_SIZE, 1, GL_RGBA, GL_UNSIGNED_BYTE, tex.get());
+			layers[i].assign(tex.get(), tex.get() + TEXTURE_SIZE * TEXTURE_SIZE * 4);
 		}
 	}
+	return layers;
+}
 
-	// Generate mipmaps after all textures are uploaded
-	glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+void TextureManager::uploadTextureArray(const TextureArrayData &array) {
+	glGenTextures(1, &_textureArrayID);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, _textureArrayID);
+
+	// Set texture parameters
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_LOD_BIAS, 0.0f);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, array.levels() - 1);
+
+	// Set Anisotropic Filtering (only if supported)
+	GLfloat maxAniso = 0.0f;
+	glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAniso);
+	if (maxAniso > 1.0f) {
+		glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY_EXT, maxAniso);
+	}
+
+	// Layers past 16 would be unreachable from the 4-bit texture ID
+	static_assert(N_TEXTURES <= 16, "texture IDs are packed on 4 bits");
+	// Every level ready-made: one upload per level, no glGenerateMipmap
+	for (int l = 0; l < array.levels(); ++l) {
+		const int size = TextureArrayData::levelSize(l);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, l, GL_RGBA8, size, size, N_TEXTURES, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, l, 0, 0, 0, size, size, N_TEXTURES, GL_RGBA, GL_UNSIGNED_BYTE, array.level(l));
+	}
 
 	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 }
@@ -0,0 +1,177 @@
+#include "WorldEdit.hpp"
+
+static inline int floor_div(int a, int b) {
+	int q = a / b, r = a % b;
+	return (r && ((r < 0) != (b < 0))) ? (q - 1) : q;
+}
+
+WorldEdit::WorldEdit(ChunkLoader &chunkLoader, ThreadPool &pool)
+: _chunkLoader(chunkLoader), _pool(pool)
+{
+}
+
+WorldEdit::~WorldEdit()
+{
+}
+
+size_t WorldEdit::apply(glm::ivec3 mn, glm::ivec3 mx, const CellOp &op, bool writes, bool byPlayer, bool *complete)
+{
+	if (complete)
+		*complete = true;
+	// Nothing is stored below bedrock
+	mn.y = std::max(mn.y, 0);
+	if (mx.x < mn.x || mx.y < mn.y || mx.z < mn.z)
+		return 0;
+
+	struct Part {
+		Chunk		*chunk;
+		glm::ivec2	cpos;
+		int			subY;
+		glm::ivec3	lmin;
+		glm::ivec3	lmax;
+	};
+	std::vector<Part> parts;
+	// Held until the remesh: the loader thread evicts unpinned cached chunks
+	std::vector<Chunk *> pinned;
+	// Shared by every chunk the edit has to wait for
+	std::shared_ptr<const CellOp> parked;
+
+	for (int cz = floor_div(mn.z, CHUNK_SIZE); cz <= floor_div(mx.z, CHUNK_SIZE); ++cz)
+	for (int cx = floor_div(mn.x, CHUNK_SIZE); cx <= floor_div(mx.x, CHUNK_SIZE); ++cx)
+	{
+		const glm::ivec2 cpos(cx, cz);
+		Chunk *chunk = _chunkLoader.pinChunk(cpos);
+		if (!_chunkLoader.acceptsRegionEdits(chunk, cpos))
+		{
+			if (chunk)
+				chunk->unpin();
+			// Missing, building or coarse (LOD samples only): writes wait as one
+			// box for the chunk to load at full resolution, reads cannot be served
+			if (!writes)
+			{
+				if (complete)
+					*complete = false;
+				continue;
+			}
+			if (!parked)
+				parked = std::make_shared<const CellOp>(op);
+			const glm::ivec3 base(cx * CHUNK_SIZE, 0, cz * CHUNK_SIZE);
+			_chunkLoader.queueRegion(cpos, glm::max(mn, base),
+				glm::min(mx, base + glm::ivec3(CHUNK_SIZE - 1, mx.y, CHUNK_SIZE - 1)), parked, byPlayer);
+			continue;
+		}
+		pinned.push_back(chunk);
+		for (int sy = floor_div(mn.y, CHUNK_SIZE); sy <= floor_div(mx.y, CHUNK_SIZE); ++sy)
+		{
+			const glm::ivec3 base(cx * CHUNK_SIZE, sy * CHUNK_SIZE, cz * CHUNK_SIZE);
+			parts.push_back({chunk, cpos, sy, glm::max(mn - base, glm::ivec3(0)), glm::min(mx - base, glm::ivec3(CHUNK_SIZE - 1))});
+		}
+	}
+
+	// A read that cannot see the whole box is not worth running
+	if (complete && !*complete)
+	{
+		for (Chunk *chunk : pinned)
+			chunk->unpin();
+		return 0;
+	}
+
+	std::vector<std::future<size_t>> jobs;
+	jobs.reserve(parts.size());
+	for (const Part &part : parts)
+	{
+		jobs.emplace_back(_pool.enqueue([this, &op, part, writes]() -> size_t {
+			return _chunkLoader.editSubChunkRegion(part.chunk, part.subY, part.lmin, part.lmax, op, writes);
+		}));
+	}
+
+	// Single remesh wave: touched subchunks plus the ones across touched borders
+	RemeshSet remesh;
+	size_t changed = 0;
+	for (size_t i = 0; i < jobs.size(); ++i)
+	{
+		const size_t n = jobs[i].get();
+		if (n == 0)
+			continue;
+		changed += n;
+		const Part &part = parts[i];
+		ChunkLoader::addRegionRemesh(remesh, part.cpos, part.subY, part.lmin, part.lmax);
+		if (byPlayer)
+			_chunkLoader.markChunkModified(part.chunk);
+	}
+	_chunkLoader.remeshSubChunks(remesh, &_pool);
+	for (Chunk *chunk : pinned)
+		chunk->unpin();
+	return changed;
+}
+
+size_t WorldEdit::fillBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockType value, bool byPlayer)
+{
+	return apply(glm::min(a, b), glm::max(a, b), [value](const glm::ivec3 &, char, char &out) {
+		out = value;
+		return true;
+	}, true, byPlayer);
+}
+
+size_t WorldEdit::fillEllipsoid(const glm::vec3 &center, const glm::vec3 &radii, BlockType value, bool byPlayer)
+{
+	const glm::vec3 r = glm::max(glm::abs(radii), glm::vec3(0.5f));
+	const glm::ivec3 mn(glm::floor(center - r));
+	const glm::ivec3 mx(glm::floor(center + r));
+	const glm::vec3 inv = 1.0f / r;
+	return apply(mn, mx, [center, inv, value](const glm::ivec3 &w, char, char &out) {
+		// Test voxel centers
+		const glm::vec3 d = (glm::vec3(w) + 0.5f - center) * inv;
+		if (glm::dot(d, d) > 1.0f)
+			return false;
+		out = value;
+		return true;
+	}, true, byPlayer);
+}
+
+size_t WorldEdit::replaceInBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockType from, BlockType to, bool byPlayer)
+{
+	return apply(glm::min(a, b), glm::max(a, b), [from, to](const glm::ivec3 &, char current, char &out) {
+		if (current != from)
+			return false;
+		out = to;
+		return true;
+	}, true, byPlayer);
+}
+
+bool WorldEdit::copyBox(const glm::ivec3 &a, const glm::ivec3 &b, BlockRegion &out)
+{
+	const glm::ivec3 mn = glm::min(a, b);
+	const glm::ivec3 mx = glm::max(a, b);
+	out.size = mx - mn + 1;
+	out.blocks.assign((size_t)out.size.x * (size_t)out.size.y * (size_t)out.size.z, AIR);
+	// Each part owns distinct cells of the buffer, no locking needed
+	BlockRegion *region = &out;
+	bool complete = true;
+	apply(mn, mx, [region, mn](const glm::ivec3 &w, char current, char &) {
+		region->blocks[region->index(w - mn)] = current;
+		return false;
+	}, false, false, &complete);
+	// Part of the box is not loaded at full resolution: no partial copies
+	if (!complete)
+	{
+		out.size = glm::ivec3(0);
+		out.blocks.clear();
+	}
+	return complete;
+}
+
+size_t WorldEdit::paste(const BlockRegion &region, const glm::ivec3 &origin, bool skipAir, bool byPlayer)
+{
+	if (region.blocks.empty())
+		return 0;
+	// The op may be parked for chunks that are not loaded: it owns its copy
+	std::shared_ptr<const BlockRegion> src = std::make_shared<const BlockRegion>(region);
+	return apply(origin, origin + region.size - 1, [src, origin, skipAir](const glm::ivec3 &w, char, char &out) {
+		const BlockType b = src->blocks[src->index(w - origin)];
+		if (skipAir && b == AIR)
+			return false;
+		out = b;
+		return true;
+	}, true, byPlayer);
+}
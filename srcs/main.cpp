@@ -1,5 +1,6 @@
 #include "ft_vox.hpp"
 #include "StoneEngine.hpp"
+#include "NoiseBackend.hpp"
 #include <cstdlib>
 
 bool isWSL() {
@@ -13,6 +14,8 @@ int main(int argc, char **argv)
 	{
 		seed = atoi(argv[1]);
 	}
+	// Terrain noise backend: FT_VOX_NOISE=perlin|opensimplex2|value
+	NoiseBackend::selectFromEnvironment();
 	// Under sanitizers, Mesa's driver threads can trigger benign data race
 	// reports. Disabling Mesa's multi-threaded GL dispatch reduces noise.
 	// This environment hint is harmless if unsupported.
@@ -0,0 +1,157 @@
+#include "ft_vox.hpp"
+#include "ChunkLoader.hpp"
+#include "RegionFile.hpp"
+#include "NoiseBackend.hpp"
+#include <cstdlib>
+
+// ft_vox_pregen: generate an N x N chunk area headless and write it to
+// REGION_DIR for the game to read instead of regenerating.
+//
+// Chunks spill trees into their neighbors and test them for room, so the
+// result depends on generation order. To keep it independent of thread
+// timing, chunks are generated in waves (ChunkLoader::generateChunks).
+// A chunk is written only once its whole 1-ring exists, then dropped when
+// no later region needs it.
+
+static inline int floor_div(int a, int b) {
+	int q = a / b, r = a % b;
+	return (r && ((r < 0) != (b < 0))) ? (q - 1) : q;
+}
+
+static void usage(const char *name)
+{
+	std::cerr << "Usage: " << name << " <seed> <N> [centerChunkX centerChunkZ]" << std::endl
+		<< "  Pregenerates N x N chunks around the center into " << REGION_DIR << "/" << std::endl
+		<< "  FT_VOX_NOISE selects the noise backend, as for ft_vox." << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 3 && argc != 5)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+	const int seed = atoi(argv[1]);
+	const int size = atoi(argv[2]);
+	const ivec2 center = argc == 5 ? ivec2(atoi(argv[3]), atoi(argv[4])) : ivec2(0);
+	if (size <= 0)
+	{
+		usage(argv[0]);
+		return 1;
+	}
+	NoiseBackend::selectFromEnvironment();
+
+	const ivec2 areaMin = center - size / 2;
+	const ivec2 areaMax = areaMin + size - 1;
+	auto inArea = [&](const ivec2 &c) {
+		return c.x >= areaMin.x && c.y >= areaMin.y && c.x <= areaMax.x && c.y <= areaMax.y;
+	};
+
+	// Everything ChunkLoader needs to run without a window or GL context
+	const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+	ThreadPool					pool(threads);
+	Camera						camera;
+	Chrono						chrono;
+	std::atomic_bool			running(true);
+	std::mutex					drawDataMutex;
+	std::queue<DisplayData *>	solidQueue;
+	std::queue<DisplayData *>	transparentQueue;
+	MemoryGovernor				memGov;
+	ChunkLoader loader(seed, camera, pool, chrono, &running, drawDataMutex, solidQueue, transparentQueue, memGov);
+	RegionStore store(REGION_DIR, static_cast<uint64_t>(seed));
+
+	const ivec2 regionMin = RegionStore::regionOf(areaMin);
+	const ivec2 regionMax = RegionStore::regionOf(areaMax);
+	auto regionOrder = [&](const ivec2 &r) {
+		return (r.y - regionMin.y) * (regionMax.x - regionMin.x + 1) + (r.x - regionMin.x);
+	};
+
+	std::cout << "Pregenerating " << size << "x" << size << " chunks from (" << areaMin.x << ", " << areaMin.y
+		<< ") to (" << areaMax.x << ", " << areaMax.y << "), seed " << seed << ", noise "
+		<< NoiseBackend::name(NoiseBackend::selected()) << ", " << threads << " threads" << std::endl;
+
+	typedef std::chrono::steady_clock clock;
+	const auto start = clock::now();
+	std::unordered_set<ivec2, ivec2_hash> generated;
+	size_t written = 0;
+	size_t generatedCount = 0;
+	uint64_t worldDigest = 0xcbf29ce484222325ULL;
+
+	for (int rz = regionMin.y; rz <= regionMax.y; ++rz)
+	for (int rx = regionMin.x; rx <= regionMax.x; ++rx)
+	{
+		const ivec2 region(rx, rz);
+		const auto regionStart = clock::now();
+		const ivec2 lo = glm::max(region * REGION_SIZE, areaMin);
+		const ivec2 hi = glm::min(region * REGION_SIZE + REGION_SIZE - 1, areaMax);
+
+		// This region's chunks and their ring
+		std::vector<ivec2> missing;
+		for (int z = lo.y - 1; z <= hi.y + 1; ++z)
+			for (int x = lo.x - 1; x <= hi.x + 1; ++x)
+				if (!generated.count(ivec2(x, z)))
+					missing.push_back(ivec2(x, z));
+		loader.generateChunks(missing, threads);
+		generated.insert(missing.begin(), missing.end());
+		generatedCount += missing.size();
+
+		// Keep what the slots of other regions already hold
+		std::vector<StoredChunk> chunks;
+		chunks.reserve(REGION_SIZE * REGION_SIZE);
+		for (int z = region.y * REGION_SIZE; z < (region.y + 1) * REGION_SIZE; ++z)
+			for (int x = region.x * REGION_SIZE; x < (region.x + 1) * REGION_SIZE; ++x)
+			{
+				const ivec2 pos(x, z);
+				StoredChunk chunk;
+				bool ok = false;
+				if (inArea(pos))
+				{
+					Chunk *c = loader.getChunk(pos);
+					ok = c && c->exportBlocks(chunk);
+				}
+				else
+					ok = store.load(pos, chunk);
+				if (ok)
+					chunks.push_back(std::move(chunk));
+			}
+		const uint64_t digest = store.write(region, chunks);
+		written += (size_t)(hi.x - lo.x + 1) * (size_t)(hi.y - lo.y + 1);
+		for (int i = 0; i < 8; ++i)
+		{
+			const uint8_t byte = (uint8_t)(digest >> (8 * i));
+			worldDigest = (worldDigest ^ byte) * 0x100000001b3ULL;
+		}
+
+		// Drop chunks that no remaining region reads
+		const int done = regionOrder(region);
+		for (auto it = generated.begin(); it != generated.end(); )
+		{
+			bool needed = false;
+			for (int dz = -1; dz <= 1 && !needed; ++dz)
+				for (int dx = -1; dx <= 1 && !needed; ++dx)
+				{
+					const ivec2 n = *it + ivec2(dx, dz);
+					needed = inArea(n) && regionOrder(RegionStore::regionOf(n)) > done;
+				}
+			if (!needed && loader.releaseChunk(*it))
+				it = generated.erase(it);
+			else
+				++it;
+		}
+
+		const double seconds = std::chrono::duration<double>(clock::now() - regionStart).count();
+		std::cout << "region " << rx << " " << rz << ": " << chunks.size() << " chunks, "
+			<< std::fixed << std::setprecision(2) << seconds << " s, digest "
+			<< std::hex << std::setw(16) << std::setfill('0') << digest << std::dec << std::setfill(' ') << std::endl;
+	}
+
+	const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+	std::cout << "Wrote " << written << " chunks (" << generatedCount << " generated with the border ring) in "
+		<< std::fixed << std::setprecision(2) << seconds << " s, "
+		<< (seconds > 0.0 ? written / seconds : 0.0) << " chunks/s" << std::endl
+		<< "world digest " << std::hex << std::setw(16) << std::setfill('0') << worldDigest << std::dec << std::endl;
+	running = false;
+	pool.joinThreads();
+	return 0;
+}
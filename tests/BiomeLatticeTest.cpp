@@ -0,0 +1,109 @@
+#include "test.hpp"
+#include "NoiseGenerator.hpp"
+
+#include <chrono>
+
+// PerlinMap biomes come from the climate lattice (BIOME_LATTICE): a column
+// whose lattice cell has the same biome at all four corners, each at least
+// BIOME_LATTICE_MARGIN away from a threshold, skips the exact climate noise.
+// The maps must match exact getBiome over a fixed area.
+
+namespace
+{
+	const size_t kSeed = 42;
+
+	// Mismatching columns of one map against getBiome(pos, getHeight(pos))
+	size_t countMismatches(NoiseGenerator &noise, PerlinMap *map, int resolution)
+	{
+		size_t mismatches = 0;
+		for (int z = 0; z < map->size; z += resolution)
+		for (int x = 0; x < map->size; x += resolution)
+		{
+			const ivec2 world = map->position * map->size + ivec2(x, z);
+			const Biome exact = noise.getBiome(world, noise.getHeight(world));
+			if ((uint8_t)exact != map->biomeMap[z * map->size + x])
+				++mismatches;
+		}
+		return mismatches;
+	}
+}
+
+TEST(biomeLatticeMatchesExact)
+{
+	NoiseGenerator noise(kSeed);
+	size_t columns = 0, mismatches = 0;
+	for (int cz = -8; cz < 8; ++cz)
+	for (int cx = -8; cx < 8; ++cx)
+	{
+		ivec2 pos(cx * 7, cz * 7);
+		PerlinMap *map = noise.getPerlinMap(pos, 1);
+		mismatches += countMismatches(noise, map, 1);
+		columns += (size_t)map->size * (size_t)map->size;
+		noise.removePerlinMap(pos.x, pos.y);
+	}
+	CHECK(columns > 0);
+	CHECK(mismatches == 0);
+}
+
+// Refining a coarse map goes through updatePerlinMapResolution
+TEST(biomeLatticeRefinedMatchesExact)
+{
+	NoiseGenerator noise(kSeed);
+	size_t columns = 0, mismatches = 0;
+	for (int i = 0; i < 16; ++i)
+	{
+		ivec2 pos(i * 5 - 40, 13 - i * 3);
+		noise.getPerlinMap(pos, 4);
+		PerlinMap *map = noise.getPerlinMap(pos, 1);
+		CHECK(map->resolution == 1);
+		mismatches += countMismatches(noise, map, 1);
+		columns += (size_t)map->size * (size_t)map->size;
+		noise.removePerlinMap(pos.x, pos.y);
+	}
+	CHECK(mismatches == 0);
+}
+
+// Maps too coarse for the lattice classify every column exactly
+TEST(biomeCoarseMapIsExact)
+{
+	NoiseGenerator noise(kSeed);
+	for (int i = 0; i < 8; ++i)
+	{
+		ivec2 pos(i * 11 - 30, i * 9 - 20);
+		PerlinMap *map = noise.getPerlinMap(pos, BIOME_LATTICE);
+		CHECK(countMismatches(noise, map, BIOME_LATTICE) == 0);
+		noise.removePerlinMap(pos.x, pos.y);
+	}
+}
+
+// addPerlinMap throughput against exact getBiome on the same columns (heights
+// excluded); prints columns/s, no timing threshold
+TEST(biomeLatticeThroughput)
+{
+	typedef std::chrono::steady_clock Clock;
+	NoiseGenerator noise(kSeed);
+	const int maps = 64;
+	double mapSeconds = 0.0, exactSeconds = 0.0;
+	size_t columns = 0, checksum = 0;
+	for (int i = 0; i < maps; ++i)
+	{
+		ivec2 pos(i % 8 * 3 - 12, i / 8 * 3 - 12);
+		Clock::time_point start = Clock::now();
+		PerlinMap *map = noise.addPerlinMap(pos, CHUNK_SIZE, 1);
+		mapSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+		start = Clock::now();
+		for (int z = 0; z < map->size; ++z)
+		for (int x = 0; x < map->size; ++x)
+		{
+			const ivec2 world = map->position * map->size + ivec2(x, z);
+			checksum += (size_t)noise.getBiome(world, map->heightMap[z * map->size + x]);
+		}
+		exactSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+		columns += (size_t)map->size * (size_t)map->size;
+		noise.removePerlinMap(pos.x, pos.y);
+	}
+	CHECK(columns > 0 && mapSeconds > 0.0 && exactSeconds > 0.0);
+	std::cout << "    addPerlinMap " << (size_t)(columns / mapSeconds) << " columns/s, exact biomes "
+		<< (size_t)(columns / exactSeconds) << " columns/s (checksum " << checksum << ")" << std::endl;
+}
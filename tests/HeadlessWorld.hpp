@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ChunkLoader.hpp"
+
+#include <filesystem>
+#include <unistd.h>
+
+// Everything ChunkLoader needs to run without a window or GL context
+struct HeadlessWorld {
+	ThreadPool					pool;
+	Camera						camera;
+	Chrono						chrono;
+	std::atomic_bool			running;
+	std::mutex					drawDataMutex;
+	std::queue<DisplayData *>	solidQueue;
+	std::queue<DisplayData *>	transparentQueue;
+	MemoryGovernor				memGov;
+	ChunkLoader					loader;
+
+	explicit HeadlessWorld(int seed)
+	: pool(4), running(true),
+	  loader(seed, camera, pool, chrono, &running, drawDataMutex, solidQueue, transparentQueue, memGov)
+	{}
+	~HeadlessWorld() {
+		running = false;
+		pool.joinThreads();
+	}
+};
+
+// Runs the test in a fresh directory: ChunkLoader reads REGION_DIR from
+// the working directory
+struct ScratchDir {
+	std::filesystem::path	previous;
+	std::filesystem::path	path;
+
+	ScratchDir() : previous(std::filesystem::current_path()) {
+		char name[] = "/tmp/ft_voxTest.XXXXXX";
+		if (mkdtemp(name))
+			path = name;
+		if (!path.empty())
+			std::filesystem::current_path(path);
+	}
+	~ScratchDir() {
+		std::filesystem::current_path(previous);
+		if (!path.empty())
+			std::filesystem::remove_all(path);
+	}
+};
@@ -0,0 +1,57 @@
+#include "test.hpp"
+#include "HeadlessWorld.hpp"
+
+// MEM_MESHES must come back to where it was once display data goes through
+// the renderer's life cycle: staged by the loader (charged), uploaded (the
+// renderer drops the vertex, indirect and meta streams) and replaced by the
+// next build (released).
+
+namespace
+{
+	// What ChunkRenderer does with one staged copy: upload, then replace
+	void uploadAndReplace(MemoryGovernor &memGov, DisplayData *data)
+	{
+		memGov.trimDisplayData(data);
+		CHECK(data->vertexData.capacity() == 0 && data->indirectBufferData.capacity() == 0);
+		CHECK(data->memCharged == MemoryGovernor::bytesOf(data));
+		memGov.releaseDisplayData(data);
+	}
+}
+
+TEST(displayDataChargeIsSymmetric)
+{
+	ScratchDir scratch;
+	HeadlessWorld world(42);
+	// Meshes the spawn ring and stages one display build
+	world.loader.initSpawn();
+	CHECK(!world.solidQueue.empty() && !world.transparentQueue.empty());
+
+	std::vector<DisplayData *> staged;
+	size_t charged = 0;
+	for (std::queue<DisplayData *> *queue : {&world.solidQueue, &world.transparentQueue})
+		while (!queue->empty()) {
+			staged.push_back(queue->front());
+			charged += staged.back()->memCharged;
+			queue->pop();
+		}
+	CHECK(charged > 0);
+	const size_t baseline = world.memGov.usage(MEM_MESHES) - charged;
+
+	// A few display rebuilds: each stages a copy the size of the first ones
+	for (int round = 0; round < 3; ++round) {
+		std::vector<DisplayData *> copies;
+		for (const DisplayData *data : staged) {
+			copies.push_back(new DisplayData(*data));
+			copies.back()->memCharged = 0;
+			world.memGov.chargeDisplayData(copies.back());
+		}
+		for (DisplayData *copy : copies)
+			uploadAndReplace(world.memGov, copy);
+		CHECK(world.memGov.usage(MEM_MESHES) == baseline + charged);
+	}
+
+	for (DisplayData *data : staged)
+		uploadAndReplace(world.memGov, data);
+	CHECK(world.memGov.usage(MEM_MESHES) == baseline);
+	CHECK(world.memGov.underflows(MEM_MESHES) == 0);
+}
@@ -0,0 +1,123 @@
+#include "test.hpp"
+#include "NoiseBackend.hpp"
+#include <utility>
+
+// Golden outputs: every backend sampled at seed 1337 over a fixed grid.
+// A change here changes the generated worlds; update the tables only on
+// purpose (values printed with %.17g from the double path).
+
+namespace
+{
+	const uint32_t kSeed = 1337u;
+
+	// Fixed shuffle (LCG Fisher-Yates): std::shuffle is not portable across
+	// standard libraries, the golden values must not depend on it
+	std::vector<int> testPermutation(uint32_t seed)
+	{
+		std::vector<int> p(256);
+		for (int i = 0; i < 256; ++i)
+			p[i] = i;
+		uint32_t s = seed;
+		for (int i = 255; i > 0; --i)
+		{
+			s = s * 1664525u + 1013904223u;
+			std::swap(p[i], p[s % (uint32_t)(i + 1)]);
+		}
+		p.insert(p.end(), p.begin(), p.begin() + 256);
+		return p;
+	}
+
+	// 2D: x fastest over 4 columns, 4 rows. 3D: x fastest, then y (2), then z (2)
+	double gridX(int i) { return -3.7 + i * 1.93; }
+	double gridY(int j) { return 0.41 + j * 2.71; }
+	double gridZ(int k) { return 5.3 + k * 1.17; }
+
+	void checkBackend(NoiseBackendType type, const double (&golden2D)[16], const double (&golden3D)[16])
+	{
+		std::unique_ptr<NoiseBackend> backend = NoiseBackend::create(type, kSeed, testPermutation(kSeed));
+		CHECK(backend != nullptr);
+		if (!backend)
+			return;
+		for (int j = 0; j < 4; ++j)
+		for (int i = 0; i < 4; ++i)
+		{
+			const double x = gridX(i), y = gridY(j);
+			CHECK_NEAR(backend->noise(x, y), golden2D[j * 4 + i], 1e-12);
+			// Float path: same lattice, single precision arithmetic
+			CHECK_NEAR(backend->noise((float)x, (float)y), golden2D[j * 4 + i], 1e-4);
+		}
+		for (int k = 0; k < 2; ++k)
+		for (int j = 0; j < 2; ++j)
+		for (int i = 0; i < 4; ++i)
+		{
+			const double x = gridX(i), y = gridY(j), z = gridZ(k);
+			const double expected = golden3D[(k * 2 + j) * 4 + i];
+			CHECK_NEAR(backend->noise(x, y, z), expected, 1e-12);
+			CHECK_NEAR(backend->noise((float)x, (float)y, (float)z), expected, 1e-4);
+		}
+	}
+
+	const double kPerlin2D[16] = {
+		0.52646536077657291, 0.1235081931687787, -0.49530865328263801, 0.039833084142551045,
+		-0.22530250629464083, -0.27732670759200012, -0.029272751990070074, -0.22441684122196631,
+		0.25710956186796946, 0.13775442863393939, -0.23878937196753292, 0.10855322169660686,
+		0.57068053096581206, -0.18112495859999922, -0.63834049379778834, -0.12788463240483788
+	};
+	const double kPerlin3D[16] = {
+		-0.069006828347675839, 0.034152272278434162, 0.38199628345636405, 0.35558823971884146,
+		0.38547798354175578, -0.23935631231904803, 0.24691778014299068, 0.085819472416952411,
+		0.19419793510947583, 0.18632226205086461, -0.093780271521565539, 0.70165338224636375,
+		-0.25235295223464599, 0.42585582904967562, 0.072168471531308911, 0.34454511549546174
+	};
+
+	const double kOpenSimplex22D[16] = {
+		0.11789123458995839, -0.66335759941418238, -0.61367867219876382, 0.4204818412588841,
+		0.35021757104426032, -0.32146467587676736, -0.86661109274656578, -0.060319015681648547,
+		0.44081288057960838, 0.23148647411848972, -0.75460756368527038, 0.12735751800712539,
+		-0.59804202024173625, -0.40423688457509949, 0.55835986592730957, -0.58985536454117238
+	};
+	const double kOpenSimplex23D[16] = {
+		-0.014172789389553063, 0.32940281272352001, 0.29545206525429912, -0.22792959049068623,
+		0.35919600357649684, 0.12164593232713815, 0.64623800320000024, 0.44766258223749983,
+		0.86055060106336057, -0.12585886948709624, 0.70237742249697455, 0.54894343023266545,
+		-0.4147789504304733, -0.36907890177757979, -0.24931794649092062, 0.22635049416659597
+	};
+
+	const double kValue2D[16] = {
+		0.16236267408272625, 0.31843150751079252, -0.029951829607631722, 0.20751323915265613,
+		0.65751674299958274, 0.099562858938463089, -0.53515524805983905, 0.040213601952627707,
+		-0.78346037239651078, -0.66545655518515434, -0.53577160288589409, 0.59249925777907531,
+		0.041464582568563668, 0.099056853552490887, 0.3726260461111307, -0.16941523205074496
+	};
+	const double kValue3D[16] = {
+		0.031064008570952852, -0.1108905304012482, 0.47437502255739106, -0.61762809153297038,
+		-0.46006699868609147, 0.61377636031001082, 0.34548613439620091, 0.75054654753698247,
+		-0.018220114393644071, 0.34328288155163122, -0.061952275501807402, -0.21080407195272197,
+		-0.242274479444539, 0.55349970856342323, -0.58561215915432674, 0.52013258418471864
+	};
+}
+
+TEST(noiseBackendPerlinGolden)
+{
+	checkBackend(NOISE_PERLIN, kPerlin2D, kPerlin3D);
+}
+
+TEST(noiseBackendOpenSimplex2Golden)
+{
+	checkBackend(NOISE_OPENSIMPLEX2, kOpenSimplex22D, kOpenSimplex23D);
+}
+
+TEST(noiseBackendValueGolden)
+{
+	checkBackend(NOISE_VALUE, kValue2D, kValue3D);
+}
+
+TEST(noiseBackendParse)
+{
+	NoiseBackendType type = NOISE_PERLIN;
+	CHECK(NoiseBackend::parse("opensimplex2", type) && type == NOISE_OPENSIMPLEX2);
+	CHECK(NoiseBackend::parse("simplex", type) && type == NOISE_OPENSIMPLEX2);
+	CHECK(NoiseBackend::parse("value", type) && type == NOISE_VALUE);
+	CHECK(NoiseBackend::parse("perlin", type) && type == NOISE_PERLIN);
+	CHECK(!NoiseBackend::parse("worley", type));
+}
@@ -0,0 +1,53 @@
+#include "test.hpp"
+#include "HeadlessWorld.hpp"
+
+#include <algorithm>
+
+// Skylight crosses chunk borders: a chunk roofed over entirely is lit only
+// through the open chunk next to it, once that one has its light.
+
+TEST(skyLightCrossesChunkBorders)
+{
+	HeadlessWorld world(42);
+	Chunk *roofed = world.loader.generateChunk(ivec2(0, 0));
+	Chunk *open = world.loader.generateChunk(ivec2(1, 0));
+	CHECK(roofed != nullptr && open != nullptr);
+	if (!roofed || !open)
+		return;
+	roofed->linkNeighbors();
+	CHECK(roofed->getEastChunk() == open && open->getWestChunk() == roofed);
+
+	std::vector<int> indices;
+	roofed->getSubIndices(indices);
+	CHECK(!indices.empty());
+	if (indices.empty())
+		return;
+	const int top = *std::max_element(indices.begin(), indices.end());
+	SubChunk *sub = roofed->getSubChunk(top);
+	const int roofY = CHUNK_SIZE - 2;
+	for (int z = 0; z < CHUNK_SIZE; ++z)
+		for (int x = 0; x < CHUNK_SIZE; ++x)
+			sub->setBlockLocal(x, roofY, z, COBBLE);
+
+	// An air cell under the roof on the east border, with air west of it
+	int z = 0;
+	while (z < CHUNK_SIZE && (sub->getBlock({CHUNK_SIZE - 1, roofY - 1, z}) != AIR
+		|| sub->getBlock({CHUNK_SIZE - 2, roofY - 1, z}) != AIR))
+		++z;
+	CHECK(z < CHUNK_SIZE);
+	if (z == CHUNK_SIZE)
+		return;
+	const int y = top * CHUNK_SIZE + roofY - 1;
+
+	// The open chunk has no light yet: nothing comes in
+	roofed->sendFacesToDisplay();
+	CHECK(roofed->getSkyLight(CHUNK_SIZE - 1, y, z) == 0);
+
+	// Its first light changes the border, the roofed chunk refills from it
+	open->sendFacesToDisplay();
+	roofed->sendFacesToDisplay();
+	CHECK(roofed->getSkyLight(CHUNK_SIZE - 1, y, z) == SKYLIGHT_MAX - 1);
+	CHECK(roofed->getSkyLight(CHUNK_SIZE - 2, y, z) == SKYLIGHT_MAX - 2);
+	// Far from the opening it stays dark
+	CHECK(roofed->getSkyLight(0, y, z) == 0);
+}
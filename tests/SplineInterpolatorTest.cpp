@@ -0,0 +1,71 @@
+#include "test.hpp"
+#include "NoiseGenerator.hpp"
+
+// The terrain curves are baked into a lookup table read back linearly
+// (SplineInterpolator::interpolate): bound its error against the exact cubic
+// and check the batch lookup used by the map fill matches the scalar one.
+
+namespace
+{
+	// Max |interpolate - evaluate| over each curve, in blocks of height:
+	// well under the one block the heights are truncated to
+	const double kMaxSplineError = 0.05;
+	const int kSamples = 100000;
+
+	void checkCurve(const std::vector<Point> &points)
+	{
+		const SplineInterpolator curve(points);
+		const double mn = points.front().x, mx = points.back().x;
+		std::vector<double> xs(kSamples + 1), batch(kSamples + 1);
+		double maxError = 0.0;
+		for (int i = 0; i <= kSamples; ++i)
+		{
+			xs[i] = mn + (mx - mn) * i / kSamples;
+			maxError = std::max(maxError, std::fabs(curve.interpolate(xs[i]) - curve.evaluate(xs[i])));
+		}
+		CHECK_NEAR(maxError, 0.0, kMaxSplineError);
+
+		curve.interpolate(xs.data(), batch.data(), xs.size());
+		bool same = true;
+		for (size_t i = 0; i < xs.size(); ++i)
+			same = same && batch[i] == curve.interpolate(xs[i]);
+		CHECK(same);
+
+		// Out of range gives 0 on both paths
+		const double outside[2] = {mn - 0.5, mx + 0.5};
+		double outsideBatch[2] = {1.0, 1.0};
+		curve.interpolate(outside, outsideBatch, 2);
+		CHECK(outsideBatch[0] == 0.0 && outsideBatch[1] == 0.0);
+		CHECK(curve.interpolate(outside[0]) == 0.0 && curve.interpolate(outside[1]) == 0.0);
+	}
+}
+
+TEST(splineContinentalError)
+{
+	checkCurve(SplineData::continentalPoints);
+}
+
+TEST(splineErosionError)
+{
+	checkCurve(SplineData::erosionPoints);
+}
+
+TEST(splinePeaksValleysError)
+{
+	checkCurve(SplineData::peaksPoints);
+}
+
+// The map fill goes through getHeights: it must give the scalar heights
+TEST(splineBatchHeights)
+{
+	NoiseGenerator noise(42);
+	std::vector<ivec2> columns;
+	for (int z = 0; z < 64; ++z)
+		columns.push_back(ivec2(-1000 + 37 * z, 5000 - 53 * z));
+	std::vector<double> heights(columns.size());
+	noise.getHeights(columns.data(), heights.data(), columns.size());
+	bool same = true;
+	for (size_t i = 0; i < columns.size(); ++i)
+		same = same && heights[i] == noise.getHeight(columns[i]);
+	CHECK(same);
+}
@@ -0,0 +1,81 @@
+#include "test.hpp"
+#include "HeadlessWorld.hpp"
+#include "RegionFile.hpp"
+
+// Cold tier (SubChunk::freezeBlocks): reads must see the same voxels as
+// before freezing without inflating the array; writes inflate it.
+
+namespace
+{
+	std::vector<uint8_t> snapshot(SubChunk *sub)
+	{
+		std::vector<uint8_t> out;
+		sub->withBlocks([&](const uint8_t *blocks, int chunkSize, int, int) {
+			if (blocks)
+				out.assign(blocks, blocks + (size_t)chunkSize * chunkSize * chunkSize);
+		});
+		return out;
+	}
+}
+
+TEST(regionDecodeAt)
+{
+	std::vector<uint8_t> data(5000);
+	for (size_t i = 0; i < data.size(); ++i)
+		data[i] = (uint8_t)((i / 37) % 5);
+	std::vector<uint8_t> packed;
+	RegionStore::encode(data.data(), data.size(), packed);
+
+	bool same = true;
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		uint8_t value = 0xff;
+		same = same && RegionStore::decodeAt(packed.data(), packed.size(), i, value) && value == data[i];
+	}
+	CHECK(same);
+	uint8_t value = 0;
+	CHECK(!RegionStore::decodeAt(packed.data(), packed.size(), data.size(), value));
+	// Truncated: the value byte of the last run is missing
+	CHECK(!RegionStore::decodeAt(packed.data(), packed.size() - 1, data.size() - 1, value));
+}
+
+TEST(subChunkFrozenReads)
+{
+	HeadlessWorld world(42);
+	Chunk *chunk = world.loader.generateChunk(ivec2(3, -2));
+	CHECK(chunk != nullptr);
+	if (!chunk)
+		return;
+
+	std::vector<int> indices;
+	chunk->getSubIndices(indices);
+	int frozen = 0;
+	for (int idx : indices)
+	{
+		SubChunk *sub = chunk->getSubChunk(idx);
+		const std::vector<uint8_t> before = snapshot(sub);
+		if (before.empty() || sub->freezeBlocks() == 0)
+			continue;
+		++frozen;
+		CHECK(sub->isFrozen());
+
+		// Bulk read: scratch copy, still frozen
+		CHECK(snapshot(sub) == before);
+		CHECK(sub->isFrozen());
+
+		// Cell reads: straight from the packed runs
+		bool same = true;
+		for (int y = 0; y < CHUNK_SIZE; ++y)
+		for (int z = 0; z < CHUNK_SIZE; ++z)
+		for (int x = 0; x < CHUNK_SIZE; ++x)
+			same = same && (uint8_t)sub->getBlock({x, y, z}) == before[x + z * CHUNK_SIZE + y * CHUNK_SIZE * CHUNK_SIZE];
+		CHECK(same);
+		CHECK(sub->isFrozen());
+
+		// A write inflates
+		sub->setBlockLocal(1, 2, 3, COBBLE);
+		CHECK(!sub->isFrozen());
+		CHECK(sub->getBlock({1, 2, 3}) == COBBLE);
+	}
+	CHECK(frozen > 0);
+}
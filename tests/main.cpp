@@ -0,0 +1,44 @@
+#include "test.hpp"
+#include <cstring>
+
+static int g_failures = 0;
+
+std::vector<TestCase> &testRegistry()
+{
+	static std::vector<TestCase> tests;
+	return tests;
+}
+
+bool registerTest(const char *name, void (*fn)())
+{
+	testRegistry().push_back({name, fn});
+	return true;
+}
+
+void reportFailure(const char *file, int line, const char *what)
+{
+	std::cerr << "    " << file << ":" << line << ": CHECK failed: " << what << std::endl;
+	++g_failures;
+}
+
+// ./ft_voxTest [name filter]
+int main(int argc, char **argv)
+{
+	int run = 0;
+	int failedTests = 0;
+	for (const TestCase &test : testRegistry())
+	{
+		if (argc > 1 && !std::strstr(test.name, argv[1]))
+			continue;
+		const int before = g_failures;
+		std::cout << "[ RUN  ] " << test.name << std::endl;
+		test.fn();
+		const bool ok = g_failures == before;
+		std::cout << (ok ? "[  OK  ] " : "[ FAIL ] ") << test.name << std::endl;
+		++run;
+		if (!ok)
+			++failedTests;
+	}
+	std::cout << run - failedTests << "/" << run << " tests passed" << std::endl;
+	return failedTests ? 1 : 0;
+}
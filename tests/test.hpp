@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Minimal test harness for `make test`: TEST(name) registers a case,
+// CHECK / CHECK_NEAR record failures and keep going, the runner
+// (tests/main.cpp) returns non-zero if any check failed.
+struct TestCase {
+	const char	*name;
+	void		(*fn)();
+};
+
+std::vector<TestCase>	&testRegistry();
+bool					registerTest(const char *name, void (*fn)());
+void					reportFailure(const char *file, int line, const char *what);
+
+#define TEST(name) \
+	static void name(); \
+	static const bool name##_registered = registerTest(#name, name); \
+	static void name()
+
+#define CHECK(cond) \
+	do { if (!(cond)) reportFailure(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_NEAR(a, b, eps) \
+	do { \
+		const double checkA_ = (double)(a), checkB_ = (double)(b); \
+		if (!(std::fabs(checkA_ - checkB_) <= (double)(eps))) { \
+			std::cerr << "    " << checkA_ << " vs " << checkB_ << std::endl; \
+			reportFailure(__FILE__, __LINE__, #a " ~= " #b); \
+		} \
+	} while (0)